@@ -452,15 +452,7 @@ def _build_kvm(options, system, cpus):
     # has to be done after creating caches and other child objects
     # since these mustn't inherit the CPU event queue.
     if len(cpus) > 1:
-        device_eq = 0
-        first_cpu_eq = 1
-        for idx, cpu in enumerate(cpus):
-            # Child objects usually inherit the parent's event
-            # queue. Override that and use the same event queue for
-            # all devices.
-            for obj in cpu.descendants():
-                obj.eventq_index = device_eq
-            cpu.eventq_index = first_cpu_eq + idx
+        system.kvm_vm.assign_event_queues(cpus)
 
 
 def instantiate(options, checkpoint_dir=None):
@@ -97,6 +97,18 @@ parser.add_argument(
     action="store_true",
     help="Adds a non-coherent, last-level cache",
 )
+parser.add_argument(
+    "--snoop-filter-assoc",
+    type=int,
+    default=0,
+    help="Associativity of the snoop filters, 0 for unbounded filters",
+)
+parser.add_argument(
+    "--snoop-filter-size",
+    type=str,
+    default="8MiB",
+    help="Capacity of the snoop filters",
+)
 parser.add_argument(
     "-t",
     "--testers",
@@ -276,6 +288,18 @@ system.clk_domain = SrcClockDomain(
     clock=args.sys_clock, voltage_domain=system.voltage_domain
 )
 
+
+# Create a crossbar with the requested snoop filter
+def make_xbar():
+    return L2XBar(
+        snoop_filter=SnoopFilter(
+            lookup_latency=0,
+            assoc=args.snoop_filter_assoc,
+            max_capacity=args.snoop_filter_size,
+        )
+    )
+
+
 # For each level, track the next subsys index to use
 next_subsys_index = [0] * (len(cachespec) + 1)
 
@@ -312,7 +336,7 @@ def make_cache_level(ncaches, prototypes, level, next_cache):
     if level != 0:
         # Create a crossbar and add it to the subsystem, note that
         # we do this even with a single element on this level
-        xbar = L2XBar()
+        xbar = make_xbar()
         subsys.xbar = xbar
         if next_cache:
             xbar.mem_side_ports = next_cache.cpu_side
@@ -337,7 +361,7 @@ def make_cache_level(ncaches, prototypes, level, next_cache):
 
         if ntesters > 1:
             # Create a crossbar and add it to the subsystem
-            xbar = L2XBar()
+            xbar = make_xbar()
             subsys.xbar = xbar
             xbar.mem_side_ports = next_cache.cpu_side
             for tester in testers:
@@ -0,0 +1,196 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Estimate the CPI of a workload with SMARTS-style sampled simulation.
+
+The workload runs on an atomic CPU, and every --period instructions a
+switched out O3 CPU takes over to warm up and then measure the CPI of a
+short window. Sampling stops once the CPI is known to within --error
+with the requested --confidence, and the estimate is printed and
+reported in the stats of system.sampler.
+
+With --validate, a copy of the system runs the whole workload on an O3
+CPU alongside the sampled one, and the CPI it measures is compared with
+the estimate.
+
+Example:
+
+    build/X86/gem5.opt configs/example/sampling.py \\
+        tests/test-progs/hello/bin/x86/linux/hello --period 100000 \\
+        --warmup 2000 --measure 1000
+"""
+
+import argparse
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common.Caches import (
+    L1_DCache,
+    L1_ICache,
+)
+
+parser = argparse.ArgumentParser(
+    description=__doc__,
+    formatter_class=argparse.RawDescriptionHelpFormatter,
+)
+parser.add_argument("binary", help="X86 SE mode binary to run")
+parser.add_argument(
+    "--options", default="", help="Arguments passed to the binary"
+)
+parser.add_argument(
+    "--period",
+    type=int,
+    default=10000000,
+    help="Instructions from the start of one sample to the next",
+)
+parser.add_argument(
+    "--warmup",
+    type=int,
+    default=20000,
+    help="Instructions of detailed warmup before every sample",
+)
+parser.add_argument(
+    "--measure", type=int, default=1000, help="Instructions per sample"
+)
+parser.add_argument(
+    "--confidence",
+    type=float,
+    default=0.997,
+    help="Confidence level of the CPI estimate",
+)
+parser.add_argument(
+    "--error",
+    type=float,
+    default=0.03,
+    help="Target error of the CPI estimate, relative to the CPI",
+)
+parser.add_argument(
+    "--max-samples",
+    type=int,
+    default=0,
+    help="Maximum number of samples (0: no limit)",
+)
+parser.add_argument(
+    "--stats-per-sample",
+    action="store_true",
+    help="Dump the stats of every measured window",
+)
+parser.add_argument(
+    "--validate",
+    action="store_true",
+    help="Also run the whole workload on an O3 CPU and compare its CPI "
+    "with the estimate",
+)
+
+args = parser.parse_args()
+
+
+def create_system(cpu_class, mem_mode):
+    system = System()
+    system.clk_domain = SrcClockDomain(
+        clock="2GHz", voltage_domain=VoltageDomain()
+    )
+    system.mem_mode = mem_mode
+    system.mem_ranges = [AddrRange("512MiB")]
+
+    system.membus = SystemXBar()
+    system.system_port = system.membus.cpu_side_ports
+
+    system.mem_ctrl = MemCtrl()
+    system.mem_ctrl.dram = DDR3_1600_8x8(range=system.mem_ranges[0])
+    system.mem_ctrl.port = system.membus.mem_side_ports
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+    process = Process(cmd=[args.binary] + args.options.split())
+
+    system.cpu = cpu_class(cpu_id=0)
+    system.cpu.workload = process
+    system.cpu.addPrivateSplitL1Caches(L1_ICache(), L1_DCache())
+    system.cpu.createInterruptController()
+    system.cpu.connectAllPorts(
+        system.membus.cpu_side_ports,
+        system.membus.cpu_side_ports,
+        system.membus.mem_side_ports,
+    )
+    system.cpu.createThreads()
+
+    return system, process
+
+
+# The workload starts on the atomic CPU, the caches stay attached when
+# the O3 CPU takes over, so they are warmed during fast-forwarding too
+system, process = create_system(X86AtomicSimpleCPU, "atomic")
+
+system.detailed_cpu = X86O3CPU(switched_out=True, cpu_id=0)
+system.detailed_cpu.workload = process
+system.detailed_cpu.clk_domain = system.cpu.clk_domain
+system.detailed_cpu.isa = system.cpu.isa
+system.detailed_cpu.createThreads()
+
+system.sampler = SamplingController(
+    fast_cpus=[system.cpu],
+    detailed_cpus=[system.detailed_cpu],
+    period=args.period,
+    warmup_insts=args.warmup,
+    measure_insts=args.measure,
+    confidence=args.confidence,
+    relative_error=args.error,
+    max_samples=args.max_samples,
+)
+
+if args.validate:
+    # The reference system runs in the same simulation, so the sampled
+    # run only exits because of its workload once both have finished
+    reference, _ = create_system(X86O3CPU, "timing")
+    root = Root(full_system=False, system=system, reference=reference)
+else:
+    root = Root(full_system=False, system=system)
+m5.instantiate()
+
+sampler = system.sampler
+event = sampler.run(system, stats_per_sample=args.stats_per_sample)
+print(
+    f"CPI {sampler.cpi():.4f} +- {sampler.cpiError() * 100:.2f}% "
+    f"from {sampler.numSamples()} samples"
+)
+
+if args.validate:
+    # Sampling is usually done long before the workloads finish
+    while not event or event.getCause() == sampler.exit_cause:
+        event = m5.simulate()
+    cycles = reference.cpu.resolveStat("numCycles").value
+    insts = reference.cpu.resolveStat("commitStats0.numInsts").value
+    cpi = cycles / insts
+    print(
+        f"Full detailed run: CPI {cpi:.4f}, the estimate is off by "
+        f"{(sampler.cpi() - cpi) / cpi * 100:+.2f}%"
+    )
+
+if event:
+    print(f"Exiting @ tick {m5.curTick()} because {event.getCause()}")
@@ -55,8 +55,8 @@ def define_options(parser):
     parser.add_argument(
         "--network",
         default="simple",
-        choices=["simple", "garnet"],
-        help="""'simple'|'garnet' (garnet2.0 will be deprecated.)""",
+        choices=["simple", "garnet", "fast"],
+        help="""'simple'|'garnet'|'fast' (garnet2.0 will be deprecated.)""",
     )
     parser.add_argument(
         "--router-latency",
@@ -144,6 +144,13 @@ def create_network(options, ruby):
         RouterClass = GarnetRouter
         InterfaceClass = GarnetNetworkInterface
 
+    elif options.network == "fast":
+        NetworkClass = FastNetwork
+        IntLinkClass = BasicIntLink
+        ExtLinkClass = BasicExtLink
+        RouterClass = BasicRouter
+        InterfaceClass = None
+
     else:
         NetworkClass = SimpleNetwork
         IntLinkClass = SimpleIntLink
@@ -125,6 +125,15 @@ def define_options(parser):
         help="Recycle latency for ruby controller input buffers",
     )
 
+    parser.add_argument(
+        "--ruby-partitions",
+        type=int,
+        default=1,
+        help="Number of event queues (host threads) to split the routers "
+        "and controllers of the Ruby system across. Partitions exchange "
+        "messages once per quantum, which is set to the link latency.",
+    )
+
     protocol = buildEnv["PROTOCOL"]
     exec(f"from . import {protocol}")
     eval(f"{protocol}.define_options(parser)")
@@ -286,6 +295,11 @@ def create_system(
 
     setup_memory_controllers(system, ruby, dir_cntrls, options)
 
+    if options.ruby_partitions > 1:
+        partition_system(
+            options, system, network, dir_cntrls, cpu_sequencers, cpus
+        )
+
     # Connect the cpu sequencers and the piobus
     if piobus != None:
         for cpu_seq in cpu_sequencers:
@@ -303,6 +317,85 @@ def create_system(
         )
 
 
+def partition_system(
+    options, system, network, dir_cntrls, cpu_sequencers, cpus
+):
+    """Spread the routers of the network across options.ruby_partitions
+    event queues. Every controller (and the objects attached to it) goes
+    to the partition of the router it is connected to. Event queue 0 is
+    left to the rest of the system, so partition p uses event queue
+    p + 1. Messages cross partitions on the links between routers only,
+    whose latency bounds the simulation quantum (see ruby_quantum).
+    """
+    num_partitions = options.ruby_partitions
+    routers = list(network.routers)
+    if num_partitions > len(routers):
+        fatal(
+            f"Can't split {len(routers)} routers into "
+            f"{num_partitions} Ruby partitions"
+        )
+
+    def router_queue(router):
+        return 1 + router.router_id * num_partitions // len(routers)
+
+    for router in routers:
+        router.eventq_index = router_queue(router)
+
+    cntrl_queues = {}
+    for i, ext_link in enumerate(network.ext_links):
+        queue = router_queue(ext_link.int_node)
+        ext_link.eventq_index = queue
+        ext_link.ext_node.eventq_index = queue
+        cntrl_queues[id(ext_link.ext_node)] = queue
+        if i < len(network.netifs):
+            network.netifs[i].eventq_index = queue
+
+    for int_link in network.int_links:
+        src_queue = router_queue(int_link.src_node)
+        dst_queue = router_queue(int_link.dst_node)
+        int_link.eventq_index = src_queue
+        # Garnet links run in the partition of the router feeding them.
+        # Credits flow backwards, from the destination to the source.
+        if hasattr(int_link, "network_link"):
+            int_link.network_link.eventq_index = src_queue
+            int_link.credit_link.eventq_index = dst_queue
+        for bridge in ("src_net_bridge", "src_cred_bridge"):
+            if hasattr(int_link, bridge):
+                getattr(int_link, bridge).eventq_index = src_queue
+        for bridge in ("dst_net_bridge", "dst_cred_bridge"):
+            if hasattr(int_link, bridge):
+                getattr(int_link, bridge).eventq_index = dst_queue
+
+    # Memory controllers (and crossbars in front of them) are created in
+    # directory order by setup_memory_controllers
+    crossbars = getattr(system.ruby, "crossbars", [])
+    ctrls_per_dir = len(system.mem_ctrls) // len(dir_cntrls)
+    for i, dir_cntrl in enumerate(dir_cntrls):
+        queue = cntrl_queues[id(dir_cntrl)]
+        if crossbars:
+            crossbars[i].eventq_index = queue
+        for mem_ctrl in system.mem_ctrls[
+            i * ctrls_per_dir : (i + 1) * ctrls_per_dir
+        ]:
+            mem_ctrl.eventq_index = queue
+
+    # CPU i is connected to sequencer i, which is a child of the
+    # controller that owns it
+    for cpu, seq in zip(cpus, cpu_sequencers):
+        queue = cntrl_queues.get(id(seq.get_parent()))
+        if queue is not None:
+            cpu.eventq_index = queue
+
+
+def ruby_quantum(options):
+    """The longest quantum partitions of the Ruby system can run for
+    without seeing a message from another partition too late, i.e., the
+    latency of the links between routers."""
+    return m5.ticks.fromSeconds(
+        options.link_latency / m5.util.convert.toFrequency(options.ruby_clock)
+    )
+
+
 def create_directories(options, bootmem, ruby_system, system):
     dir_cntrl_nodes = []
     for i in range(options.num_dirs):
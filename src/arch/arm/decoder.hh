@@ -158,18 +158,21 @@ class Decoder : public InstDecoder
     {
         fpscrLen = fpscr.len;
         fpscrStride = fpscr.stride;
+        contextChanged();
     }
 
     void
     setSveLen(uint8_t len)
     {
         sveLen = len;
+        contextChanged();
     }
 
     void
     setSmeLen(uint8_t len)
     {
         smeLen = len;
+        contextChanged();
     }
 };
 
@@ -229,6 +229,13 @@ class ThreadContext : public gem5::ThreadContext
 
     void sendFunctional(PacketPtr pkt) override;
 
+    void
+    sendMemBackdoorReq(const MemBackdoorReq &req,
+                       MemBackdoorPtr &backdoor) override
+    {
+        // Memory lives inside the fast model, there's no back door to it.
+    }
+
     Process *
     getProcessPtr() override
     {
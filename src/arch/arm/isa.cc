@@ -1606,7 +1606,7 @@ ISA::addressTranslation64(MMU::ArmTranslationType tran_type,
     // with unexpected atomic snoop requests.
     warn_once("Doing AT (address translation) in functional mode! Fix Me!\n");
 
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         val, 0, flags,  Request::funcRequestorId,
         tc->pcState().instAddr(), tc->contextId());
 
@@ -1657,7 +1657,7 @@ ISA::addressTranslation(MMU::ArmTranslationType tran_type,
     // with unexpected atomic snoop requests.
     warn_once("Doing AT (address translation) in functional mode! Fix Me!\n");
 
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         val, 0, flags,  Request::funcRequestorId,
         tc->pcState().instAddr(), tc->contextId());
 
@@ -64,14 +64,11 @@ class BasicDecodeCache
 
         entry.machInst = mach_inst;
 
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
-            return entry.inst;
-        }
+        StaticInstPtr &si = instMap[mach_inst];
+        if (!si)
+            si = decoder->decodeInst(mach_inst);
 
-        entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        entry.inst = si;
         return entry.inst;
     }
 };
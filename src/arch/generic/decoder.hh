@@ -49,6 +49,15 @@ class InstDecoder : public SimObject
     bool instDone = false;
     bool outOfBytes = true;
 
+    /**
+     * Generation of the state outside of the PC which decoding depends
+     * on (e.g., the operating mode). Decoders call contextChanged()
+     * whenever that state changes.
+     */
+    uint64_t _contextGen = 0;
+
+    void contextChanged() { _contextGen++; }
+
   public:
     template <typename MoreBytesType>
     InstDecoder(const InstDecoderParams &params, MoreBytesType *mb_buf) :
@@ -90,6 +99,7 @@ class InstDecoder : public SimObject
     {
         instDone = old->instDone;
         outOfBytes = old->outOfBytes;
+        contextChanged();
     }
 
     void *moreBytesPtr() const { return _moreBytesPtr; }
@@ -115,6 +125,14 @@ class InstDecoder : public SimObject
      */
     bool needMoreBytes() const { return outOfBytes; }
 
+    /**
+     * Instructions decoded with the same PC state and context
+     * generation decode to the same StaticInst. CPU models which
+     * keep decoded instructions around use this to tell whether they
+     * are still valid.
+     */
+    uint64_t contextGeneration() const { return _contextGen; }
+
     /**
      * Feed data to the decoder.
      *
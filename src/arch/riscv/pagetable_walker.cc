@@ -476,7 +476,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     }
     else {
         //If we didn't return, we're setting up another read.
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
 
         delete oldRead;
@@ -519,7 +519,7 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     entry.asid = satp.asid;
 
     Request::Flags flags = Request::PHYSICAL;
-    RequestPtr request = std::make_shared<Request>(
+    RequestPtr request = Request::create(
         topAddr, sizeof(PTESv39), flags, walker->requestorId);
 
     read = new Packet(request, MemCmd::ReadReq);
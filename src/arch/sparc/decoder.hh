@@ -79,6 +79,7 @@ class Decoder : public InstDecoder
     setContext(RegVal _asi)
     {
         asi = _asi;
+        contextChanged();
     }
 
   protected:
@@ -677,15 +677,9 @@ Decoder::InstCacheMap Decoder::instCacheMap;
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
-    StaticInstPtr si;
-
-    auto iter = instMap->find(mach_inst);
-    if (iter != instMap->end()) {
-        si = iter->second;
-    } else {
+    StaticInstPtr &si = (*instMap)[mach_inst];
+    if (!si)
         si = decodeInst(mach_inst);
-        (*instMap)[mach_inst] = si;
-    }
 
     si->size(basePC + offset - origPC);
 
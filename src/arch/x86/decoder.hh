@@ -294,6 +294,8 @@ class Decoder : public InstDecoder
             instMap = new decode_cache::InstMap<ExtMachInst>;
             instCacheMap[m5Reg] = instMap;
         }
+
+        contextChanged();
     }
 
     void
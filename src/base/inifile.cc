@@ -28,9 +28,17 @@
 
 #include "base/inifile.hh"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -39,12 +47,91 @@
 namespace gem5
 {
 
+namespace
+{
+
+/*
+ * The binary format starts with a magic number including the format
+ * version, followed by the number of sections and an index of the
+ * sections, which holds the name, the offset from the start of the
+ * file and the size of every section. A section is the number of
+ * entries it has followed by the entries as key/value pairs. Strings
+ * are stored as their length followed by the characters, and all the
+ * numbers are little endian.
+ */
+const char binaryMagic[8] = { 'g', 'e', 'm', '5', 'i', 'n', 'i', 1 };
+
+void
+putInt(std::ostream &os, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        os.put(char((value >> (8 * i)) & 0xff));
+}
+
+void
+putString(std::ostream &os, const std::string &str)
+{
+    putInt(os, str.size(), 4);
+    os.write(str.data(), str.size());
+}
+
+/** Read from a buffer, checking that it doesn't run past its end */
+class BinaryReader
+{
+  private:
+    const char *pos;
+    const char *const end;
+
+  public:
+    BinaryReader(const char *data, size_t size)
+        : pos(data), end(data + size)
+    {}
+
+    bool
+    getInt(uint64_t &value, int bytes)
+    {
+        if (end - pos < bytes)
+            return false;
+        value = 0;
+        for (int i = 0; i < bytes; i++)
+            value |= uint64_t(uint8_t(*pos++)) << (8 * i);
+        return true;
+    }
+
+    bool
+    getString(const char *&str, size_t &size)
+    {
+        uint64_t len;
+        if (!getInt(len, 4) || uint64_t(end - pos) < len)
+            return false;
+        str = pos;
+        size = len;
+        pos += len;
+        return true;
+    }
+
+    bool
+    skipString()
+    {
+        const char *str;
+        size_t size;
+        return getString(str, size);
+    }
+
+    bool done() const { return pos == end; }
+};
+
+} // anonymous namespace
+
 IniFile::IniFile()
 {}
 
 bool
 IniFile::load(const std::string &file)
 {
+    if (isBinary(file))
+        return loadBinary(file);
+
     std::ifstream f(file.c_str());
 
     if (!f.is_open())
@@ -53,6 +140,153 @@ IniFile::load(const std::string &file)
     return load(f);
 }
 
+bool
+IniFile::isBinary(const std::string &file)
+{
+    std::ifstream f(file.c_str(), std::ios::binary);
+    char magic[sizeof(binaryMagic)];
+    return f.read(magic, sizeof(magic)) &&
+        memcmp(magic, binaryMagic, sizeof(magic)) == 0;
+}
+
+void
+IniFile::saveBinary(std::ostream &os) const
+{
+    parseAllSections();
+
+    // Write out the sections in a deterministic order
+    std::vector<std::string> names;
+    getSectionNames(names);
+    std::sort(names.begin(), names.end());
+
+    std::vector<std::string> sections;
+    for (const auto &name : names) {
+        const Section &section = table.at(name);
+        std::ostringstream data;
+        putInt(data, std::distance(section.begin(), section.end()), 4);
+        for (const auto &[key, entry] : section) {
+            putString(data, key);
+            putString(data, entry.peekValue());
+        }
+        sections.push_back(data.str());
+    }
+
+    size_t offset = sizeof(binaryMagic) + 8;
+    for (const auto &name : names)
+        offset += 4 + name.size() + 16;
+
+    os.write(binaryMagic, sizeof(binaryMagic));
+    putInt(os, names.size(), 8);
+    for (size_t i = 0; i < names.size(); i++) {
+        putString(os, names[i]);
+        putInt(os, offset, 8);
+        putInt(os, sections[i].size(), 8);
+        offset += sections[i].size();
+    }
+    for (const auto &data : sections)
+        os.write(data.data(), data.size());
+}
+
+bool
+IniFile::loadBinary(const std::string &file)
+{
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    const size_t size = st.st_size;
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+
+    std::shared_ptr<const char> mapping(static_cast<const char *>(addr),
+        [size](const char *p) { munmap(const_cast<char *>(p), size); });
+    const char *data = mapping.get();
+
+    // Check the whole structure up front, so parsing a section later
+    // on can't fail. The magic number has been checked by isBinary().
+    if (size < sizeof(binaryMagic))
+        return false;
+    BinaryReader index(data + sizeof(binaryMagic),
+                       size - sizeof(binaryMagic));
+    uint64_t num_sections;
+    if (!index.getInt(num_sections, 8))
+        return false;
+
+    std::vector<std::pair<std::string, UnparsedSection>> sections;
+    for (uint64_t i = 0; i < num_sections; i++) {
+        const char *name;
+        size_t name_size;
+        uint64_t offset, section_size;
+        if (!index.getString(name, name_size) ||
+            !index.getInt(offset, 8) || !index.getInt(section_size, 8) ||
+            offset > size || section_size > size - offset) {
+            return false;
+        }
+
+        BinaryReader section(data + offset, section_size);
+        uint64_t num_entries;
+        if (!section.getInt(num_entries, 4))
+            return false;
+        for (uint64_t e = 0; e < num_entries; e++) {
+            if (!section.skipString() || !section.skipString())
+                return false;
+        }
+        if (!section.done())
+            return false;
+
+        sections.emplace_back(std::string(name, name_size),
+                              UnparsedSection{ data + offset, section_size });
+    }
+
+    for (auto &[name, section] : sections) {
+        // A section loaded from an earlier binary file is parsed first,
+        // so this one is merged into it like a text file would be
+        parseSection(name);
+        unparsed.emplace(std::move(name), section);
+    }
+    mappings.push_back(std::move(mapping));
+
+    return true;
+}
+
+void
+IniFile::parseSection(const std::string &sectionName) const
+{
+    auto it = unparsed.find(sectionName);
+    if (it == unparsed.end())
+        return;
+
+    Section &section = table[sectionName];
+    BinaryReader reader(it->second.data, it->second.size);
+    uint64_t num_entries;
+    reader.getInt(num_entries, 4);
+    for (uint64_t e = 0; e < num_entries; e++) {
+        const char *key, *value;
+        size_t key_size, value_size;
+        reader.getString(key, key_size);
+        reader.getString(value, value_size);
+        section.addEntry(std::string(key, key_size),
+                         std::string(value, value_size), false);
+    }
+
+    unparsed.erase(it);
+}
+
+void
+IniFile::parseAllSections() const
+{
+    while (!unparsed.empty())
+        parseSection(unparsed.begin()->first);
+}
+
 
 const std::string &
 IniFile::Entry::getValue() const
@@ -129,6 +363,7 @@ IniFile::Section::findEntry(const std::string &entryName) const
 IniFile::Section *
 IniFile::addSection(const std::string &sectionName)
 {
+    parseSection(sectionName);
     return &table[sectionName];
 }
 
@@ -142,6 +377,7 @@ IniFile::findSection(const std::string &sectionName)
 const IniFile::Section *
 IniFile::findSection(const std::string &sectionName) const
 {
+    parseSection(sectionName);
     auto i = table.find(sectionName);
 
     return (i == table.end()) ? nullptr : &i->second;
@@ -285,6 +521,7 @@ IniFile::Section::printUnreferenced(const std::string &sectionName) const
 void
 IniFile::getSectionNames(std::vector<std::string> &list) const
 {
+    parseAllSections();
     for (auto& entry: table) {
         auto& sectionName = entry.first;
         list.push_back(sectionName);
@@ -294,6 +531,7 @@ IniFile::getSectionNames(std::vector<std::string> &list) const
 bool
 IniFile::printUnreferenced() const
 {
+    parseAllSections();
     bool unref = false;
 
     for (auto& entry: table) {
@@ -329,6 +567,7 @@ IniFile::Section::dump(const std::string &sectionName) const
 void
 IniFile::dump()
 {
+    parseAllSections();
     for (SectionTable::iterator i = table.begin();
          i != table.end(); ++i) {
         i->second.dump(i->first);
@@ -351,6 +590,7 @@ void
 IniFile::visitSection(const std::string &sectionName,
     IniFile::VisitSectionCallback cb)
 {
+    parseSection(sectionName);
     const auto& section = table.at(sectionName);
     for (const auto& pair : section) {
         cb(pair.first, pair.second.getValue());
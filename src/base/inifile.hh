@@ -32,6 +32,7 @@
 #include <fstream>
 #include <functional>
 #include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -77,6 +78,9 @@ class IniFile
         /// Fetch the value.
         const std::string &getValue() const;
 
+        /// Fetch the value without marking the entry as used.
+        const std::string &peekValue() const { return value; }
+
         /// Set the value.
         void setValue(const std::string &v) { value = v; }
 
@@ -146,8 +150,34 @@ class IniFile
     typedef std::unordered_map<std::string, Section> SectionTable;
 
   protected:
-    /// Hash of section names to Section object pointers.
-    SectionTable table;
+    /// Hash of section names to Section object pointers.  Sections of
+    /// binary files are added when they are first looked up, which
+    /// const lookups do as well.
+    mutable SectionTable table;
+
+    /// A section of a binary file that hasn't been parsed yet.
+    struct UnparsedSection
+    {
+        const char *data;
+        size_t size;
+    };
+
+    /// Sections of binary files that haven't been parsed yet.
+    mutable std::unordered_map<std::string, UnparsedSection> unparsed;
+
+    /// The binary files the unparsed sections point into.
+    std::vector<std::shared_ptr<const char>> mappings;
+
+    /// Parse the named section if it came from a binary file and
+    /// hasn't been parsed yet.
+    void parseSection(const std::string &sectionName) const;
+
+    /// Parse all the sections that haven't been parsed yet.
+    void parseAllSections() const;
+
+    /// Load a binary file written by saveBinary().
+    /// @retval True if successful, false if the file is malformed.
+    bool loadBinary(const std::string &file);
 
     /// Look up section with the given name, creating a new section if
     /// not found.
@@ -169,13 +199,23 @@ class IniFile
     /// @retval True if successful, false if errors were encountered.
     bool load(std::istream &f);
 
-    /// Load the specified file.
+    /// Load the specified file, which may be in the text or in the
+    /// binary format.
     /// Parameter settings found in the file will be merged with any
     /// already defined in this object.
     /// @param file The path of the file to load.
     /// @retval True if successful, false if errors were encountered.
     bool load(const std::string &file);
 
+    /// Write the contents in a binary format that load() reads back.
+    /// The binary file starts with an index of the sections, and the
+    /// file is mapped into memory when it is loaded, so sections are
+    /// only parsed once they are looked up.
+    void saveBinary(std::ostream &os) const;
+
+    /// Check if a file is in the binary format.
+    static bool isBinary(const std::string &file);
+
     /// Take string of the form "<section>:<parameter>=<value>" or
     /// "<section>:<parameter>+=<value>" and add to database.
     /// @retval True if successful, false if parse error.
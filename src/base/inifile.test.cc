@@ -30,9 +30,13 @@
  */
 
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -105,3 +109,92 @@ TEST(Initest, MatchNotFound)
     ret = simConfigDB.find("Junk", "test4", value);
     ASSERT_FALSE(ret);
 }
+
+namespace {
+
+/** Save an IniFile in the binary format to a temporary file. */
+std::string
+saveBinary(const IniFile &ini)
+{
+    char filename[] = "inifile-XXXXXX";
+    int fd = mkstemp(filename);
+    EXPECT_NE(-1, fd);
+    close(fd);
+
+    std::ofstream f(filename, std::ios::binary);
+    ini.saveBinary(f);
+    return filename;
+}
+
+} // anonymous namespace
+
+TEST(Initest, BinaryRoundTrip)
+{
+    IniFile text;
+    std::istringstream in(iniFile.str());
+    text.load(in);
+    const std::string filename = saveBinary(text);
+
+    IniFile binary;
+    EXPECT_TRUE(IniFile::isBinary(filename));
+    ASSERT_TRUE(binary.load(filename));
+    unlink(filename.c_str());
+
+    std::string value;
+    ASSERT_TRUE(binary.find("Junk", "Test4", value));
+    EXPECT_EQ(value, "mama mia");
+    ASSERT_TRUE(binary.find("General", "Test3", value));
+    EXPECT_EQ(value, "89");
+    EXPECT_FALSE(binary.find("General", "Test4", value));
+    EXPECT_TRUE(binary.sectionExists("Foo"));
+    EXPECT_FALSE(binary.sectionExists("Bar"));
+
+    std::vector<std::string> names;
+    binary.getSectionNames(names);
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(names, std::vector<std::string>({"Foo", "General", "Junk"}));
+}
+
+TEST(Initest, BinaryMerge)
+{
+    IniFile first;
+    std::istringstream in(iniFile.str());
+    first.load(in);
+    const std::string filename = saveBinary(first);
+
+    // Settings added before and after loading a binary file merge with
+    // the ones in the file like they do for text files
+    IniFile ini;
+    ASSERT_TRUE(ini.add("Foo:Foo1=1"));
+    ASSERT_TRUE(ini.add("Bar:Bar1=2"));
+    ASSERT_TRUE(ini.load(filename));
+    ASSERT_TRUE(ini.add("Junk:Test3+=there"));
+    unlink(filename.c_str());
+
+    std::string value;
+    ASSERT_TRUE(ini.find("Foo", "Foo1", value));
+    EXPECT_EQ(value, "89");
+    ASSERT_TRUE(ini.find("Bar", "Bar1", value));
+    EXPECT_EQ(value, "2");
+    ASSERT_TRUE(ini.find("Junk", "Test3", value));
+    EXPECT_EQ(value, "yo there");
+}
+
+TEST(Initest, BinaryTruncated)
+{
+    IniFile text;
+    std::istringstream in(iniFile.str());
+    text.load(in);
+    const std::string filename = saveBinary(text);
+
+    std::ifstream saved(filename, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(saved)),
+                     std::istreambuf_iterator<char>());
+    saved.close();
+    std::ofstream(filename, std::ios::binary).write(data.data(),
+                                                    data.size() - 1);
+
+    IniFile binary;
+    EXPECT_FALSE(binary.load(filename));
+    unlink(filename.c_str());
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/pool_alloc.hh"
+
+#include <algorithm>
+
+namespace gem5
+{
+
+std::vector<PoolAllocator *> &
+PoolAllocator::registry()
+{
+    static std::vector<PoolAllocator *> pools;
+    return pools;
+}
+
+static std::mutex registryMutex;
+static size_t nextPoolIndex = 0;
+
+PoolAllocator::PoolAllocator(const std::string &name, size_t block_size,
+                             size_t max_free)
+    : _name(name), _blockSize(std::max(block_size, sizeof(Block))),
+      maxFree(max_free),
+      index([]() {
+          std::lock_guard<std::mutex> lock(registryMutex);
+          return nextPoolIndex++;
+      }())
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry().push_back(this);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto &pools = registry();
+        pools.erase(std::remove(pools.begin(), pools.end(), this),
+                    pools.end());
+    }
+
+    // The free lists themselves belong to their threads and are
+    // deleted when those exit.
+    std::lock_guard<std::mutex> lock(mutex);
+    for (FreeList *list : freeLists) {
+        list->release();
+        list->pool = nullptr;
+    }
+}
+
+void
+PoolAllocator::FreeList::release()
+{
+    while (Block *block = head) {
+        head = block->next;
+        ::operator delete(block);
+    }
+    size = 0;
+}
+
+PoolAllocator::FreeList *
+PoolAllocator::newFreeList()
+{
+    // Blocks freed while the thread is being torn down go straight
+    // back to the system allocator.
+    if (threadFreeLists.destroyed)
+        return nullptr;
+
+    auto &lists = threadFreeLists.lists;
+    if (lists.size() <= index)
+        lists.resize(index + 1, nullptr);
+
+    FreeList *list = new FreeList(this);
+    lists[index] = list;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    freeLists.push_back(list);
+    return list;
+}
+
+void
+PoolAllocator::retire(FreeList *list)
+{
+    list->release();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    retiredHits += list->hits;
+    retiredMisses += list->misses;
+    freeLists.erase(std::remove(freeLists.begin(), freeLists.end(), list),
+                    freeLists.end());
+    delete list;
+}
+
+PoolAllocator::ThreadFreeLists::~ThreadFreeLists()
+{
+    destroyed = true;
+    for (FreeList *list : lists) {
+        if (!list)
+            continue;
+        if (list->pool)
+            list->pool->retire(list);
+        else
+            delete list;
+    }
+    lists.clear();
+}
+
+uint64_t
+PoolAllocator::hits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t total = retiredHits;
+    for (const FreeList *list : freeLists)
+        total += list->hits.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t
+PoolAllocator::misses() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t total = retiredMisses;
+    for (const FreeList *list : freeLists)
+        total += list->misses.load(std::memory_order_relaxed);
+    return total;
+}
+
+} // namespace gem5
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_POOL_ALLOC_HH__
+#define __BASE_POOL_ALLOC_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * A recycling allocator for fixed size blocks of memory.
+ *
+ * Freed blocks are kept on a free list and handed out again by the
+ * next allocation, which avoids a round trip through malloc for
+ * objects that are allocated and freed at a high rate (e.g., packets
+ * and requests). Every host thread has its own free list per pool, so
+ * the fast path needs neither locks nor atomic read-modify-write
+ * operations, and the pools can be used from parallel event queues. A
+ * block freed by a different thread than the one that allocated it
+ * simply ends up on the free list of the thread that freed it.
+ *
+ * The number of blocks kept on each free list is bounded; blocks
+ * freed beyond that are returned to the system allocator.
+ */
+class PoolAllocator
+{
+  private:
+    struct Block
+    {
+        Block *next;
+    };
+
+    /** Per-thread state of a pool */
+    struct FreeList
+    {
+        FreeList(PoolAllocator *_pool) : pool(_pool) {}
+
+        /** The pool, or nullptr if it was destroyed before the thread */
+        PoolAllocator *pool;
+        Block *head = nullptr;
+        size_t size = 0;
+
+        void release();
+
+        /*
+         * The counters are only ever written by the owning thread, so
+         * they are updated with relaxed loads and stores rather than
+         * (locked) increments. They are atomic so they can safely be
+         * read when dumping stats.
+         */
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+
+        static void
+        inc(std::atomic<uint64_t> &counter)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+        }
+    };
+
+    /** Free lists of the current thread, indexed by pool. */
+    struct ThreadFreeLists
+    {
+        std::vector<FreeList *> lists;
+        /** Set once the thread is exiting and the lists are gone. */
+        bool destroyed = false;
+        ~ThreadFreeLists();
+    };
+
+    static thread_local ThreadFreeLists threadFreeLists;
+
+    const std::string _name;
+    const size_t _blockSize;
+    const size_t maxFree;
+    const size_t index;
+
+    /** Protects freeLists and the retired counters. */
+    mutable std::mutex mutex;
+    /** Free lists of all live threads, used for stats. */
+    std::vector<FreeList *> freeLists;
+    /** Counters of threads that have exited. */
+    uint64_t retiredHits = 0;
+    uint64_t retiredMisses = 0;
+
+    FreeList *
+    freeList()
+    {
+        auto &lists = threadFreeLists.lists;
+        if (index < lists.size() && lists[index])
+            return lists[index];
+        return newFreeList();
+    }
+
+    FreeList *newFreeList();
+    void retire(FreeList *list);
+
+    static std::vector<PoolAllocator *> &registry();
+
+  public:
+    /**
+     * @param name Name of the pool, used for stats.
+     * @param block_size Size of the blocks in bytes.
+     * @param max_free Maximum number of free blocks kept per thread.
+     */
+    PoolAllocator(const std::string &name, size_t block_size,
+                  size_t max_free=4096);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator &) = delete;
+    PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+    const std::string &name() const { return _name; }
+    size_t blockSize() const { return _blockSize; }
+
+    void *
+    allocate()
+    {
+        FreeList *list = freeList();
+        if (!list)
+            return ::operator new(_blockSize);
+
+        if (Block *block = list->head) {
+            list->head = block->next;
+            list->size--;
+            FreeList::inc(list->hits);
+            return block;
+        }
+
+        FreeList::inc(list->misses);
+        return ::operator new(_blockSize);
+    }
+
+    void
+    deallocate(void *p)
+    {
+        FreeList *list = freeList();
+        if (!list || list->size >= maxFree) {
+            ::operator delete(p);
+            return;
+        }
+
+        Block *block = static_cast<Block *>(p);
+        block->next = list->head;
+        list->head = block;
+        list->size++;
+    }
+
+    /** Number of allocations served from a free list. */
+    uint64_t hits() const;
+    /** Number of allocations that went to the system allocator. */
+    uint64_t misses() const;
+
+    /** All pools that currently exist. */
+    static const std::vector<PoolAllocator *> &
+    pools()
+    {
+        return registry();
+    }
+};
+
+inline thread_local PoolAllocator::ThreadFreeLists
+    PoolAllocator::threadFreeLists;
+
+/**
+ * A standard library allocator drawing from a PoolAllocator. It is
+ * primarily intended to be used with std::allocate_shared, which
+ * rebinds it to a type that holds both the object and the reference
+ * counts. Requests that don't fit in a block of the pool are passed on
+ * to std::allocator.
+ */
+template <typename T>
+class PoolStdAllocator
+{
+  private:
+    template <typename U>
+    friend class PoolStdAllocator;
+
+    PoolAllocator *pool;
+
+    static constexpr bool
+    fits(size_t n, size_t block_size)
+    {
+        return n == 1 && sizeof(T) <= block_size &&
+            alignof(T) <= alignof(std::max_align_t);
+    }
+
+  public:
+    using value_type = T;
+
+    /**
+     * Size of the pool blocks needed to hold a T created with
+     * std::allocate_shared. The block also holds the shared pointer's
+     * control block: a vtable pointer, the use and weak counts, and a
+     * copy of this allocator.
+     */
+    static constexpr size_t sharedBlockSize = sizeof(T) + 4 * sizeof(void *);
+
+    explicit PoolStdAllocator(PoolAllocator &_pool) : pool(&_pool) {}
+
+    template <typename U>
+    PoolStdAllocator(const PoolStdAllocator<U> &other) : pool(other.pool) {}
+
+    T *
+    allocate(size_t n)
+    {
+        if (fits(n, pool->blockSize()))
+            return static_cast<T *>(pool->allocate());
+        return std::allocator<T>().allocate(n);
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        if (fits(n, pool->blockSize()))
+            pool->deallocate(p);
+        else
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool
+    operator==(const PoolStdAllocator<U> &other) const
+    {
+        return pool == other.pool;
+    }
+
+    template <typename U>
+    bool
+    operator!=(const PoolStdAllocator<U> &other) const
+    {
+        return pool != other.pool;
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_POOL_ALLOC_HH__
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/pool_alloc.hh"
+
+using namespace gem5;
+
+/** Freed blocks are handed out again by the next allocation. */
+TEST(PoolAllocatorTest, Recycle)
+{
+    PoolAllocator pool("test", 32);
+    EXPECT_EQ(pool.blockSize(), 32);
+
+    void *p = pool.allocate();
+    EXPECT_EQ(pool.hits(), 0);
+    EXPECT_EQ(pool.misses(), 1);
+
+    pool.deallocate(p);
+    EXPECT_EQ(pool.allocate(), p);
+    EXPECT_EQ(pool.hits(), 1);
+    EXPECT_EQ(pool.misses(), 1);
+
+    pool.deallocate(p);
+}
+
+/** Blocks are always large enough to link them on the free list. */
+TEST(PoolAllocatorTest, MinimumBlockSize)
+{
+    PoolAllocator pool("test", 1);
+    EXPECT_EQ(pool.blockSize(), sizeof(void *));
+}
+
+/** Only max_free blocks are kept around per thread. */
+TEST(PoolAllocatorTest, MaxFree)
+{
+    PoolAllocator pool("test", 16, 2);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 4; i++)
+        blocks.push_back(pool.allocate());
+    for (void *p : blocks)
+        pool.deallocate(p);
+    for (int i = 0; i < 4; i++)
+        blocks[i] = pool.allocate();
+
+    EXPECT_EQ(pool.hits(), 2);
+    EXPECT_EQ(pool.misses(), 6);
+
+    for (void *p : blocks)
+        pool.deallocate(p);
+}
+
+/** Every thread has its own free list, and its counts survive it. */
+TEST(PoolAllocatorTest, Threads)
+{
+    PoolAllocator pool("test", 64);
+    void *p = pool.allocate();
+    pool.deallocate(p);
+
+    std::thread thread([&pool, p]() {
+        void *q = pool.allocate();
+        EXPECT_NE(q, p);
+        pool.deallocate(q);
+        EXPECT_EQ(pool.allocate(), q);
+        pool.deallocate(q);
+    });
+    thread.join();
+
+    EXPECT_EQ(pool.hits(), 1);
+    EXPECT_EQ(pool.misses(), 2);
+    EXPECT_EQ(pool.allocate(), p);
+    pool.deallocate(p);
+}
+
+/** Pools register themselves so that their stats can be reported. */
+TEST(PoolAllocatorTest, Registry)
+{
+    auto registered = [](const PoolAllocator *pool) {
+        for (auto *p : PoolAllocator::pools()) {
+            if (p == pool)
+                return true;
+        }
+        return false;
+    };
+
+    const PoolAllocator *addr;
+    {
+        PoolAllocator pool("test", 8);
+        addr = &pool;
+        EXPECT_TRUE(registered(addr));
+    }
+    EXPECT_FALSE(registered(addr));
+}
+
+/** Shared pointers recycle both the object and the reference counts. */
+TEST(PoolAllocatorTest, AllocateShared)
+{
+    struct Object
+    {
+        uint64_t data[4];
+    };
+
+    PoolAllocator pool("test", PoolStdAllocator<Object>::sharedBlockSize);
+    PoolStdAllocator<Object> alloc(pool);
+
+    auto a = std::allocate_shared<Object>(alloc);
+    void *addr = a.get();
+    a.reset();
+    auto b = std::allocate_shared<Object>(alloc);
+    EXPECT_EQ(b.get(), addr);
+    EXPECT_EQ(pool.hits(), 1);
+    EXPECT_EQ(pool.misses(), 1);
+
+    // Too large for the pool
+    PoolStdAllocator<uint8_t> small(pool);
+    uint8_t *p = small.allocate(1024);
+    small.deallocate(p, 1024);
+    EXPECT_EQ(pool.misses(), 1);
+}
@@ -210,6 +210,13 @@ class RefCountingPtr
     template <bool B = TisConst>
     RefCountingPtr(const NonConstT &r) { copy(r.data); }
 
+    /// Create a reference counting pointer to a base class of the
+    /// object another one points to. Adds a reference.
+    template <class U, class = std::enable_if_t<
+        !std::is_same_v<std::remove_const_t<U>, std::remove_const_t<T>> &&
+        std::is_convertible_v<U *, T *>>>
+    RefCountingPtr(const RefCountingPtr<U> &r) { copy(r.get()); }
+
     /// Destroy the pointer and any reference it may hold.
     ~RefCountingPtr() { del(); }
 
@@ -70,6 +70,10 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class DerivedTestRC : public TestRC
+{
+};
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -172,3 +176,16 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, ConstructionFromDerivedPointer)
+{
+    // Construct a Ptr from a Ptr to a derived class.
+    RefCountingPtr<DerivedTestRC> derived = new DerivedTestRC();
+    {
+        Ptr base = derived;
+        EXPECT_EQ(base.get(), derived.get());
+        derived = nullptr;
+        EXPECT_EQ(1, liveListSize());
+    }
+    EXPECT_EQ(0, liveListSize());
+}
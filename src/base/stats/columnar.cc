@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <cstring>
+#include <iostream>
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+template <typename T>
+void
+writeInt(std::ostream &stream, T value)
+{
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(std::ostream &_stream, bool desc)
+    : stream(_stream), descriptions(desc), schemaMatches(true), statIndex(0)
+{
+    stream.write(magic, sizeof(magic));
+    writeInt(stream, version);
+    if (!valid())
+        fatal("Unable to open statistics file for writing\n");
+}
+
+bool
+Columnar::valid() const
+{
+    return stream.good();
+}
+
+void
+Columnar::begin()
+{
+    row.clear();
+    schemaMatches = true;
+    statIndex = 0;
+}
+
+void
+Columnar::end()
+{
+    if (!schemaMatches || statIndex != schema.size()) {
+        schema.resize(statIndex);
+        writeSchema();
+    }
+
+    writeInt<uint8_t>(stream, RowRecord);
+    writeInt<uint64_t>(stream, curTick());
+    writeInt<uint32_t>(stream, row.size());
+    stream.write(reinterpret_cast<const char *>(row.data()),
+                 row.size() * sizeof(double));
+    stream.flush();
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    path.emplace_back(name);
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!path.empty());
+    path.pop_back();
+}
+
+bool
+Columnar::shouldOutput(const Info &info) const
+{
+    // Unlike the text output, stats whose prereqs are zero are still
+    // stored to keep the columns the same across dumps
+    return info.flags.isSet(display);
+}
+
+bool
+Columnar::newStat(const Info &info, size_t first)
+{
+    const size_t count = row.size() - first;
+    if (schemaMatches && statIndex < schema.size() &&
+            schema[statIndex].id == info.id &&
+            schema[statIndex].columns.size() == count) {
+        statIndex++;
+        return false;
+    }
+
+    if (schemaMatches) {
+        schemaMatches = false;
+        schema.resize(statIndex);
+    }
+
+    std::string name;
+    for (const auto &group : path)
+        name += group + ".";
+    name += info.name;
+
+    schema.push_back({ info.id, name, info.unit->getUnitString(),
+                       descriptions ? info.desc : "", {} });
+    schema.back().columns.reserve(count);
+    statIndex++;
+    return true;
+}
+
+std::string
+Columnar::subname(const std::vector<std::string> &subnames, size_t index)
+{
+    if (index < subnames.size() && !subnames[index].empty())
+        return subnames[index];
+    return std::to_string(index);
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (!shouldOutput(info))
+        return;
+
+    const size_t first = row.size();
+    row.push_back(info.result());
+    if (newStat(info, first))
+        schema.back().columns.push_back(schema.back().name);
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (!shouldOutput(info))
+        return;
+
+    const size_t first = row.size();
+    const VResult &result = info.result();
+    row.insert(row.end(), result.begin(), result.end());
+    if (newStat(info, first)) {
+        Stat &stat = schema.back();
+        for (size_t i = 0; i < result.size(); i++)
+            stat.columns.push_back(stat.name + "::" +
+                                   subname(info.subnames, i));
+    }
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    visit(static_cast<const VectorInfo &>(info));
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (!shouldOutput(info))
+        return;
+
+    const size_t first = row.size();
+    row.insert(row.end(), info.cvec.begin(), info.cvec.end());
+    if (newStat(info, first)) {
+        Stat &stat = schema.back();
+        for (size_t i = 0; i < info.x; i++) {
+            for (size_t j = 0; j < info.y; j++) {
+                stat.columns.push_back(stat.name + "::" +
+                                       subname(info.subnames, i) + "::" +
+                                       subname(info.y_subnames, j));
+            }
+        }
+    }
+}
+
+void
+Columnar::appendDist(const DistData &data)
+{
+    const double fields[] = {
+        data.samples, data.sum, data.squares, data.min_val, data.max_val,
+        data.underflow, data.overflow, data.min, data.bucket_size,
+    };
+    row.insert(row.end(), std::begin(fields), std::end(fields));
+    row.insert(row.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Columnar::distColumns(const std::string &base, const DistData &data,
+                      std::vector<std::string> &columns)
+{
+    for (const char *field : { "samples", "sum", "squares", "min_value",
+                               "max_value", "underflows", "overflows",
+                               "min", "bucket_size" }) {
+        columns.push_back(base + "::" + field);
+    }
+    for (size_t i = 0; i < data.cvec.size(); i++)
+        columns.push_back(base + "::bucket" + std::to_string(i));
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (!shouldOutput(info))
+        return;
+
+    const size_t first = row.size();
+    appendDist(info.data);
+    if (newStat(info, first))
+        distColumns(schema.back().name, info.data, schema.back().columns);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (!shouldOutput(info))
+        return;
+
+    const size_t first = row.size();
+    for (const auto &data : info.data)
+        appendDist(data);
+    if (newStat(info, first)) {
+        Stat &stat = schema.back();
+        for (size_t i = 0; i < info.data.size(); i++) {
+            distColumns(stat.name + "::" + subname(info.subnames, i),
+                        info.data[i], stat.columns);
+        }
+    }
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    warn_once("Columnar stat files don't support sparse histograms.\n");
+}
+
+void
+Columnar::writeString(const std::string &str)
+{
+    writeInt<uint32_t>(stream, str.size());
+    stream.write(str.data(), str.size());
+}
+
+void
+Columnar::writeSchema()
+{
+    writeInt<uint8_t>(stream, SchemaRecord);
+    writeInt<uint32_t>(stream, schema.size());
+    for (const auto &stat : schema) {
+        writeString(stat.name);
+        writeString(stat.unit);
+        writeString(stat.desc);
+        writeInt<uint32_t>(stream, stat.columns.size());
+        for (const auto &column : stat.columns)
+            writeString(column);
+    }
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool desc)
+{
+    OutputStream *os = simout.create(filename, true);
+    return std::unique_ptr<Output>(new Columnar(*os->stream(), desc));
+}
+
+} // namespace statistics
+} // namespace gem5
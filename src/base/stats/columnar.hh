@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Output stats in a columnar binary format.
+ *
+ * The file is a sequence of records. A schema record lists the stats
+ * and the names of their columns, and is followed by one row record
+ * per dump holding the tick of the dump and the values of all the
+ * columns as doubles. Numbers are stored in the host byte order. The
+ * values are appended to a row as they are visited and the row is
+ * written with a single call, so a dump costs little more than copying
+ * the values. A new schema record is only
+ * written when the set of stats dumped changes, e.g., when only a part
+ * of the stat tree is dumped.
+ *
+ * Distributions are stored as their raw counters and buckets.
+ * Sparse histograms don't have a fixed number of columns and aren't
+ * supported. The m5.stats.columnar module reads the files.
+ */
+class Columnar : public Output
+{
+  public:
+    /** Magic at the start of every file. */
+    static constexpr char magic[8] = { 'g', 'e', 'm', '5', 's', 't', 'a',
+                                       't' };
+    static constexpr uint32_t version = 1;
+
+    /** Type of a record in the file. */
+    enum RecordType : uint8_t
+    {
+        SchemaRecord = 'S',
+        RowRecord = 'R',
+    };
+
+    Columnar(std::ostream &stream, bool desc);
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** A stat and the names of its columns in the schema. */
+    struct Stat
+    {
+        int id;
+        std::string name;
+        std::string unit;
+        std::string desc;
+        std::vector<std::string> columns;
+    };
+
+    /**
+     * Check if the stat that was just appended to the row is where the
+     * schema expects it. If it isn't, the schema is rebuilt from this
+     * stat on.
+     *
+     * @param info The stat.
+     * @param first Index in the row of the first value of the stat.
+     * @return True if the caller has to provide the column names.
+     */
+    bool newStat(const Info &info, size_t first);
+
+    /** Append the columns of a distribution to the row. */
+    void appendDist(const DistData &data);
+
+    /** Names of the columns appendDist() appends. */
+    static void distColumns(const std::string &base, const DistData &data,
+                            std::vector<std::string> &columns);
+
+    /** Column name of an element of a vector. */
+    static std::string subname(const std::vector<std::string> &subnames,
+                               size_t index);
+
+    bool shouldOutput(const Info &info) const;
+
+    void writeSchema();
+    void writeString(const std::string &str);
+
+  protected:
+    std::ostream &stream;
+    const bool descriptions;
+
+    // Object/group path, only joined when building the schema
+    std::vector<std::string> path;
+
+    /** The stats in the last schema written. */
+    std::vector<Stat> schema;
+    /** Whether the stats visited so far in this dump match the schema. */
+    bool schemaMatches;
+    /** Index of the next stat of this dump in the schema. */
+    size_t statIndex;
+
+    /** Values of the current dump. */
+    std::vector<double> row;
+};
+
+std::unique_ptr<Output> initColumnar(const std::string &filename,
+                                     bool desc = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
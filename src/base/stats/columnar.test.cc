@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/info.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+class TestScalar : public statistics::ScalarInfo
+{
+  public:
+    TestScalar(const std::string &_name)
+    {
+        name = _name;
+        flags = statistics::display;
+    }
+
+    double val = 0;
+
+    statistics::Counter value() const override { return val; }
+    statistics::Result result() const override { return val; }
+    statistics::Result total() const override { return val; }
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { val = 0; }
+    bool zero() const override { return val == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestVector : public statistics::VectorInfo
+{
+  public:
+    TestVector(const std::string &_name, size_t size)
+        : vals(size)
+    {
+        name = _name;
+        flags = statistics::display;
+    }
+
+    statistics::VCounter vals;
+
+    statistics::size_type size() const override { return vals.size(); }
+    const statistics::VCounter &value() const override { return vals; }
+    const statistics::VResult &result() const override { return vals; }
+    statistics::Result total() const override { return 0; }
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestDist : public statistics::DistInfo
+{
+  public:
+    TestDist(const std::string &_name)
+    {
+        name = _name;
+        flags = statistics::display;
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestVectorDist : public statistics::VectorDistInfo
+{
+  public:
+    TestVectorDist(const std::string &_name, size_t size)
+    {
+        name = _name;
+        flags = statistics::display;
+        data.resize(size);
+    }
+
+    statistics::size_type size() const override { return data.size(); }
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestVector2d : public statistics::Vector2dInfo
+{
+  public:
+    TestVector2d(const std::string &_name, size_t _x, size_t _y)
+    {
+        name = _name;
+        flags = statistics::display;
+        x = _x;
+        y = _y;
+        cvec.resize(x * y);
+    }
+
+    statistics::Result total() const override { return 0; }
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+/** Fill a distribution with two buckets and distinct counters. */
+void
+setDist(statistics::DistData &data, double base)
+{
+    data.samples = base + 1;
+    data.sum = base + 2;
+    data.squares = base + 3;
+    data.min_val = base + 4;
+    data.max_val = base + 5;
+    data.underflow = base + 6;
+    data.overflow = base + 7;
+    data.min = base + 8;
+    data.bucket_size = base + 9;
+    data.cvec = { base + 10, base + 11 };
+}
+
+/** The columns of a distribution with two buckets. */
+std::vector<std::string>
+distColumns(const std::string &base)
+{
+    std::vector<std::string> columns;
+    for (const char *field : { "samples", "sum", "squares", "min_value",
+                               "max_value", "underflows", "overflows",
+                               "min", "bucket_size", "bucket0",
+                               "bucket1" }) {
+        columns.push_back(base + "::" + field);
+    }
+    return columns;
+}
+
+/** The values of a distribution filled by setDist(). */
+std::vector<double>
+distValues(double base)
+{
+    std::vector<double> values;
+    for (int i = 1; i <= 11; i++)
+        values.push_back(base + i);
+    return values;
+}
+
+/** A minimal reader of the records written by the columnar output. */
+class Reader
+{
+  public:
+    Reader(const std::string &_data) : data(_data) {}
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        EXPECT_LE(pos + sizeof(T), data.size());
+        memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        const uint32_t size = get<uint32_t>();
+        std::string str = data.substr(pos, size);
+        pos += size;
+        return str;
+    }
+
+    std::vector<std::string>
+    getSchema()
+    {
+        EXPECT_EQ(get<uint8_t>(), statistics::Columnar::SchemaRecord);
+        std::vector<std::string> columns;
+        const uint32_t num_stats = get<uint32_t>();
+        for (uint32_t i = 0; i < num_stats; i++) {
+            getString();
+            getString();
+            getString();
+            const uint32_t num_columns = get<uint32_t>();
+            for (uint32_t j = 0; j < num_columns; j++)
+                columns.push_back(getString());
+        }
+        return columns;
+    }
+
+    std::vector<double>
+    getRow(Tick tick)
+    {
+        EXPECT_EQ(get<uint8_t>(), statistics::Columnar::RowRecord);
+        EXPECT_EQ(get<uint64_t>(), tick);
+        std::vector<double> values(get<uint32_t>());
+        for (auto &value : values)
+            value = get<double>();
+        return values;
+    }
+
+    bool done() const { return pos == data.size(); }
+
+    const std::string data;
+    size_t pos = 0;
+};
+
+} // anonymous namespace
+
+/** The schema is written once and followed by a row per dump. */
+TEST(StatsColumnarTest, Rows)
+{
+    TestScalar a("a");
+    TestVector b("b", 2);
+    b.subnames = { "x", "" };
+
+    std::stringstream stream;
+    statistics::Columnar output(stream, false);
+    for (int i = 0; i < 3; i++) {
+        tickHandler.setCurTick(i * 100);
+        a.val = i;
+        b.vals = { 10.0 * i, 0.5 };
+
+        output.begin();
+        output.beginGroup("sys");
+        a.visit(output);
+        output.endGroup();
+        b.visit(output);
+        output.end();
+    }
+
+    Reader reader(stream.str());
+    EXPECT_EQ(reader.data.substr(0, sizeof(statistics::Columnar::magic)),
+              "gem5stat");
+    reader.pos = sizeof(statistics::Columnar::magic);
+    EXPECT_EQ(reader.get<uint32_t>(), statistics::Columnar::version);
+    EXPECT_EQ(reader.getSchema(),
+              std::vector<std::string>({ "sys.a", "b::x", "b::1" }));
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(reader.getRow(i * 100),
+                  std::vector<double>({ double(i), 10.0 * i, 0.5 }));
+    }
+    EXPECT_TRUE(reader.done());
+}
+
+/** A new schema is written when different stats are dumped. */
+TEST(StatsColumnarTest, SchemaChange)
+{
+    tickHandler.setCurTick(0);
+
+    TestScalar a("a");
+    TestScalar b("b");
+    TestScalar c("c");
+    c.flags = statistics::none;
+
+    std::stringstream stream;
+    statistics::Columnar output(stream, false);
+    auto dump = [&](std::vector<statistics::Info *> stats) {
+        output.begin();
+        for (auto *stat : stats)
+            stat->visit(output);
+        output.end();
+    };
+    dump({ &a, &b, &c });
+    dump({ &a, &b });
+    dump({ &a });
+    dump({ &a, &b });
+
+    Reader reader(stream.str());
+    reader.pos = sizeof(statistics::Columnar::magic) + sizeof(uint32_t);
+    EXPECT_EQ(reader.getSchema(), std::vector<std::string>({ "a", "b" }));
+    EXPECT_EQ(reader.getRow(0).size(), 2);
+    EXPECT_EQ(reader.getRow(0).size(), 2);
+    EXPECT_EQ(reader.getSchema(), std::vector<std::string>({ "a" }));
+    EXPECT_EQ(reader.getRow(0).size(), 1);
+    EXPECT_EQ(reader.getSchema(), std::vector<std::string>({ "a", "b" }));
+    EXPECT_EQ(reader.getRow(0).size(), 2);
+    EXPECT_TRUE(reader.done());
+}
+
+/** Distributions are stored as their counters followed by the buckets. */
+TEST(StatsColumnarTest, Dist)
+{
+    tickHandler.setCurTick(0);
+
+    TestDist dist("dist");
+    setDist(dist.data, 0);
+
+    std::stringstream stream;
+    statistics::Columnar output(stream, false);
+    output.begin();
+    dist.visit(output);
+    output.end();
+
+    Reader reader(stream.str());
+    reader.pos = sizeof(statistics::Columnar::magic) + sizeof(uint32_t);
+    EXPECT_EQ(reader.getSchema(), distColumns("dist"));
+    EXPECT_EQ(reader.getRow(0), distValues(0));
+    EXPECT_TRUE(reader.done());
+}
+
+/** Each distribution of a vector gets its own set of columns. */
+TEST(StatsColumnarTest, VectorDist)
+{
+    tickHandler.setCurTick(0);
+
+    TestVectorDist dists("vdist", 2);
+    dists.subnames = { "", "y" };
+    setDist(dists.data[0], 0);
+    setDist(dists.data[1], 100);
+
+    std::stringstream stream;
+    statistics::Columnar output(stream, false);
+    output.begin();
+    dists.visit(output);
+    output.end();
+
+    std::vector<std::string> columns = distColumns("vdist::0");
+    std::vector<std::string> columns_y = distColumns("vdist::y");
+    columns.insert(columns.end(), columns_y.begin(), columns_y.end());
+    std::vector<double> values = distValues(0);
+    std::vector<double> values_y = distValues(100);
+    values.insert(values.end(), values_y.begin(), values_y.end());
+
+    Reader reader(stream.str());
+    reader.pos = sizeof(statistics::Columnar::magic) + sizeof(uint32_t);
+    EXPECT_EQ(reader.getSchema(), columns);
+    EXPECT_EQ(reader.getRow(0), values);
+    EXPECT_TRUE(reader.done());
+}
+
+/** 2D vectors are stored row by row and named by both subnames. */
+TEST(StatsColumnarTest, Vector2d)
+{
+    tickHandler.setCurTick(0);
+
+    TestVector2d vec("v2d", 2, 3);
+    vec.subnames = { "a" };
+    vec.y_subnames = { "", "q", "r" };
+    vec.cvec = { 1, 2, 3, 4, 5, 6 };
+
+    std::stringstream stream;
+    statistics::Columnar output(stream, false);
+    for (int i = 0; i < 2; i++) {
+        output.begin();
+        vec.visit(output);
+        output.end();
+        vec.cvec[5] = 7;
+    }
+
+    Reader reader(stream.str());
+    reader.pos = sizeof(statistics::Columnar::magic) + sizeof(uint32_t);
+    EXPECT_EQ(reader.getSchema(),
+              std::vector<std::string>({ "v2d::a::0", "v2d::a::q",
+                                         "v2d::a::r", "v2d::1::0",
+                                         "v2d::1::q", "v2d::1::r" }));
+    EXPECT_EQ(reader.getRow(0),
+              std::vector<double>({ 1, 2, 3, 4, 5, 6 }));
+    EXPECT_EQ(reader.getRow(0),
+              std::vector<double>({ 1, 2, 3, 4, 5, 7 }));
+    EXPECT_TRUE(reader.done());
+}
@@ -29,10 +29,14 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
-#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -41,16 +45,101 @@ namespace gem5
 namespace decode_cache
 {
 
-/// Hash for decoded instructions.
-template <typename EMI>
-using InstMap = std::unordered_map<EMI, StaticInstPtr>;
+/// A direct-mapped cache of decoded instructions, indexed by a hash of
+/// the machine instruction. An instruction that maps to the same slot
+/// as another one replaces it, which bounds the memory used for code
+/// with a large instruction footprint. A replaced instruction is simply
+/// decoded again the next time it is seen. The cache starts out small
+/// and doubles whenever half of it is in use, up to 2^IndexBits slots,
+/// so decoders that only ever see a little code stay small.
+template <typename EMI, typename Value = StaticInstPtr,
+          unsigned IndexBits = 16>
+class InstMap
+{
+  private:
+    struct Entry
+    {
+        EMI machInst;
+        Value value;
+    };
+    unsigned indexBits = std::min(IndexBits, 8u);
+    std::vector<Entry> entries;
+    size_t numUsed = 0;
+
+    size_t
+    index(const EMI &mach_inst) const
+    {
+        // Fibonacci hashing spreads the bits of the hash over the index
+        // even when the hash function is the identity.
+        const uint64_t hash = std::hash<EMI>()(mach_inst);
+        return (hash * 0x9E3779B97F4A7C15ULL) >> (64 - indexBits);
+    }
+
+    /// Double the number of slots, keeping the instructions which
+    /// don't collide in the larger cache.
+    void
+    grow()
+    {
+        std::vector<Entry> old(entries.size() * 2);
+        old.swap(entries);
+        indexBits++;
+        numUsed = 0;
+        for (Entry &entry : old) {
+            if (!entry.value)
+                continue;
+            Entry &slot = entries[index(entry.machInst)];
+            if (!slot.value)
+                numUsed++;
+            slot = std::move(entry);
+        }
+    }
+
+  public:
+    InstMap() : entries(1ULL << indexBits) {}
+
+    /// Find the slot of a machine instruction. If the slot holds a
+    /// different instruction, that one is evicted and an empty value is
+    /// returned, which the caller is expected to fill in.
+    /// @param mach_inst The binary instruction to look up.
+    Value &
+    operator[](const EMI &mach_inst)
+    {
+        Entry *entry = &entries[index(mach_inst)];
+        if (!entry->value) {
+            if (2 * numUsed >= entries.size() && indexBits < IndexBits) {
+                grow();
+                entry = &entries[index(mach_inst)];
+            }
+            if (!entry->value)
+                numUsed++;
+        }
+        if (!entry->value || !(entry->machInst == mach_inst)) {
+            entry->machInst = mach_inst;
+            entry->value = Value();
+        }
+        return entry->value;
+    }
+
+    /// Maximum number of instructions held by the cache.
+    static constexpr size_t capacity() { return 1ULL << IndexBits; }
 
-/// A sparse map from an Addr to a Value, stored in page chunks.
-template<class Value, Addr CacheChunkShift = 12>
+    /// Number of instructions the cache currently has room for.
+    size_t size() const { return entries.size(); }
+};
+
+/// A sparse map from an Addr to a Value, stored in page chunks. The
+/// chunks are found through a two level table: the first level is a
+/// small open-addressed hash table of leaves, each of which covers an
+/// aligned region of 2^LeafBits chunks and is indexed directly by the
+/// chunk number. The most recently used leaf and chunk are remembered,
+/// so sequential code rarely goes past the first comparison.
+template<class Value, Addr CacheChunkShift = 12, unsigned LeafBits = 9>
 class AddrMap
 {
   protected:
     static constexpr Addr CacheChunkBytes = 1ULL << CacheChunkShift;
+    static constexpr Addr LeafShift = CacheChunkShift + LeafBits;
+    static constexpr Addr LeafChunks = 1ULL << LeafBits;
 
     static constexpr Addr
     chunkOffset(Addr addr)
@@ -69,62 +158,120 @@ class AddrMap
     {
         Value items[CacheChunkBytes];
     };
-    // A map of cache chunks which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
-    ChunkMap chunkMap;
-
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
+    // The chunks of one region of the address space.
+    struct Leaf
+    {
+        CacheChunk *chunks[LeafChunks] = {};
+    };
+    // A slot of the first level table. Empty slots have no leaf.
+    struct Root
+    {
+        Addr region;
+        Leaf *leaf;
+    };
+    std::vector<Root> roots;
+    size_t numLeaves = 0;
+
+    // Chunk and leaf of recent lookups. Neither sentinel can match a
+    // real chunk start or region number.
+    Addr recentChunkAddr = 1;
+    CacheChunk *recentChunk = nullptr;
+    Addr recentRegion = ~(Addr)0;
+    Leaf *recentLeaf = nullptr;
+
+    size_t
+    rootIndex(Addr region) const
+    {
+        return (region * 0x9E3779B97F4A7C15ULL) >>
+            (64 - floorLog2(roots.size()));
+    }
+
+    /// Find the slot of a region in the first level table. The slot is
+    /// empty if the region doesn't have a leaf yet.
+    Root &
+    findRoot(Addr region)
+    {
+        const size_t mask = roots.size() - 1;
+        for (size_t i = rootIndex(region); ; i = (i + 1) & mask) {
+            Root &root = roots[i];
+            if (!root.leaf || root.region == region)
+                return root;
+        }
+    }
+
+    /// Double the size of the first level table.
     void
-    update(ChunkIt recentest)
+    growRoots()
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        std::vector<Root> old(roots.size() * 2, Root{0, nullptr});
+        old.swap(roots);
+        for (const Root &root : old) {
+            if (root.leaf)
+                findRoot(root.region) = root;
+        }
+    }
+
+    /// Find the leaf which covers a region, and add it if there isn't
+    /// one yet.
+    Leaf *
+    getLeaf(Addr region)
+    {
+        Root *root = &findRoot(region);
+        if (!root->leaf) {
+            // Keep the table at most half full.
+            if (2 * (numLeaves + 1) > roots.size()) {
+                growRoots();
+                root = &findRoot(region);
+            }
+            *root = Root{region, new Leaf};
+            numLeaves++;
+        }
+        return root->leaf;
     }
 
     /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// address, and add it if it doesn't exist yet. First check the
+    /// most recent result, then look in the leaf of the address.
     /// @param addr The address to look up.
     CacheChunk *
     getChunk(Addr addr)
     {
-        Addr chunk_addr = chunkStart(addr);
-
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
+        const Addr chunk_addr = chunkStart(addr);
+        if (chunk_addr == recentChunkAddr)
+            return recentChunk;
 
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
+        const Addr region = addr >> LeafShift;
+        if (region != recentRegion) {
+            recentLeaf = getLeaf(region);
+            recentRegion = region;
         }
 
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+        CacheChunk *&chunk =
+            recentLeaf->chunks[(addr >> CacheChunkShift) & (LeafChunks - 1)];
+        if (!chunk)
+            chunk = new CacheChunk();
+
+        recentChunkAddr = chunk_addr;
+        recentChunk = chunk;
+        return chunk;
     }
 
   public:
     /// Constructor
-    AddrMap()
+    AddrMap() : roots(16, Root{0, nullptr}) {}
+
+    AddrMap(const AddrMap &) = delete;
+    AddrMap &operator=(const AddrMap &) = delete;
+
+    ~AddrMap()
     {
-        recent[0] = recent[1] = chunkMap.end();
+        for (const Root &root : roots) {
+            if (!root.leaf)
+                continue;
+            for (CacheChunk *chunk : root.leaf->chunks)
+                delete chunk;
+            delete root.leaf;
+        }
     }
 
     Value &
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+/** Entries keep their address and value, however far apart they are. */
+TEST(DecodeCacheTest, AddrMapLookup)
+{
+    // Small chunks and leaves, so the lookups need many of both
+    decode_cache::AddrMap<Addr, 6, 4> map;
+    std::map<Addr, Addr *> seen;
+    std::mt19937_64 rng(0);
+
+    for (int i = 0; i < 100000; i++) {
+        // Cluster most addresses in a few regions, like code does
+        Addr addr = rng();
+        if (i % 4)
+            addr = (addr & 0xffffff) | ((Addr)(i % 3) << 47);
+
+        Addr &entry = map.lookup(addr);
+        auto it = seen.find(addr);
+        if (it == seen.end()) {
+            EXPECT_EQ(entry, 0u);
+            entry = addr;
+            seen[addr] = &entry;
+        } else {
+            // Entries never move
+            EXPECT_EQ(&entry, it->second);
+            EXPECT_EQ(entry, addr);
+        }
+    }
+
+    for (const auto &[addr, entry] : seen)
+        EXPECT_EQ(&map.lookup(addr), entry);
+}
+
+namespace
+{
+
+/** A machine instruction whose hash always puts it in slot 0. */
+struct CollidingInst
+{
+    uint64_t bits;
+    bool operator==(const CollidingInst &other) const
+    {
+        return bits == other.bits;
+    }
+};
+
+} // anonymous namespace
+
+template <>
+struct std::hash<CollidingInst>
+{
+    size_t operator()(const CollidingInst &inst) const { return 0; }
+};
+
+/** Instructions are found again until another one takes their slot. */
+TEST(DecodeCacheTest, InstMapReplace)
+{
+    decode_cache::InstMap<uint64_t, int *, 4> map;
+    int a, b;
+
+    EXPECT_EQ(map[1], nullptr);
+    map[1] = &a;
+    map[2] = &b;
+    EXPECT_EQ(map[1], &a);
+    EXPECT_EQ(map[2], &b);
+
+    decode_cache::InstMap<CollidingInst, int *, 4> colliding;
+    colliding[{1}] = &a;
+    EXPECT_EQ(colliding[{1}], &a);
+    EXPECT_EQ(colliding[{2}], nullptr);
+    colliding[{2}] = &b;
+    EXPECT_EQ(colliding[{2}], &b);
+    EXPECT_EQ(colliding[{1}], nullptr);
+}
+
+/** The cache grows with the number of instructions, up to its capacity. */
+TEST(DecodeCacheTest, InstMapGrow)
+{
+    using Map = decode_cache::InstMap<uint64_t, uint64_t *, 12>;
+    Map map;
+    std::vector<uint64_t> insts(3000);
+    EXPECT_EQ(map.size(), 256);
+
+    for (uint64_t i = 0; i < insts.size(); i++) {
+        insts[i] = i;
+        map[i] = &insts[i];
+        EXPECT_EQ(map[i], &insts[i]);
+        EXPECT_LE(map.size(), Map::capacity());
+        if (i == 100)
+            EXPECT_EQ(map.size(), 256);
+    }
+    EXPECT_EQ(map.size(), 4096);
+
+    // Growing doesn't lose instructions that still have a slot
+    size_t found = 0;
+    for (uint64_t i = 0; i < insts.size(); i++) {
+        uint64_t *&value = map[i];
+        if (value) {
+            EXPECT_EQ(value, &insts[i]);
+            found++;
+        } else {
+            value = &insts[i];
+        }
+    }
+    EXPECT_GT(found, insts.size() / 2);
+
+    decode_cache::InstMap<CollidingInst, int *, 12> colliding;
+    int a;
+    for (uint64_t i = 0; i < 1000; i++)
+        colliding[{i}] = &a;
+    EXPECT_EQ(colliding.size(), 256);
+}
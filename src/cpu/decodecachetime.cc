@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark comparing the decode cache (decode_cache::AddrMap and
+ * decode_cache::InstMap) with the hash maps that were used before.
+ *
+ * The instruction stream mimics a program with a large code footprint:
+ * basic blocks of a few instructions are spread over a text segment
+ * and a few shared libraries far apart in the address space, and
+ * control flow jumps between them with a skew towards hot code. Every
+ * instruction is first looked up by address, and on a miss by its
+ * machine code, as GenericISA::BasicDecodeCache does.
+ */
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/refcnt.hh"
+#include "base/types.hh"
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct FakeInst : public RefCounted
+{
+    FakeInst(uint64_t _machInst) : machInst(_machInst) {}
+    uint64_t machInst;
+};
+
+typedef RefCountingPtr<FakeInst> FakeInstPtr;
+
+struct Entry
+{
+    FakeInstPtr inst;
+    uint64_t machInst = 0;
+};
+
+/** The decode cache as it was before. */
+struct HashCache
+{
+    struct Chunk
+    {
+        Entry items[4096];
+    };
+    std::unordered_map<Addr, Chunk *> chunks;
+    std::unordered_map<Addr, Chunk *>::iterator recent[2];
+    std::unordered_map<uint64_t, FakeInstPtr> insts;
+
+    HashCache() { recent[0] = recent[1] = chunks.end(); }
+
+    ~HashCache()
+    {
+        for (auto &chunk : chunks)
+            delete chunk.second;
+    }
+
+    Entry &
+    lookup(Addr addr)
+    {
+        const Addr chunk_addr = addr & ~(Addr)4095;
+        Chunk *chunk;
+        if (recent[0] != chunks.end() && recent[0]->first == chunk_addr) {
+            chunk = recent[0]->second;
+        } else if (recent[1] != chunks.end() &&
+                recent[1]->first == chunk_addr) {
+            std::swap(recent[0], recent[1]);
+            chunk = recent[0]->second;
+        } else {
+            auto it = chunks.find(chunk_addr);
+            if (it == chunks.end())
+                it = chunks.emplace(chunk_addr, new Chunk).first;
+            recent[1] = recent[0];
+            recent[0] = it;
+            chunk = it->second;
+        }
+        return chunk->items[addr & 4095];
+    }
+
+    FakeInstPtr
+    decode(uint64_t mach_inst, Addr addr, uint64_t &decodes)
+    {
+        Entry &entry = lookup(addr);
+        if (entry.inst && entry.machInst == mach_inst)
+            return entry.inst;
+        entry.machInst = mach_inst;
+        auto it = insts.find(mach_inst);
+        if (it != insts.end()) {
+            entry.inst = it->second;
+            return entry.inst;
+        }
+        decodes++;
+        entry.inst = new FakeInst(mach_inst);
+        insts[mach_inst] = entry.inst;
+        return entry.inst;
+    }
+};
+
+/** The page indexed decode cache. */
+struct FlatCache
+{
+    decode_cache::AddrMap<Entry> pages;
+    decode_cache::InstMap<uint64_t, FakeInstPtr> insts;
+
+    FakeInstPtr
+    decode(uint64_t mach_inst, Addr addr, uint64_t &decodes)
+    {
+        Entry &entry = pages.lookup(addr);
+        if (entry.inst && entry.machInst == mach_inst)
+            return entry.inst;
+        entry.machInst = mach_inst;
+        FakeInstPtr &inst = insts[mach_inst];
+        if (!inst) {
+            decodes++;
+            inst = new FakeInst(mach_inst);
+        }
+        entry.inst = inst;
+        return entry.inst;
+    }
+};
+
+/** Start addresses of the basic blocks of a program. */
+std::vector<Addr>
+makeBlocks(uint64_t footprint, std::mt19937_64 &rng)
+{
+    // The text segment gets half of the code, and a few libraries
+    // mapped high up in the address space share the rest
+    const Addr bases[] = {
+        0x400000, 0x7f0000000000, 0x7f0012340000, 0x7f0100000000,
+        0x7fff00000000,
+    };
+
+    std::vector<Addr> blocks;
+    for (int i = 0; i < 5; i++) {
+        const uint64_t size = i == 0 ? footprint / 2 : footprint / 8;
+        for (Addr pc = 0; pc < size; pc += 4 * (2 + rng() % 8))
+            blocks.push_back(bases[i] + pc);
+    }
+    return blocks;
+}
+
+template <class Cache>
+double
+run(uint64_t footprint, uint64_t num_insts, uint64_t &decodes)
+{
+    std::mt19937_64 rng(footprint);
+    const std::vector<Addr> blocks = makeBlocks(footprint, rng);
+
+    // The machine code at an address. Programs reuse a limited set of
+    // encodings, many of them over and over.
+    auto mach_inst = [](Addr pc) {
+        const uint64_t h = (pc >> 2) * 0x9E3779B97F4A7C15ULL;
+        return (h >> 60) < 12 ? (h >> 32) % 512 : (h >> 32) % 65536;
+    };
+
+    // Jump targets, skewed towards the first (hot) blocks
+    std::vector<uint32_t> targets(1 << 20);
+    for (auto &target : targets) {
+        const uint64_t r = rng() % blocks.size();
+        target = rng() % 4 ? r % (blocks.size() / 16 + 1) : r;
+    }
+
+    Cache cache;
+    decodes = 0;
+    uint64_t check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0, n = 0; n < num_insts; i++) {
+        Addr pc = blocks[targets[i & (targets.size() - 1)]];
+        for (int len = 2 + (pc >> 2) % 8; len > 0; len--, n++, pc += 4)
+            check += cache.decode(mach_inst(pc), pc, decodes)->machInst;
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    // Keep the compiler from optimizing the lookups away
+    if (check == 1)
+        cprintf("");
+
+    return num_insts / elapsed.count();
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+    const uint64_t num_insts = 20000000;
+
+    cprintf("%10s %16s %16s %8s %12s %12s\n", "footprint", "hash (inst/s)",
+            "flat (inst/s)", "speedup", "hash decodes", "flat decodes");
+    for (uint64_t footprint : { 64 * 1024, 1024 * 1024, 16 * 1024 * 1024,
+                                64 * 1024 * 1024 }) {
+        uint64_t hash_decodes, flat_decodes;
+        double hash = run<HashCache>(footprint, num_insts, hash_decodes);
+        double flat = run<FlatCache>(footprint, num_insts, flat_decodes);
+        cprintf("%9dk %16d %16d %8.2f %12d %12d\n", footprint / 1024,
+                (uint64_t)hash, (uint64_t)flat, flat / hash, hash_decodes,
+                flat_decodes);
+    }
+
+    return 0;
+}
@@ -76,5 +76,11 @@ class BaseKvmCPU(BaseCPU):
         False, "Always sync thread contexts on entry/exit"
     )
 
+    hostCpu = Param.Int(
+        -1,
+        "Host CPU to pin the thread running this CPU's event queue to "
+        "(-1 to leave it unpinned)",
+    )
+
     hostFreq = Param.Clock("2GHz", "Host clock frequency")
     hostFactor = Param.Float(1.0, "Cycle scale factor")
@@ -48,3 +48,29 @@ class KvmVM(SimObject):
     )
 
     system = Param.System(Parent.any, "system this VM belongs to")
+
+    def assign_event_queues(self, cpus, host_cpus=None, device_eq=0):
+        """Run every CPU in its own event queue and host thread.
+
+        The children of the CPUs (e.g., interrupt controllers and
+        caches) stay in the device event queue. This has to be called
+        once all children of the CPUs have been created, and the root
+        needs a non-zero sim_quantum.
+
+        :param cpus: KVM CPUs using this VM.
+        :param host_cpus: Optional list of host CPUs to pin the CPU
+            threads to, one per CPU.
+        :param device_eq: Event queue of the devices.
+        """
+        if host_cpus is not None:
+            if len(host_cpus) != len(cpus):
+                raise ValueError("Expected one host CPU per KVM CPU")
+            if len(set(host_cpus)) != len(host_cpus):
+                raise ValueError("KVM CPUs can't share a host CPU")
+
+        for idx, cpu in enumerate(cpus):
+            for obj in cpu.descendants():
+                obj.eventq_index = device_eq
+            cpu.eventq_index = device_eq + 1 + idx
+            if host_cpus is not None:
+                cpu.hostCpu = host_cpus[idx]
@@ -43,6 +43,7 @@
 #include <unistd.h>
 
 #include <cerrno>
+#include <chrono>
 #include <csignal>
 #include <ostream>
 
@@ -260,6 +261,19 @@ BaseKvmCPU::restartEqThread()
 
     vcpuThread = pthread_self();
 
+    if (p.hostCpu >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(p.hostCpu, &cpu_set);
+        const int err = pthread_setaffinity_np(vcpuThread, sizeof(cpu_set),
+                                               &cpu_set);
+        if (err)
+            warn("KVM: Failed to pin thread to host CPU %i (errno: %i)\n",
+                 p.hostCpu, err);
+        else
+            DPRINTF(Kvm, "KVM: Pinned thread to host CPU %i\n", p.hostCpu);
+    }
+
     // Setup signal handlers. This has to be done after the vCPU is
     // created since it manipulates the vCPU signal mask.
     setupSignalHandler();
@@ -296,7 +310,11 @@ BaseKvmCPU::StatGroup::StatGroup(statistics::Group *parent)
              "number of VM exits due to wait for interrupt instructions"),
     ADD_STAT(numInterrupts, statistics::units::Count::get(),
              "number of interrupts delivered"),
-    ADD_STAT(numHypercalls, statistics::units::Count::get(), "number of hypercalls")
+    ADD_STAT(numHypercalls, statistics::units::Count::get(), "number of hypercalls"),
+    ADD_STAT(numMMIOBatches, statistics::units::Count::get(),
+             "number of non-empty coalesced MMIO ring flushes"),
+    ADD_STAT(numDeviceSyncs, statistics::units::Count::get(),
+             "number of migrations to the device event queue")
 {
 }
 
@@ -1116,7 +1134,7 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
     ThreadContext *tc(thread->getTC());
     syncThreadContext();
 
-    RequestPtr mmio_req = std::make_shared<Request>(
+    RequestPtr mmio_req = Request::create(
         paddr, size, Request::UNCACHEABLE, dataRequestorId());
 
     mmio_req->setContext(tc->contextId());
@@ -1156,7 +1174,7 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
     } else {
         // Temporarily lock and migrate to the device event queue to
         // prevent races in multi-core mode.
-        EventQueue::ScopedMigration migrate(deviceEventQueue());
+        DeviceMigration migrate(*this);
 
         return dataPort.submitIO(pkt);
     }
@@ -1199,10 +1217,16 @@ BaseKvmCPU::flushCoalescedMMIO()
     if (!mmioRing)
         return 0;
 
+    if (mmioRing->first == mmioRing->last)
+        return 0;
+
     DPRINTF(KvmIO, "KVM: Flushing the coalesced MMIO ring buffer\n");
+    ++stats.numMMIOBatches;
 
-    // TODO: We might need to do synchronization when we start to
-    // support multiple CPUs
+    // Lock the device event queue once for the whole batch rather
+    // than once per request. The ring is private to this vCPU, so it
+    // doesn't need any further synchronization.
+    DeviceMigration migrate(*this);
     Tick ticks(0);
     while (mmioRing->first != mmioRing->last) {
         struct kvm_coalesced_mmio &ent(
@@ -1220,6 +1244,20 @@ BaseKvmCPU::flushCoalescedMMIO()
     return ticks;
 }
 
+BaseKvmCPU::DeviceMigration::DeviceMigration(BaseKvmCPU &cpu)
+    : doMigrate(cpu.deviceEventQueue() != curEventQueue()),
+      start(std::chrono::steady_clock::now()),
+      migration(cpu.deviceEventQueue())
+{
+    if (!doMigrate)
+        return;
+
+    ++cpu.stats.numDeviceSyncs;
+    DPRINTFS(Kvm, &cpu, "Waited %.3f us for the device event queue\n",
+             std::chrono::duration<double, std::micro>(
+                 std::chrono::steady_clock::now() - start).count());
+}
+
 /**
  * Dummy handler for KVM kick signals.
  *
@@ -40,6 +40,7 @@
 
 #include <pthread.h>
 
+#include <chrono>
 #include <csignal>
 #include <memory>
 #include <queue>
@@ -551,6 +552,29 @@ class BaseKvmCPU : public BaseCPU
      */
     Tick doMMIOAccess(Addr paddr, void *data, int size, bool write);
 
+    /**
+     * Migrate to the device event queue for the lifetime of the
+     * object, counting the migrations and tracing the host time spent
+     * waiting for the queue.
+     *
+     * Devices are shared between all CPUs and live in their own event
+     * queue when the CPUs run in separate threads. Any access to them
+     * therefore has to lock that queue, which stalls the vCPU thread
+     * if another thread holds it.
+     */
+    class DeviceMigration
+    {
+      public:
+        DeviceMigration(BaseKvmCPU &cpu);
+
+      private:
+        // Declared in initialization order, the start time has to be
+        // taken before the migration waits for the device queue's lock
+        const bool doMigrate;
+        const std::chrono::steady_clock::time_point start;
+        EventQueue::ScopedMigration migration;
+    };
+
     /** @{ */
     /**
      * Set the signal mask used in kvmRun()
@@ -816,6 +840,8 @@ class BaseKvmCPU : public BaseCPU
         statistics::Scalar numHalt;
         statistics::Scalar numInterrupts;
         statistics::Scalar numHypercalls;
+        statistics::Scalar numMMIOBatches;
+        statistics::Scalar numDeviceSyncs;
     } stats;
     /* @} */
 
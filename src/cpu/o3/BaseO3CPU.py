@@ -76,6 +76,13 @@ class BaseO3CPU(BaseCPU):
         return True
 
     activity = Param.Unsigned(0, "Initial count")
+    skipStalledCycles = Param.Bool(
+        False,
+        "Stop ticking while none of the stages can make progress until an "
+        "outstanding access or operation completes. This doesn't change "
+        "the simulated timing, but the per-stage cycle stats don't include "
+        "the skipped cycles.",
+    )
 
     cacheStorePorts = Param.Unsigned(
         200, "Cache Ports. Constrains stores only."
@@ -110,6 +110,7 @@ CPU::CPU(const BaseO3CPUParams &params)
       activityRec(name(), NumStages,
                   params.backComSize + params.forwardComSize,
                   params.activity),
+      skipStalledCycles(params.skipStalledCycles),
 
       globalSeqNum(1),
       system(params.system),
@@ -346,7 +347,13 @@ CPU::CPUStats::CPUStats(CPU *cpu)
                "to idling"),
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
-               "for an interrupt")
+               "for an interrupt"),
+      ADD_STAT(timesStalled, statistics::units::Count::get(),
+               "Number of times that the CPU unscheduled itself because none "
+               "of its stages could make progress"),
+      ADD_STAT(stalledCycles, statistics::units::Cycle::get(),
+               "Total number of stalled cycles that the CPU skipped instead "
+               "of ticking through them")
 {
     // Register any of the O3CPU's stats here.
     timesIdled
@@ -357,6 +364,12 @@ CPU::CPUStats::CPUStats(CPU *cpu)
 
     quiesceCycles
         .prereq(quiesceCycles);
+
+    timesStalled
+        .prereq(timesStalled);
+
+    stalledCycles
+        .prereq(stalledCycles);
 }
 
 void
@@ -405,6 +418,11 @@ CPU::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (skipStalledCycles && pipelineStalled()) {
+            DPRINTF(O3CPU, "Stalled, waiting to be woken up!\n");
+            stalled = true;
+            stallCycle = curCycle();
+            cpuStats.timesStalled++;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -516,6 +534,9 @@ CPU::activateContext(ThreadID tid)
 {
     assert(!switchedOut());
 
+    if (stalled)
+        schedule(tickEvent, clockEdge(endStall()));
+
     // Needs to set each stage to running as well.
     activateThread(tid);
 
@@ -555,6 +576,9 @@ CPU::suspendContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Suspending Thread Context.\n", tid);
     assert(!switchedOut());
 
+    if (stalled)
+        endStall();
+
     deactivateThread(tid);
 
     // If this was the last thread then unschedule the tick event.
@@ -576,6 +600,9 @@ CPU::haltContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Halt Context called. Deallocating\n", tid);
     assert(!switchedOut());
 
+    if (stalled)
+        endStall();
+
     deactivateThread(tid);
     removeThread(tid);
 
@@ -1127,6 +1154,7 @@ CPU::squashFromTC(ThreadID tid)
 {
     thread[tid]->noSquashFromTC = true;
     commit.generateTCEvent(tid);
+    wakeIfStalled();
 }
 
 CPU::ListIt
@@ -1312,9 +1340,47 @@ CPU::wakeDependents(const DynInstPtr &inst)
     iew.wakeDependents(inst);
 }
 */
+bool
+CPU::pipelineStalled() const
+{
+    // Nothing may be in flight between the stages, and fetch is the
+    // only stage that may still consider itself active
+    int fetch_active = activityRec.getStageActive(FetchIdx) ? 1 : 0;
+    return activityRec.getActivityCount() == fetch_active &&
+        fetch.isStalled();
+}
+
+Cycles
+CPU::endStall()
+{
+    assert(stalled);
+    stalled = false;
+
+    // Had the CPU kept ticking, it would already have ticked in the
+    // current cycle if this is serviced after the tick event
+    Cycles delay(0);
+    if (curTick() == clockEdge() && (curCycle() == stallCycle ||
+            eventQueue()->getCurPriority() > tickEvent.priority())) {
+        delay = Cycles(1);
+    }
+
+    Cycles skipped = curCycle() + delay - stallCycle - Cycles(1);
+    DPRINTF(Activity, "Skipped %d stalled cycles\n", skipped);
+    cpuStats.stalledCycles += skipped;
+    baseStats.numCycles += skipped;
+
+    return delay;
+}
+
 void
 CPU::wakeCPU()
 {
+    if (stalled) {
+        DPRINTF(Activity, "Waking up stalled CPU\n");
+        schedule(tickEvent, clockEdge(endStall()));
+        return;
+    }
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
@@ -1336,8 +1402,11 @@ CPU::wakeCPU()
 void
 CPU::wakeup(ThreadID tid)
 {
-    if (thread[tid]->status() != gem5::ThreadContext::Suspended)
+    if (thread[tid]->status() != gem5::ThreadContext::Suspended) {
+        // A stalled CPU would have noticed an interrupt in its next cycle
+        wakeIfStalled();
         return;
+    }
 
     wakeCPU();
 
@@ -1457,7 +1526,7 @@ CPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        Request::create(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(thread[tid]->contextId());
@@ -485,13 +485,19 @@ class CPU : public BaseCPU
 
   public:
     /** Records that there was time buffer activity this cycle. */
-    void activityThisCycle() { activityRec.activity(); }
+    void
+    activityThisCycle()
+    {
+        activityRec.activity();
+        wakeIfStalled();
+    }
 
     /** Changes a stage's status to active within the activity recorder. */
     void
     activateStage(const StageIdx idx)
     {
         activityRec.activateStage(idx);
+        wakeIfStalled();
     }
 
     /** Changes a stage's status to inactive within the activity recorder. */
@@ -504,6 +510,55 @@ class CPU : public BaseCPU
     /** Wakes the CPU, rescheduling the CPU if it's not already active. */
     void wakeCPU();
 
+    /**
+     * Wakes the CPU only if it is skipping stalled cycles. This is used
+     * for events that change state one of the stages checks every
+     * cycle, which doesn't need to wake the CPU when it is idle.
+     */
+    void
+    wakeIfStalled()
+    {
+        if (stalled)
+            wakeCPU();
+    }
+
+  private:
+    /**
+     * @{
+     * @name Stall skipping
+     *
+     * When none of the stages can make progress until an outstanding
+     * access or operation completes, the CPU stops ticking even though
+     * the activity recorder still considers it active (e.g., because
+     * fetch keeps trying to fetch into a full queue while the ROB is
+     * full and waiting for a cache miss). The events that would end
+     * the stall wake the CPU up again, at the cycle it would have
+     * noticed them in had it kept ticking. The skipped cycles are
+     * counted as if the CPU had ticked through them, so skipping them
+     * doesn't change the simulated timing.
+     */
+    const bool skipStalledCycles;
+
+    /** Is the CPU currently skipping stalled cycles? */
+    bool stalled = false;
+
+    /** The last cycle the CPU ticked in before it stalled. */
+    Cycles stallCycle;
+
+    /** Can none of the stages make progress on their own? */
+    bool pipelineStalled() const;
+
+    /**
+     * Stop skipping stalled cycles and account for the ones that were
+     * skipped.
+     *
+     * @return The delay until the cycle the CPU should tick in next.
+     */
+    Cycles endStall();
+    /** @} */
+
+  public:
+
     virtual void wakeup(ThreadID tid) override;
 
     /** Gets a free thread id. Use if thread ids change across system. */
@@ -584,6 +639,11 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for the number of times the CPU stopped ticking because
+         * none of its stages could make progress. */
+        statistics::Scalar timesStalled;
+        /** Stat for the number of stalled cycles that were skipped. */
+        statistics::Scalar stalledCycles;
     } cpuStats;
 
   public:
@@ -422,6 +422,42 @@ Fetch::isDrained() const
     return !finishTranslationEvent.scheduled();
 }
 
+bool
+Fetch::isStalled() const
+{
+    if (numThreads != 1 || activeThreads->size() != 1)
+        return false;
+
+    ThreadID tid = activeThreads->front();
+
+    switch (fetchStatus[tid]) {
+      case TrapPending:
+      case QuiescePending:
+      case ItlbWait:
+      case IcacheWaitResponse:
+      case IcacheWaitRetry:
+        return true;
+      case Running:
+        break;
+      default:
+        return false;
+    }
+
+    if (!stalls[tid].decode || fetchQueue[tid].size() < fetchQueueSize)
+        return false;
+
+    // Fetch also starts an icache access if the fetch buffer doesn't
+    // hold the instruction at the PC, even if its queue is full
+    const PCStateBase &this_pc = *pc[tid];
+    if (isRomMicroPC(this_pc.microPC()) || macroop[tid])
+        return true;
+
+    Addr fetch_addr = (this_pc.instAddr() + fetchOffset[tid]) &
+        decoder[tid]->pcMask();
+    return fetchBufferValid[tid] &&
+        fetchBufferAlignPC(fetch_addr) == fetchBufferPC[tid];
+}
+
 void
 Fetch::takeOverFrom()
 {
@@ -558,7 +594,7 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = Request::create(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -880,8 +916,10 @@ Fetch::tick()
 
     // Pick a random thread to start trying to grab instructions from
     auto tid_itr = activeThreads->begin();
-    std::advance(tid_itr,
-            random_mt.random<uint8_t>(0, activeThreads->size() - 1));
+    if (activeThreads->size() > 1) {
+        std::advance(tid_itr,
+                random_mt.random<uint8_t>(0, activeThreads->size() - 1));
+    }
 
     while (available_insts != 0 && insts_to_decode < decodeWidth) {
         ThreadID tid = *tid_itr;
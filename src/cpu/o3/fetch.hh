@@ -241,6 +241,16 @@ class Fetch
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /**
+     * Can fetch not make any progress until it is signaled by another
+     * stage or an outstanding access completes? This is the case when
+     * it is waiting for the ITLB or the icache, or when its queue is
+     * full and decode doesn't take instructions from it. This is only
+     * detected for a single thread, as otherwise the thread to fetch
+     * from and send instructions to decode from changes every cycle.
+     */
+    bool isStalled() const;
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -349,7 +359,7 @@ class Fetch
     void fetch(bool &status_change);
 
     /** Align a PC to the start of a fetch buffer block. */
-    Addr fetchBufferAlignPC(Addr addr)
+    Addr fetchBufferAlignPC(Addr addr) const
     {
         return (addr & ~(fetchBufferMask));
     }
@@ -840,7 +840,7 @@ LSQ::pushRequest(const DynInstPtr& inst, bool isLoad, uint8_t *data,
             inst->effAddrValid(true);
 
             if (cpu->checker) {
-                inst->reqToVerify = std::make_shared<Request>(*request->req());
+                inst->reqToVerify = Request::create(*request->req());
             }
             Fault fault;
             if (isLoad)
@@ -896,6 +896,8 @@ LSQ::SingleDataRequest::finish(const Fault &fault, const RequestPtr &request,
 
         LSQRequest::_inst->fault = fault;
         LSQRequest::_inst->translationCompleted(true);
+        // IEW checks for completed translations every cycle
+        LSQRequest::_inst->cpu->wakeIfStalled();
     }
 }
 
@@ -921,6 +923,7 @@ LSQ::SplitDataRequest::finish(const Fault &fault, const RequestPtr &req,
             _inst->strictlyOrdered(_mainReq->isStrictlyOrdered());
             flags.set(Flag::TranslationFinished);
             _inst->translationCompleted(true);
+            _inst->cpu->wakeIfStalled();
 
             for (i = 0; i < _fault.size() && _fault[i] == NoFault; i++);
             if (i > 0) {
@@ -989,7 +992,7 @@ LSQ::SplitDataRequest::initiateTranslation()
     Addr final_addr = addrBlockAlign(_addr + _size, cacheLineSize);
     uint32_t size_so_far = 0;
 
-    _mainReq = std::make_shared<Request>(base_addr,
+    _mainReq = Request::create(base_addr,
                 _size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId());
     _mainReq->setByteEnable(_byteEnable);
@@ -1106,7 +1109,7 @@ LSQ::LSQRequest::addReq(Addr addr, unsigned size,
            const std::vector<bool>& byte_enable)
 {
     if (isAnyActiveElement(byte_enable.begin(), byte_enable.end())) {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 addr, size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId(),
                 std::move(_amo_op));
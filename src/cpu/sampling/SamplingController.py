@@ -0,0 +1,134 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.SimObject import SimObject
+from m5.params import *
+from m5.util.pybind import *
+
+
+class SamplingController(SimObject):
+    """Drives SMARTS-style sampled simulation.
+
+    The workload runs on the fast CPUs, and every period instructions
+    the controller switches to the detailed CPUs to warm up their
+    microarchitectural state and then measure the CPI of a window of
+    instructions. Sampling stops once the confidence interval of the
+    mean CPI is within the requested error, and the estimate is reported
+    in the stats of the controller.
+
+    The simulation starts on the fast CPU, the detailed CPU must be
+    created switched out. Call run() instead of m5.simulate(). Only a
+    single CPU is supported, see configs/example/sampling.py for an
+    example.
+    """
+
+    type = "SamplingController"
+    cxx_header = "cpu/sampling/sampling_controller.hh"
+    cxx_class = "gem5::SamplingController"
+
+    cxx_exports = [
+        PyBindMethod("startFastForward"),
+        PyBindMethod("startWarmup"),
+        PyBindMethod("startMeasurement"),
+        PyBindMethod("endMeasurement"),
+        PyBindMethod("done"),
+        PyBindMethod("numSamples"),
+        PyBindMethod("cpi"),
+        PyBindMethod("cpiError"),
+    ]
+
+    # Cause of the exit events that end every phase, keep in sync with
+    # SamplingController::exitCause
+    exit_cause = "sampling phase done"
+
+    fast_cpus = VectorParam.BaseCPU("CPU used to fast-forward")
+    detailed_cpus = VectorParam.BaseCPU("CPU used for warmup and measurement")
+
+    period = Param.Counter(
+        10000000, "Instructions from the start of one sample to the next"
+    )
+    warmup_insts = Param.Counter(
+        20000, "Instructions of detailed warmup before every sample"
+    )
+    measure_insts = Param.Counter(1000, "Instructions measured per sample")
+
+    confidence = Param.Float(0.997, "Confidence level of the CPI estimate")
+    relative_error = Param.Float(
+        0.03, "Target half width of the confidence interval, relative to CPI"
+    )
+    min_samples = Param.Unsigned(
+        30, "Minimum number of samples before checking the confidence"
+    )
+    max_samples = Param.Unsigned(0, "Maximum number of samples (0: no limit)")
+
+    def run(self, system, stats_per_sample=False):
+        """Run sampled simulation until the CPI estimate is accurate
+        enough.
+
+        Parameters:
+          * system: The system the CPUs belong to.
+          * stats_per_sample (bool): Reset the stats before and dump them
+            after every measured window.
+
+        Returns None once the target confidence is reached, or the exit
+        event if the simulation exits for another reason, e.g., because
+        the workload finished.
+        """
+
+        import m5
+
+        to_detailed = list(zip(self.fast_cpus, self.detailed_cpus))
+        to_fast = list(zip(self.detailed_cpus, self.fast_cpus))
+
+        def simulate():
+            event = m5.simulate()
+            return None if event.getCause() == self.exit_cause else event
+
+        while not self.done():
+            self.startFastForward()
+            event = simulate()
+            if event:
+                return event
+
+            m5.switchCpus(system, to_detailed, verbose=False)
+            self.startWarmup()
+            event = simulate()
+            if event:
+                return event
+
+            if stats_per_sample:
+                m5.stats.reset()
+            self.startMeasurement()
+            event = simulate()
+            if event:
+                return event
+            self.endMeasurement()
+            if stats_per_sample:
+                m5.stats.dump()
+
+            m5.switchCpus(system, to_fast, verbose=False)
+
+        return None
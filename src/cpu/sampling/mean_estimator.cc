@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/sampling/mean_estimator.hh"
+
+#include <cmath>
+
+namespace gem5
+{
+
+double
+normalQuantile(double p)
+{
+    // Bisect the normal CDF, which the standard library provides
+    // through erfc()
+    double low = -40;
+    double high = 40;
+    for (int i = 0; i < 100; i++) {
+        const double mid = (low + high) / 2;
+        if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p)
+            low = mid;
+        else
+            high = mid;
+    }
+    return (low + high) / 2;
+}
+
+MeanEstimator::MeanEstimator(double confidence, double relative_error,
+                             unsigned min_samples, unsigned max_samples)
+    : zScore(normalQuantile(0.5 + confidence / 2)),
+      relativeError(relative_error), minSamples(min_samples),
+      maxSamples(max_samples)
+{
+}
+
+void
+MeanEstimator::add(double sample)
+{
+    // Welford's algorithm keeps the variance numerically stable
+    samples++;
+    const double delta = sample - _mean;
+    _mean += delta / samples;
+    m2 += delta * (sample - _mean);
+}
+
+double
+MeanEstimator::stdev() const
+{
+    return samples > 1 ? std::sqrt(m2 / (samples - 1)) : 0;
+}
+
+double
+MeanEstimator::error() const
+{
+    if (samples < 2 || _mean == 0)
+        return INFINITY;
+    return zScore * stdev() / std::sqrt(samples) / _mean;
+}
+
+bool
+MeanEstimator::done() const
+{
+    if (maxSamples && samples >= maxSamples)
+        return true;
+    return samples >= minSamples && error() <= relativeError;
+}
+
+} // namespace gem5
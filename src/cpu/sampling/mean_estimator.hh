@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SAMPLING_MEAN_ESTIMATOR_HH__
+#define __CPU_SAMPLING_MEAN_ESTIMATOR_HH__
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Standard score below which a standard normal variable falls with
+ * probability p.
+ */
+double normalQuantile(double p);
+
+/**
+ * Running estimate of the mean of a series of samples, and of the
+ * confidence interval of that mean.
+ */
+class MeanEstimator
+{
+  public:
+    /**
+     * @param confidence Confidence level of the interval, in (0, 1).
+     * @param relative_error Target half width of the interval, relative
+     *        to the mean.
+     * @param min_samples Samples to take before trusting the interval.
+     * @param max_samples Samples after which to stop regardless, 0 for
+     *        no limit.
+     */
+    MeanEstimator(double confidence, double relative_error,
+                  unsigned min_samples, unsigned max_samples);
+
+    /** Add a sample to the estimate. */
+    void add(double sample);
+
+    /** Number of samples so far. */
+    Counter count() const { return samples; }
+
+    /** Mean of the samples. */
+    double mean() const { return _mean; }
+
+    /** Sample standard deviation. */
+    double stdev() const;
+
+    /** Half width of the confidence interval relative to the mean. */
+    double error() const;
+
+    /** Whether the estimate is accurate enough or enough samples were
+     * taken. */
+    bool done() const;
+
+  private:
+    /** Standard score corresponding to the confidence level. */
+    const double zScore;
+    const double relativeError;
+    const unsigned minSamples;
+    const unsigned maxSamples;
+
+    /** Running mean and sum of squared deviations. */
+    Counter samples = 0;
+    double _mean = 0;
+    double m2 = 0;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SAMPLING_MEAN_ESTIMATOR_HH__
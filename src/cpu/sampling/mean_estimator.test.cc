@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "cpu/sampling/mean_estimator.hh"
+
+using namespace gem5;
+
+/** The quantiles match the well known standard scores. */
+TEST(MeanEstimatorTest, NormalQuantile)
+{
+    EXPECT_NEAR(normalQuantile(0.5), 0, 1e-9);
+    EXPECT_NEAR(normalQuantile(0.975), 1.959964, 1e-6);
+    EXPECT_NEAR(normalQuantile(0.995), 2.575829, 1e-6);
+    EXPECT_NEAR(normalQuantile(0.9985), 2.967738, 1e-6);
+    EXPECT_NEAR(normalQuantile(0.025), -1.959964, 1e-6);
+}
+
+/** The running mean and deviation match the two-pass formulas. */
+TEST(MeanEstimatorTest, MeanAndStdev)
+{
+    MeanEstimator estimate(0.95, 0.01, 2, 0);
+    EXPECT_EQ(estimate.count(), 0);
+    EXPECT_EQ(estimate.stdev(), 0);
+
+    const std::vector<double> samples = {1.5, 2.25, 0.75, 3.0, 1.0, 2.5};
+    for (double sample : samples)
+        estimate.add(sample);
+
+    double sum = 0;
+    for (double sample : samples)
+        sum += sample;
+    const double mean = sum / samples.size();
+    double squares = 0;
+    for (double sample : samples)
+        squares += (sample - mean) * (sample - mean);
+    const double stdev = std::sqrt(squares / (samples.size() - 1));
+
+    EXPECT_EQ(estimate.count(), Counter(samples.size()));
+    EXPECT_NEAR(estimate.mean(), mean, 1e-12);
+    EXPECT_NEAR(estimate.stdev(), stdev, 1e-12);
+}
+
+/** Welford's algorithm doesn't lose the variance to a large mean. */
+TEST(MeanEstimatorTest, LargeMean)
+{
+    MeanEstimator estimate(0.95, 0.01, 2, 0);
+    for (int i = 0; i < 1000; i++)
+        estimate.add(1e9 + (i % 2 ? 1 : -1));
+    EXPECT_NEAR(estimate.mean(), 1e9, 1e-6);
+    EXPECT_NEAR(estimate.stdev(), std::sqrt(1000.0 / 999), 1e-6);
+}
+
+/** The error is the half width of the interval relative to the mean. */
+TEST(MeanEstimatorTest, Error)
+{
+    MeanEstimator estimate(0.95, 0.01, 2, 0);
+    EXPECT_TRUE(std::isinf(estimate.error()));
+    estimate.add(2);
+    EXPECT_TRUE(std::isinf(estimate.error()));
+    estimate.add(4);
+    estimate.add(3);
+    estimate.add(3);
+
+    // mean 3, stdev sqrt(2 / 3), 4 samples
+    const double expected =
+        normalQuantile(0.975) * std::sqrt(2.0 / 3) / std::sqrt(4.0) / 3;
+    EXPECT_NEAR(estimate.error(), expected, 1e-12);
+
+    // A zero mean has no relative error
+    MeanEstimator zero(0.95, 0.01, 2, 0);
+    zero.add(0);
+    zero.add(0);
+    EXPECT_TRUE(std::isinf(zero.error()));
+}
+
+/** Sampling stops once the interval is narrow enough. */
+TEST(MeanEstimatorTest, DoneOnConfidence)
+{
+    MeanEstimator estimate(0.95, 0.05, 3, 0);
+    // Identical samples have no error, but the minimum still applies
+    estimate.add(1);
+    estimate.add(1);
+    EXPECT_EQ(estimate.error(), 0);
+    EXPECT_FALSE(estimate.done());
+    estimate.add(1);
+    EXPECT_TRUE(estimate.done());
+
+    MeanEstimator noisy(0.95, 0.05, 3, 0);
+    for (int i = 0; i < 10; i++)
+        noisy.add(i % 2 ? 1 : 3);
+    EXPECT_GT(noisy.error(), 0.05);
+    EXPECT_FALSE(noisy.done());
+    while (!noisy.done())
+        noisy.add(noisy.count() % 2 ? 1 : 3);
+    EXPECT_LE(noisy.error(), 0.05);
+}
+
+/** Sampling stops after the maximum number of samples regardless. */
+TEST(MeanEstimatorTest, DoneOnMaxSamples)
+{
+    MeanEstimator estimate(0.95, 0.001, 2, 4);
+    for (int i = 0; i < 3; i++) {
+        estimate.add(i % 2 ? 1 : 3);
+        EXPECT_FALSE(estimate.done());
+    }
+    estimate.add(1);
+    EXPECT_GT(estimate.error(), 0.001);
+    EXPECT_TRUE(estimate.done());
+}
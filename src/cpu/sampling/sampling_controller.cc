@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/sampling/sampling_controller.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/base.hh"
+#include "debug/Sampling.hh"
+
+namespace gem5
+{
+
+SamplingController::SamplingController(const SamplingControllerParams &p)
+    : SimObject(p),
+      fastCPU(p.fast_cpus.empty() ? nullptr : p.fast_cpus[0]),
+      detailedCPU(p.detailed_cpus.empty() ? nullptr : p.detailed_cpus[0]),
+      period(p.period), warmupInsts(p.warmup_insts),
+      measureInsts(p.measure_insts),
+      estimate(p.confidence, p.relative_error, p.min_samples,
+               p.max_samples),
+      stats(*this)
+{
+    fatal_if(p.fast_cpus.size() != 1 || p.detailed_cpus.size() != 1,
+             "%s: Needs exactly one fast and one detailed CPU, got %d "
+             "and %d.\n", name(), p.fast_cpus.size(),
+             p.detailed_cpus.size());
+    fatal_if(measureInsts == 0, "%s: Can't measure empty windows.\n",
+             name());
+    fatal_if(warmupInsts + measureInsts >= period,
+             "%s: The sampling period must be longer than the warmup and "
+             "the measured window.\n", name());
+    fatal_if(p.confidence <= 0 || p.confidence >= 1,
+             "%s: The confidence level must be between 0 and 1.\n", name());
+    fatal_if(p.min_samples < 2, "%s: Needs at least two samples to estimate "
+             "the confidence interval.\n", name());
+}
+
+void
+SamplingController::scheduleStop(BaseCPU *cpu, Counter insts)
+{
+    cpu->scheduleInstStop(0, insts, exitCause);
+}
+
+void
+SamplingController::startFastForward()
+{
+    DPRINTF(Sampling, "Fast-forwarding to sample %d\n", numSamples());
+    scheduleStop(fastCPU, period - warmupInsts - measureInsts);
+}
+
+void
+SamplingController::startWarmup()
+{
+    DPRINTF(Sampling, "Warming up for sample %d\n", numSamples());
+    scheduleStop(detailedCPU, warmupInsts);
+}
+
+void
+SamplingController::startMeasurement()
+{
+    DPRINTF(Sampling, "Measuring sample %d\n", numSamples());
+    startCycles = detailedCPU->curCycle();
+    startInsts = detailedCPU->totalInsts();
+    scheduleStop(detailedCPU, measureInsts);
+}
+
+bool
+SamplingController::endMeasurement()
+{
+    const double cycles = detailedCPU->curCycle() - startCycles;
+    const double insts = detailedCPU->totalInsts() - startInsts;
+    panic_if(insts == 0, "%s: No instructions committed in a window.\n",
+             name());
+    const double sample_cpi = cycles / insts;
+    estimate.add(sample_cpi);
+
+    DPRINTF(Sampling, "Sample %d: CPI %f, mean %f +- %f%%\n",
+            numSamples() - 1, sample_cpi, cpi(), cpiError() * 100);
+
+    return done();
+}
+
+SamplingController::SamplingStats::SamplingStats(SamplingController &sc)
+    : statistics::Group(&sc),
+      ADD_STAT(samples, statistics::units::Count::get(),
+               "Number of measured windows"),
+      ADD_STAT(cpi, statistics::units::Rate<
+                statistics::units::Cycle, statistics::units::Count>::get(),
+               "Estimated CPI, mean of the measured windows"),
+      ADD_STAT(cpiStdev, statistics::units::Rate<
+                statistics::units::Cycle, statistics::units::Count>::get(),
+               "Standard deviation of the CPI of the measured windows"),
+      ADD_STAT(cpiError, statistics::units::Ratio::get(),
+               "Half width of the CPI confidence interval relative to "
+               "the estimate")
+{
+    samples.method(&sc, &SamplingController::numSamples);
+    cpi.method(&sc, &SamplingController::cpi);
+    cpiStdev.method(&sc, &SamplingController::cpiStdev);
+    cpiError.method(&sc, &SamplingController::cpiError);
+}
+
+} // namespace gem5
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SAMPLING_SAMPLING_CONTROLLER_HH__
+#define __CPU_SAMPLING_SAMPLING_CONTROLLER_HH__
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/sampling/mean_estimator.hh"
+#include "params/SamplingController.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+
+/**
+ * Controller for sampled simulation in the style of SMARTS.
+ *
+ * Every sample consists of a fast-forward phase on the fast CPUs, a
+ * warmup phase on the detailed CPUs and a measured window on the
+ * detailed CPUs. The controller schedules the exit events that end
+ * every phase, and keeps a running estimate of the mean CPI of the
+ * measured windows and its confidence interval. Switching between the
+ * CPUs is left to the Python side (SamplingController.run()), which
+ * keeps going until done() is true.
+ *
+ * Only a single CPU is supported, the end of every phase is detected
+ * by an instruction count on that CPU.
+ */
+class SamplingController : public SimObject
+{
+  public:
+    /** Cause of the exit events that end every phase. */
+    static constexpr const char *exitCause = "sampling phase done";
+
+    SamplingController(const SamplingControllerParams &p);
+
+    /** Fast-forward on the fast CPUs until the next sample is due. */
+    void startFastForward();
+
+    /** Warm up the detailed CPUs ahead of a measured window. */
+    void startWarmup();
+
+    /** Start measuring a window on the detailed CPUs. */
+    void startMeasurement();
+
+    /**
+     * Finish measuring a window and add its CPI to the estimate.
+     *
+     * @return True if the estimate is accurate enough.
+     */
+    bool endMeasurement();
+
+    /** Whether the estimate is accurate enough or enough samples were
+     * taken. */
+    bool done() const { return estimate.done(); }
+
+    /** Number of windows measured so far. */
+    Counter numSamples() const { return estimate.count(); }
+
+    /** Mean CPI of the measured windows. */
+    double cpi() const { return estimate.mean(); }
+
+    /** Half width of the confidence interval relative to the mean. */
+    double cpiError() const { return estimate.error(); }
+
+  private:
+    /** Stop the simulation once the first thread of a CPU committed a
+     * number of instructions. */
+    void scheduleStop(BaseCPU *cpu, Counter insts);
+
+    BaseCPU *const fastCPU;
+    BaseCPU *const detailedCPU;
+
+    const Counter period;
+    const Counter warmupInsts;
+    const Counter measureInsts;
+
+    /** Cycles and committed instructions of the detailed CPU at the
+     * start of the current window. */
+    Cycles startCycles;
+    Counter startInsts = 0;
+
+    /** Estimate of the CPI from the measured windows. */
+    MeanEstimator estimate;
+
+    double cpiStdev() const { return estimate.stdev(); }
+
+    struct SamplingStats : public statistics::Group
+    {
+        SamplingStats(SamplingController &sc);
+
+        statistics::Value samples;
+        statistics::Value cpi;
+        statistics::Value cpiStdev;
+        statistics::Value cpiError;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SAMPLING_SAMPLING_CONTROLLER_HH__
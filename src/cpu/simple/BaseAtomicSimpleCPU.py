@@ -61,6 +61,11 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    cache_basic_blocks = Param.Bool(
+        False,
+        "Execute previously decoded basic blocks without fetching and "
+        "decoding their instructions again",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
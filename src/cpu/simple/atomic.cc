@@ -44,6 +44,7 @@
 #include "arch/generic/decoder.hh"
 #include "base/output.hh"
 #include "cpu/exetrace.hh"
+#include "cpu/simple/basic_block.hh"
 #include "cpu/utils.hh"
 #include "debug/Drain.hh"
 #include "debug/ExecFaulting.hh"
@@ -78,16 +79,26 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      cacheBasicBlocks(p.cache_basic_blocks),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
+    fatal_if(cacheBasicBlocks && simulate_inst_stalls,
+             "%s: Cached basic blocks aren't fetched, so icache stalls "
+             "can't be simulated.\n", name());
+    fatal_if(cacheBasicBlocks && branchPred,
+             "%s: Cached basic blocks can't be used with a branch "
+             "predictor.\n", name());
+    if (cacheBasicBlocks)
+        blockCaches.resize(numThreads);
+
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
 }
 
 
@@ -148,6 +159,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have changed behind our back while drained
+    flushBlockCache();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -196,6 +210,8 @@ AtomicSimpleCPU::switchOut()
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isCpuDrained());
+
+    flushBlockCache();
 }
 
 
@@ -250,6 +266,10 @@ AtomicSimpleCPU::suspendContext(ThreadID thread_num)
     assert(thread_num < numThreads);
     activeThreads.remove(thread_num);
 
+    // Stop running a cached block of the thread
+    if (cacheBasicBlocks)
+        blockCaches[thread_num].block = nullptr;
+
     if (_status == Idle)
         return;
 
@@ -298,6 +318,8 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+        static_cast<AtomicSimpleCPU *>(cpu)->checkCodeWrite(
+                pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -325,6 +347,11 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite()) {
+        static_cast<AtomicSimpleCPU *>(cpu)->checkCodeWrite(
+                pkt->getAddr(), pkt->getSize());
+    }
 }
 
 bool
@@ -503,6 +530,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    checkCodeWrite(pkt.getAddr(), pkt.getSize());
                 }
                 dcache_access = true;
                 panic_if(pkt.isError(), "Data write (%s) failed: %s",
@@ -590,6 +618,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            checkCodeWrite(pkt.getAddr(), pkt.getSize());
         }
 
         dcache_access = true;
@@ -629,8 +658,14 @@ AtomicSimpleCPU::tick()
     SimpleThread *thread = t_info.thread;
 
     Tick latency = 0;
+    int extra_cycles = 0;
+
+    for (int i = 0; i < width || locked || inCachedBlock(); ++i) {
+        // The instructions of a cached block that don't fit in the
+        // width of the CPU take extra cycles
+        if (i >= width && !locked && i % width == 0)
+            extra_cycles++;
 
-    for (int i = 0; i < width || locked; ++i) {
         baseStats.numCycles++;
         updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
@@ -652,6 +687,10 @@ AtomicSimpleCPU::tick()
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+        if (needToFetch && cacheBasicBlocks) {
+            cachedInst = nextCachedInst();
+            needToFetch = !cachedInst;
+        }
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
@@ -678,6 +717,7 @@ AtomicSimpleCPU::tick()
             }
 
             preExecute();
+            cachedInst = nullptr;
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -725,14 +765,17 @@ AtomicSimpleCPU::tick()
         }
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
+
+        if (cacheBasicBlocks)
+            recordExecuted(fault);
     }
 
     if (tryCompleteDrain())
         return;
 
     // instruction takes at least one cycle
-    if (latency < clockPeriod())
-        latency = clockPeriod();
+    if (latency < clockPeriod() * (1 + extra_cycles))
+        latency = clockPeriod() * (1 + extra_cycles);
 
     if (_status != Idle)
         reschedule(tickEvent, curTick() + latency, true);
@@ -753,9 +796,229 @@ AtomicSimpleCPU::fetchInstMem()
     panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
             pkt.getAddrRange().to_string(), pkt.print());
 
+    if (cacheBasicBlocks && blockCaches[curThread].recording) {
+        BlockCache &cache = blockCaches[curThread];
+        CachedBlock &block = *cache.recording;
+        const Addr vaddr = ifetch_req->getVaddr();
+        const Addr paddr = ifetch_req->getPaddr();
+
+        // A block must be on a single page, so that translating its
+        // first instruction is enough to check the mapping of all of it
+        if (block.paddr == MaxAddr) {
+            block.vaddr = vaddr;
+            block.paddr = paddr;
+        } else if (vaddr - block.vaddr != paddr - block.paddr ||
+                roundDown(vaddr, BlockPageBytes) !=
+                roundDown(block.vaddr, BlockPageBytes)) {
+            cache.fetchedOutside = true;
+        }
+
+        const Addr line_size = cacheLineSize();
+        for (Addr line = roundDown(paddr, line_size);
+                line < paddr + ifetch_req->getSize(); line += line_size) {
+            cache.fetchedLines.push_back(line);
+        }
+    }
+
     return latency;
 }
 
+StaticInstPtr
+AtomicSimpleCPU::decodeFetched(PCStateBase &pc)
+{
+    if (cachedInst) {
+        pc.update(*cachedInst->decodedPC);
+        return cachedInst->inst;
+    }
+
+    BlockCache *cache =
+        cacheBasicBlocks ? &blockCaches[curThread] : nullptr;
+    if (!cache || !cache->recording)
+        return BaseSimpleCPU::decodeFetched(pc);
+
+    std::unique_ptr<PCStateBase> fetched_pc(pc.clone());
+    StaticInstPtr inst = BaseSimpleCPU::decodeFetched(pc);
+    if (!inst)
+        return inst;
+
+    CachedBlock &block = *cache->recording;
+    auto &decoder = threadInfo[curThread]->thread->decoder;
+    if (cache->fetchedOutside ||
+            decoder->contextGeneration() != block.context) {
+        stopRecording();
+    } else {
+        block.insts.push_back({std::move(fetched_pc),
+                std::unique_ptr<PCStateBase>(pc.clone()), inst});
+        codeLines.insert(cache->fetchedLines.begin(),
+                         cache->fetchedLines.end());
+    }
+    cache->fetchedLines.clear();
+    cache->fetchedOutside = false;
+
+    return inst;
+}
+
+const AtomicSimpleCPU::CachedInst *
+AtomicSimpleCPU::nextCachedInst()
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+    BlockCache &cache = blockCaches[curThread];
+
+    // Instructions split over several fetches continue as they started
+    if (t_info.stayAtPC || t_info.fetchOffset)
+        return nullptr;
+
+    const PCStateBase &pc = thread->pcState();
+    const uint64_t context = thread->decoder->contextGeneration();
+
+    if (cache.block) {
+        const CachedBlock &block = *cache.block;
+        if (cache.next < block.insts.size() && block.context == context &&
+                *block.insts[cache.next].pc == pc) {
+            return &block.insts[cache.next++];
+        }
+        cache.block = nullptr;
+    }
+
+    // Events for instruction counts (e.g., to stop fast-forwarding)
+    // have to happen at the instruction they are for, so a block is only
+    // entered if it ends before the next one
+    const EventQueue &count_events = thread->comInstEventQueue;
+    auto fits = [&](const CachedBlock &block) {
+        return count_events.empty() ||
+            t_info.numInst + block.insts.size() < count_events.nextTick();
+    };
+
+    auto it = cache.blocks.find(pc.instAddr());
+    if (it != cache.blocks.end() && &it->second != cache.recording) {
+        const CachedBlock &block = it->second;
+        if (block.context == context && *block.insts[0].pc == pc &&
+                fits(block)) {
+            // The page of the block has to be mapped as it was
+            ifetch_req->taskId(taskId());
+            setupFetchRequest(ifetch_req);
+            Fault fault = thread->mmu->translateAtomic(
+                    ifetch_req, thread->getTC(), BaseMMU::Execute);
+            if (fault == NoFault && ifetch_req->getPaddr() == block.paddr) {
+                stopRecording();
+                cache.block = &block;
+                cache.next = 1;
+                cache.decoderStale = true;
+                return &block.insts[0];
+            }
+        }
+    }
+
+    // The decoder has to start over after instructions it didn't see
+    if (cache.decoderStale) {
+        thread->decoder->reset();
+        cache.decoderStale = false;
+    }
+
+    // Keep recording the current block if this instruction follows the
+    // last one, or start a new block here
+    if (it != cache.blocks.end() || !cache.recording ||
+            *cache.recordPC != pc) {
+        stopRecording();
+        startRecording(pc);
+    }
+
+    return nullptr;
+}
+
+void
+AtomicSimpleCPU::startRecording(const PCStateBase &pc)
+{
+    BlockCache &cache = blockCaches[curThread];
+    if (cache.blocks.size() >= MaxBlocks)
+        flushBlockCache();
+
+    CachedBlock &block = cache.blocks[pc.instAddr()];
+    block.context = threadInfo[curThread]->thread->decoder->
+        contextGeneration();
+    block.vaddr = MaxAddr;
+    block.paddr = MaxAddr;
+    block.insts.clear();
+
+    cache.recording = &block;
+    cache.recordStart = pc.instAddr();
+    set(cache.recordPC, pc);
+    cache.fetchedLines.clear();
+    cache.fetchedOutside = false;
+}
+
+void
+AtomicSimpleCPU::stopRecording()
+{
+    BlockCache &cache = blockCaches[curThread];
+    if (!cache.recording)
+        return;
+
+    // Blocks without instructions are of no use
+    if (cache.recording->insts.empty())
+        cache.blocks.erase(cache.recordStart);
+    cache.recording = nullptr;
+}
+
+void
+AtomicSimpleCPU::recordExecuted(const Fault &fault)
+{
+    BlockCache &cache = blockCaches[curThread];
+
+    // Whatever has to be seen by the rest of the simulation before the
+    // next instruction runs (e.g., an m5op exiting the simulation or a
+    // suspended thread) also ends the cached block being executed, so
+    // the tick ends there.
+    const bool ends_block = fault != NoFault || _status == Idle ||
+        endsBasicBlock(curStaticInst, curMacroStaticInst);
+    if (ends_block)
+        cache.block = nullptr;
+
+    if (!cache.recording)
+        return;
+
+    const CachedBlock &block = *cache.recording;
+    SimpleThread *thread = threadInfo[curThread]->thread;
+    if (ends_block || block.insts.size() >= MaxBlockInsts ||
+            thread->decoder->contextGeneration() != block.context) {
+        stopRecording();
+    } else if (!curMacroStaticInst && !threadInfo[curThread]->stayAtPC) {
+        set(cache.recordPC, thread->pcState());
+    }
+}
+
+void
+AtomicSimpleCPU::flushBlockCache()
+{
+    for (auto &cache : blockCaches) {
+        cache.blocks.clear();
+        cache.block = nullptr;
+        cache.recording = nullptr;
+        cache.fetchedLines.clear();
+        cache.fetchedOutside = false;
+    }
+    codeLines.clear();
+}
+
+void
+AtomicSimpleCPU::checkCodeWrite(Addr paddr, Addr size)
+{
+    if (codeLines.empty())
+        return;
+
+    const Addr line_size = cacheLineSize();
+    for (Addr line = roundDown(paddr, line_size); line < paddr + size;
+            line += line_size) {
+        if (codeLines.count(line)) {
+            DPRINTF(SimpleCPU, "Write to code at %#x, flushing cached "
+                    "blocks\n", paddr);
+            flushBlockCache();
+            return;
+        }
+    }
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
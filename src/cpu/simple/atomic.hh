@@ -41,6 +41,11 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
@@ -106,6 +111,110 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
     virtual Tick fetchInstMem();
 
+    /**
+     * @{
+     * @name Basic block cache
+     *
+     * With cache_basic_blocks set, the CPU keeps the instructions it
+     * decodes as blocks that end at control, serializing and other
+     * instructions that don't simply fall through (see endsBasicBlock()),
+     * and executes a cached block in one go without fetching or
+     * decoding its instructions again. Entering a block takes a single
+     * instruction TLB lookup, which checks that the block's page is
+     * still mapped to the physical page it was fetched from. An
+     * instruction is only taken from a block if the PC and the decoder
+     * context are the same as when it was decoded. All blocks are
+     * dropped when memory they were fetched from is written, as seen by
+     * the CPU's own stores and by snoops.
+     */
+    struct CachedInst
+    {
+        /** PC state before and after decoding the instruction */
+        std::unique_ptr<PCStateBase> pc;
+        std::unique_ptr<PCStateBase> decodedPC;
+        StaticInstPtr inst;
+    };
+
+    struct CachedBlock
+    {
+        /** Decoder context generation the block was decoded in */
+        uint64_t context = 0;
+        /** Virtual and physical address of the first fetch */
+        Addr vaddr = MaxAddr;
+        Addr paddr = MaxAddr;
+        std::vector<CachedInst> insts;
+    };
+
+    struct BlockCache
+    {
+        /** Blocks by the address of their first instruction */
+        std::unordered_map<Addr, CachedBlock> blocks;
+
+        /** Block being executed and the index of its next instruction */
+        const CachedBlock *block = nullptr;
+        size_t next = 0;
+        /** The decoder hasn't seen the instructions taken from blocks */
+        bool decoderStale = false;
+
+        /** Block being recorded, where it starts, and the PC its next
+         * instruction has */
+        CachedBlock *recording = nullptr;
+        Addr recordStart = 0;
+        std::unique_ptr<PCStateBase> recordPC;
+        /** Lines fetched for the instruction being recorded */
+        std::vector<Addr> fetchedLines;
+        /** The instruction was fetched from outside of the block's page */
+        bool fetchedOutside = false;
+    };
+
+    /** Maximum number of instructions in a block */
+    static constexpr size_t MaxBlockInsts = 64;
+    /** Maximum number of blocks cached per thread */
+    static constexpr size_t MaxBlocks = 1 << 16;
+    /** Blocks may not cross boundaries of this size */
+    static constexpr Addr BlockPageBytes = 4096;
+
+    const bool cacheBasicBlocks;
+    std::vector<BlockCache> blockCaches;
+    /** Physical cache lines the cached blocks were fetched from */
+    std::unordered_set<Addr> codeLines;
+    /** The next decode returns this instruction from a cached block */
+    const CachedInst *cachedInst = nullptr;
+
+    /**
+     * Find the instruction at the current PC in the block cache. If it
+     * isn't there, the instruction is recorded as part of a block.
+     */
+    const CachedInst *nextCachedInst();
+
+    /** Is the CPU executing the instructions of a cached block? */
+    bool
+    inCachedBlock() const
+    {
+        if (!cacheBasicBlocks)
+            return false;
+        const BlockCache &cache = blockCaches[curThread];
+        return cache.block &&
+            (cache.next < cache.block->insts.size() || curMacroStaticInst);
+    }
+
+    void startRecording(const PCStateBase &pc);
+    void stopRecording();
+    /**
+     * Update the blocks being executed and recorded after executing an
+     * instruction. Faults and instructions that end blocks stop both.
+     */
+    void recordExecuted(const Fault &fault);
+
+    /** Drop all cached blocks. */
+    void flushBlockCache();
+
+    /** Drop the cached blocks if a write hits memory they came from. */
+    void checkCodeWrite(Addr paddr, Addr size);
+
+    StaticInstPtr decodeFetched(PCStateBase &pc) override;
+    /** @} */
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
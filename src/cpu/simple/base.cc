@@ -324,6 +324,20 @@ BaseSimpleCPU::serviceInstCountEvents()
     t_info.thread->comInstEventQueue.serviceEvents(t_info.numInst);
 }
 
+StaticInstPtr
+BaseSimpleCPU::decodeFetched(PCStateBase &pc)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    auto &decoder = t_info.thread->decoder;
+
+    //Predecode, ie bundle up an ExtMachInst
+    //If more fetch data is needed, pass it in.
+    Addr fetch_pc = (pc.instAddr() & decoder->pcMask()) + t_info.fetchOffset;
+
+    decoder->moreBytes(pc, fetch_pc);
+    return decoder->decode(pc);
+}
+
 void
 BaseSimpleCPU::preExecute()
 {
@@ -348,16 +362,9 @@ BaseSimpleCPU::preExecute()
         //We're not in the middle of a macro instruction
         StaticInstPtr instPtr = NULL;
 
-        //Predecode, ie bundle up an ExtMachInst
-        //If more fetch data is needed, pass it in.
-        Addr fetch_pc =
-            (pc_state.instAddr() & decoder->pcMask()) + t_info.fetchOffset;
-
-        decoder->moreBytes(pc_state, fetch_pc);
-
         //Decode an instruction if one is ready. Otherwise, we'll have to
         //fetch beyond the MachInst at the current pc.
-        instPtr = decoder->decode(pc_state);
+        instPtr = decodeFetched(pc_state);
         if (instPtr) {
             t_info.stayAtPC = false;
             thread->pcState(pc_state);
@@ -132,6 +132,14 @@ class BaseSimpleCPU : public BaseCPU
 
     std::unique_ptr<PCStateBase> preExecuteTempPC;
 
+    /**
+     * Decode the instruction at a PC from the bytes fetched for it.
+     *
+     * @param pc PC of the instruction, updated by the decoder.
+     * @return The instruction, or nullptr if more bytes are needed.
+     */
+    virtual StaticInstPtr decodeFetched(PCStateBase &pc);
+
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
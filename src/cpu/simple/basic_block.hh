@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_BASIC_BLOCK_HH__
+#define __CPU_SIMPLE_BASIC_BLOCK_HH__
+
+namespace gem5
+{
+
+/**
+ * Whether an instruction is the last one of a basic block cached by the
+ * atomic CPU: it doesn't just go on to the next instruction, or its
+ * effects have to be seen by the rest of the simulation before the next
+ * instruction executes. Both the instruction and the macroop it belongs
+ * to, if any, are checked.
+ *
+ * @tparam InstPtr Pointer to a StaticInst, or to anything with the
+ *                 same predicates
+ * @param inst Instruction (or microop) that was executed
+ * @param macroop Macroop of the instruction, null if there is none
+ * @return True if the block ends with the instruction
+ */
+template <class InstPtr>
+bool
+endsBasicBlock(const InstPtr &inst, const InstPtr &macroop=InstPtr())
+{
+    auto ends_block = [](const InstPtr &i) {
+        return i && (i->isControl() || i->isSyscall() ||
+                i->isSerializing() || i->isSquashAfter() ||
+                i->isNonSpeculative() || i->isQuiesce() ||
+                i->isPseudo() || i->isHtmStart() || i->isHtmStop() ||
+                i->isHtmCancel() || i->isInvalid());
+    };
+    return ends_block(inst) || ends_block(macroop);
+}
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_BASIC_BLOCK_HH__
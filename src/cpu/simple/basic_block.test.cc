@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <bitset>
+#include <initializer_list>
+#include <memory>
+
+#include "cpu/simple/basic_block.hh"
+#include "enums/StaticInstFlags.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An instruction with StaticInst's predicates and the given flags. */
+class FlagInst
+{
+  private:
+    std::bitset<StaticInstFlags::Num_Flags> flags;
+
+  public:
+    FlagInst(std::initializer_list<StaticInstFlags::Flags> inst_flags)
+    {
+        for (auto flag : inst_flags)
+            flags[flag] = true;
+    }
+
+    bool isControl() const { return flags[StaticInstFlags::IsControl]; }
+    bool isSyscall() const { return flags[StaticInstFlags::IsSyscall]; }
+    bool
+    isSerializing() const
+    {
+        return flags[StaticInstFlags::IsSerializing] ||
+            flags[StaticInstFlags::IsSerializeBefore] ||
+            flags[StaticInstFlags::IsSerializeAfter];
+    }
+    bool
+    isSquashAfter() const
+    {
+        return flags[StaticInstFlags::IsSquashAfter];
+    }
+    bool
+    isNonSpeculative() const
+    {
+        return flags[StaticInstFlags::IsNonSpeculative];
+    }
+    bool isQuiesce() const { return flags[StaticInstFlags::IsQuiesce]; }
+    bool isPseudo() const { return flags[StaticInstFlags::IsPseudo]; }
+    bool isHtmStart() const { return flags[StaticInstFlags::IsHtmStart]; }
+    bool isHtmStop() const { return flags[StaticInstFlags::IsHtmStop]; }
+    bool isHtmCancel() const { return flags[StaticInstFlags::IsHtmCancel]; }
+    bool isInvalid() const { return flags[StaticInstFlags::IsInvalid]; }
+};
+
+using FlagInstPtr = std::shared_ptr<FlagInst>;
+
+FlagInstPtr
+makeInst(std::initializer_list<StaticInstFlags::Flags> inst_flags)
+{
+    return std::make_shared<FlagInst>(inst_flags);
+}
+
+} // anonymous namespace
+
+/** Instructions that just go on to the next one don't end a block. */
+TEST(BasicBlockTest, FallThrough)
+{
+    EXPECT_FALSE(endsBasicBlock(FlagInstPtr()));
+    EXPECT_FALSE(endsBasicBlock(makeInst({})));
+    EXPECT_FALSE(endsBasicBlock(makeInst({StaticInstFlags::IsInteger})));
+    EXPECT_FALSE(endsBasicBlock(makeInst({StaticInstFlags::IsLoad})));
+    EXPECT_FALSE(endsBasicBlock(makeInst({StaticInstFlags::IsStore})));
+    EXPECT_FALSE(endsBasicBlock(makeInst({StaticInstFlags::IsMicroop}),
+                                makeInst({StaticInstFlags::IsMacroop})));
+}
+
+/**
+ * Instructions whose effects have to be seen before the next one runs,
+ * e.g., m5ops, syscalls and serializing instructions, end a block.
+ */
+TEST(BasicBlockTest, EndsBlock)
+{
+    for (auto flag : { StaticInstFlags::IsControl,
+                       StaticInstFlags::IsSyscall,
+                       StaticInstFlags::IsSerializing,
+                       StaticInstFlags::IsSerializeBefore,
+                       StaticInstFlags::IsSerializeAfter,
+                       StaticInstFlags::IsSquashAfter,
+                       StaticInstFlags::IsNonSpeculative,
+                       StaticInstFlags::IsQuiesce,
+                       StaticInstFlags::IsPseudo,
+                       StaticInstFlags::IsHtmStart,
+                       StaticInstFlags::IsHtmStop,
+                       StaticInstFlags::IsHtmCancel,
+                       StaticInstFlags::IsInvalid }) {
+        EXPECT_TRUE(endsBasicBlock(makeInst({flag}))) << "flag " << flag;
+        EXPECT_TRUE(endsBasicBlock(
+            makeInst({StaticInstFlags::IsInteger, flag}))) << "flag " << flag;
+    }
+}
+
+/**
+ * A microop ends a block if its macroop does, e.g., every microop of a
+ * serializing macroop, or if it does itself.
+ */
+TEST(BasicBlockTest, Macroop)
+{
+    const FlagInstPtr serializing = makeInst(
+        {StaticInstFlags::IsMacroop, StaticInstFlags::IsSerializing});
+    EXPECT_TRUE(endsBasicBlock(makeInst({StaticInstFlags::IsMicroop}),
+                               serializing));
+
+    const FlagInstPtr plain = makeInst({StaticInstFlags::IsMacroop});
+    EXPECT_TRUE(endsBasicBlock(
+        makeInst({StaticInstFlags::IsMicroop,
+                  StaticInstFlags::IsNonSpeculative}), plain));
+}
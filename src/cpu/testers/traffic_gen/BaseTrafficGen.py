@@ -86,6 +86,13 @@ class BaseTrafficGen(ClockedObject):
         "1ms", "Time before exiting due to lack of progress"
     )
 
+    # Read protobuf traces ahead in a helper thread per trace. This
+    # offloads the decompression from the simulation thread at the cost
+    # of one host thread per trace generator.
+    prefetch_traces = Param.Bool(
+        False, "Read protobuf traces in a helper thread"
+    )
+
     # Generator type used for applying Stream and/or Substream IDs to requests
     stream_gen = Param.StreamGenType(
         "none", "Generator for adding Stream and/or Substream ID's to requests"
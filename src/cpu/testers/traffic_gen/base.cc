@@ -72,6 +72,7 @@ BaseTrafficGen::BaseTrafficGen(const BaseTrafficGenParams &p)
       system(p.system),
       elasticReq(p.elastic_req),
       progressCheck(p.progress_check),
+      prefetchTraces(p.prefetch_traces),
       noProgressEvent([this]{ noProgress(); }, name()),
       nextTransitionTick(0),
       nextPacketTick(0),
@@ -549,7 +550,8 @@ BaseTrafficGen::createTrace(Tick duration,
 {
 #if HAVE_PROTOBUF
     return std::shared_ptr<BaseGen>(
-        new TraceGen(*this, requestorId, duration, trace_file, addr_offset));
+        new TraceGen(*this, requestorId, duration, trace_file, addr_offset,
+                     prefetchTraces));
 #else
     panic("Can't instantiate trace generation without Protobuf support!\n");
 #endif
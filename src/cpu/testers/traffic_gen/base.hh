@@ -87,6 +87,9 @@ class BaseTrafficGen : public ClockedObject
      */
     const Tick progressCheck;
 
+    /** Read protobuf traces ahead in a helper thread. */
+    const bool prefetchTraces;
+
   private:
     /**
      * Receive a retry from the neighbouring port and attempt to
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/packet_records.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+const char recordMagic[8] = {'g', 'e', 'm', '5', 'p', 'r', 'e', 'c'};
+
+} // anonymous namespace
+
+bool
+PacketRecordTrace::isRecordTrace(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(recordMagic)];
+    return file.read(magic, sizeof(magic)) &&
+        std::memcmp(magic, recordMagic, sizeof(magic)) == 0;
+}
+
+PacketRecordTrace::PacketRecordTrace(const std::string &filename)
+    : fileName(filename), data(nullptr), dataSize(0), numRecords(0),
+      recordSize(0)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        panic("Could not open %s for reading (errno: %i)\n", filename, errno);
+
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+        panic("Could not stat %s (errno: %i)\n", filename, errno);
+    dataSize = st.st_size;
+
+    if (dataSize < sizeof(Header))
+        panic("Record trace %s is truncated\n", filename);
+
+    data = (uint8_t *)mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        panic("Could not map %s (errno: %i)\n", filename, errno);
+
+    // The records are normally replayed from the start to the end
+    madvise(data, dataSize, MADV_SEQUENTIAL);
+
+    const Header *header = (const Header *)data;
+    if (std::memcmp(header->magic, recordMagic, sizeof(recordMagic)))
+        panic("%s is not a record trace\n", filename);
+    if (letoh(header->version) != version)
+        panic("Record trace %s has unsupported version %d\n", filename,
+              letoh(header->version));
+
+    numRecords = letoh(header->numRecords);
+    recordSize = letoh(header->recordSize);
+    if (recordSize < sizeof(Record))
+        panic("Record trace %s has records of %d bytes, expected %d\n",
+              filename, recordSize, sizeof(Record));
+    if ((dataSize - sizeof(Header)) / recordSize < numRecords)
+        panic("Record trace %s is truncated\n", filename);
+}
+
+PacketRecordTrace::~PacketRecordTrace()
+{
+    if (data)
+        munmap(data, dataSize);
+}
+
+uint64_t
+PacketRecordTrace::tickFreq() const
+{
+    return letoh(((const Header *)data)->tickFreq);
+}
+
+PacketRecordTrace::Record
+PacketRecordTrace::get(size_t idx) const
+{
+    assert(idx < numRecords);
+
+    Record rec;
+    std::memcpy(&rec, data + sizeof(Header) + idx * recordSize,
+                sizeof(rec));
+    rec.tick = letoh(rec.tick);
+    rec.addr = letoh(rec.addr);
+    rec.pktId = letoh(rec.pktId);
+    rec.pc = letoh(rec.pc);
+    rec.size = letoh(rec.size);
+    rec.cmd = letoh(rec.cmd);
+    rec.valid = letoh(rec.valid);
+    rec.flags = letoh(rec.flags);
+    return rec;
+}
+
+} // namespace gem5
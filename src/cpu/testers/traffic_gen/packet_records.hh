@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_PACKET_RECORDS_HH__
+#define __CPU_TRAFFIC_GEN_PACKET_RECORDS_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gem5
+{
+
+/**
+ * An uncompressed packet trace made of fixed size records.
+ *
+ * The file starts with a Header, followed by numRecords records of
+ * recordSize bytes, all stored in little endian. Unlike protobuf packet
+ * traces, nothing needs to be decoded to find a record, so the file is
+ * simply mapped into memory and the records are read in place. Traces
+ * can be converted from the protobuf format using
+ * util/packet_trace_to_records.py.
+ */
+class PacketRecordTrace
+{
+  public:
+    struct Header
+    {
+        /** The magic string "gem5prec" */
+        char magic[8];
+        uint32_t version;
+        /** Size of a record, for future extensions of the record */
+        uint32_t recordSize;
+        uint64_t tickFreq;
+        uint64_t numRecords;
+    };
+
+    /** Bits of Record::valid telling which optional fields are set */
+    enum : uint16_t
+    {
+        HasFlags = 0x1,
+        HasPktId = 0x2,
+        HasPc = 0x4,
+    };
+
+    struct Record
+    {
+        uint64_t tick;
+        uint64_t addr;
+        uint64_t pktId;
+        uint64_t pc;
+        uint32_t size;
+        uint16_t cmd;
+        uint16_t valid;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 32, "Unexpected header layout");
+    static_assert(sizeof(Record) == 48, "Unexpected record layout");
+
+    static constexpr uint32_t version = 1;
+
+    /**
+     * Check if a file is a record trace by looking at its magic string.
+     *
+     * @param filename Path to the file
+     * @return True if the file is a record trace
+     */
+    static bool isRecordTrace(const std::string &filename);
+
+    /**
+     * Map a record trace into memory.
+     *
+     * @param filename Path to the file
+     */
+    PacketRecordTrace(const std::string &filename);
+    ~PacketRecordTrace();
+
+    PacketRecordTrace(const PacketRecordTrace &) = delete;
+    PacketRecordTrace &operator=(const PacketRecordTrace &) = delete;
+
+    /** Tick frequency the trace was recorded with. */
+    uint64_t tickFreq() const;
+
+    /** Number of records in the trace. */
+    size_t size() const { return numRecords; }
+
+    /**
+     * Get a record, converted to the host byte order.
+     *
+     * @param idx Index of the record
+     * @return A copy of the record
+     */
+    Record get(size_t idx) const;
+
+  private:
+    const std::string fileName;
+
+    /** The mapped file */
+    uint8_t *data;
+    size_t dataSize;
+
+    size_t numRecords;
+    size_t recordSize;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRAFFIC_GEN_PACKET_RECORDS_HH__
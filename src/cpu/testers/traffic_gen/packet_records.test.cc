@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cpu/testers/traffic_gen/packet_records.hh"
+#include "sim/byteswap.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+using Header = PacketRecordTrace::Header;
+using Record = PacketRecordTrace::Record;
+
+class PacketRecordsTest : public testing::Test
+{
+  protected:
+    void
+    SetUp() override
+    {
+        fileName = testing::TempDir() + "packet_records_test";
+    }
+
+    void TearDown() override { std::remove(fileName.c_str()); }
+
+    /** A header for a number of records of a given size. */
+    static Header
+    makeHeader(uint64_t num_records, uint32_t record_size=sizeof(Record))
+    {
+        Header header;
+        std::memcpy(header.magic, "gem5prec", sizeof(header.magic));
+        header.version = htole(PacketRecordTrace::version);
+        header.recordSize = htole(record_size);
+        header.tickFreq = htole<uint64_t>(1000000000000ULL);
+        header.numRecords = htole(num_records);
+        return header;
+    }
+
+    /** A record with distinct values in all its fields. */
+    static Record
+    makeRecord(uint64_t i)
+    {
+        Record rec;
+        std::memset(&rec, 0, sizeof(rec));
+        rec.tick = htole(1000 * i);
+        rec.addr = htole(0x100000000ULL + 64 * i);
+        rec.pktId = htole(i);
+        rec.pc = htole(0x400000 + 4 * i);
+        rec.size = htole<uint32_t>(64);
+        rec.cmd = htole<uint16_t>(i % 2 ? 1 : 4);
+        rec.valid = htole<uint16_t>(i % 2 ? PacketRecordTrace::HasFlags : 0);
+        rec.flags = htole<uint32_t>(i % 2 ? 0x10 : 0);
+        return rec;
+    }
+
+    /**
+     * Write a trace, padding every record to the record size of the
+     * header and dropping a number of bytes at the end.
+     */
+    void
+    writeTrace(const Header &header, uint64_t num_records, size_t cut=0)
+    {
+        std::string data(reinterpret_cast<const char *>(&header),
+                         sizeof(header));
+        const size_t record_size = letoh(header.recordSize);
+        for (uint64_t i = 0; i < num_records; i++) {
+            const Record rec = makeRecord(i);
+            std::string padded(record_size, '\0');
+            std::memcpy(&padded[0], &rec,
+                        std::min(sizeof(rec), record_size));
+            data += padded;
+        }
+        data.resize(data.size() - cut);
+
+        std::ofstream file(fileName, std::ios::out | std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    void
+    expectRecords(const PacketRecordTrace &trace, uint64_t num_records)
+    {
+        ASSERT_EQ(trace.size(), num_records);
+        for (uint64_t i = 0; i < num_records; i++) {
+            const Record rec = trace.get(i);
+            EXPECT_EQ(rec.tick, 1000 * i);
+            EXPECT_EQ(rec.addr, 0x100000000ULL + 64 * i);
+            EXPECT_EQ(rec.pktId, i);
+            EXPECT_EQ(rec.pc, 0x400000 + 4 * i);
+            EXPECT_EQ(rec.size, 64u);
+            EXPECT_EQ(rec.cmd, i % 2 ? 1u : 4u);
+            EXPECT_EQ(rec.valid, i % 2 ? PacketRecordTrace::HasFlags : 0u);
+            EXPECT_EQ(rec.flags, i % 2 ? 0x10u : 0u);
+        }
+    }
+
+    std::string fileName;
+};
+
+} // anonymous namespace
+
+TEST_F(PacketRecordsTest, ReadRecords)
+{
+    writeTrace(makeHeader(100), 100);
+    ASSERT_TRUE(PacketRecordTrace::isRecordTrace(fileName));
+
+    PacketRecordTrace trace(fileName);
+    EXPECT_EQ(trace.tickFreq(), 1000000000000ULL);
+    expectRecords(trace, 100);
+}
+
+TEST_F(PacketRecordsTest, Empty)
+{
+    writeTrace(makeHeader(0), 0);
+    PacketRecordTrace trace(fileName);
+    EXPECT_EQ(trace.size(), 0u);
+}
+
+/** Records may grow in later versions, the known fields are still read. */
+TEST_F(PacketRecordsTest, LargerRecords)
+{
+    writeTrace(makeHeader(10, sizeof(Record) + 16), 10);
+    PacketRecordTrace trace(fileName);
+    expectRecords(trace, 10);
+}
+
+TEST_F(PacketRecordsTest, NotARecordTrace)
+{
+    EXPECT_FALSE(PacketRecordTrace::isRecordTrace(fileName));
+
+    // A protobuf trace starts with the magic number "gem5" only
+    std::ofstream(fileName, std::ios::out | std::ios::binary) << "gem5";
+    EXPECT_FALSE(PacketRecordTrace::isRecordTrace(fileName));
+    EXPECT_ANY_THROW(PacketRecordTrace trace(fileName));
+
+    Header header = makeHeader(1);
+    header.magic[7] = 'x';
+    writeTrace(header, 1);
+    EXPECT_FALSE(PacketRecordTrace::isRecordTrace(fileName));
+    EXPECT_ANY_THROW(PacketRecordTrace trace(fileName));
+}
+
+TEST_F(PacketRecordsTest, Truncated)
+{
+    writeTrace(makeHeader(10), 10, 1);
+    EXPECT_ANY_THROW(PacketRecordTrace trace(fileName));
+
+    writeTrace(makeHeader(10), 0, 1);
+    EXPECT_ANY_THROW(PacketRecordTrace trace(fileName));
+}
+
+TEST_F(PacketRecordsTest, BadHeader)
+{
+    Header header = makeHeader(1);
+    header.version = htole(PacketRecordTrace::version + 1);
+    writeTrace(header, 1);
+    EXPECT_ANY_THROW(PacketRecordTrace trace(fileName));
+
+    writeTrace(makeHeader(1, sizeof(Record) - 8), 1);
+    EXPECT_ANY_THROW(PacketRecordTrace trace(fileName));
+}
@@ -49,18 +49,32 @@
 namespace gem5
 {
 
-TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceGen::InputStream::InputStream(const std::string& filename,
+                                   bool prefetch)
+    : nextRecord(0)
 {
+    if (PacketRecordTrace::isRecordTrace(filename))
+        records.reset(new PacketRecordTrace(filename));
+    else
+        trace.reset(new ProtoInputStream(filename, prefetch));
     init();
 }
 
 void
 TraceGen::InputStream::init()
 {
+    if (records) {
+        nextRecord = 0;
+        if (records->tickFreq() != sim_clock::Frequency) {
+            panic("Trace was recorded with a different tick frequency %d\n",
+                  records->tickFreq());
+        }
+        return;
+    }
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!trace->read(header_msg)) {
         panic("Failed to read packet header from trace\n");
     } else if (header_msg.tick_freq() != sim_clock::Frequency) {
         panic("Trace was recorded with a different tick frequency %d\n",
@@ -71,15 +85,30 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
-    trace.reset();
+    if (trace)
+        trace->reset();
     init();
 }
 
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
+    if (records) {
+        if (nextRecord == records->size())
+            return false;
+
+        const auto rec = records->get(nextRecord++);
+        element.cmd = MemCmd::Command(rec.cmd);
+        element.addr = rec.addr;
+        element.blocksize = rec.size;
+        element.tick = rec.tick;
+        element.flags = (rec.valid & PacketRecordTrace::HasFlags) ?
+            rec.flags : 0;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (trace->read(pkt_msg)) {
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
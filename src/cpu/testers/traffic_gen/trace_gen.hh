@@ -44,9 +44,12 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <memory>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
+#include "cpu/testers/traffic_gen/packet_records.hh"
 #include "mem/packet.hh"
 #include "proto/protoio.hh"
 
@@ -104,15 +107,22 @@ class TraceGen : public BaseGen
     /**
      * The InputStream encapsulates a trace file and the
      * internal buffers and populates TraceElements based on
-     * the input.
+     * the input. The trace is either a protobuf packet trace, or an
+     * uncompressed trace of fixed size records.
      */
     class InputStream
     {
 
       private:
 
-        /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+        /// Input file stream for a protobuf trace
+        std::unique_ptr<ProtoInputStream> trace;
+
+        /// Mapped trace if the file contains fixed size records
+        std::unique_ptr<PacketRecordTrace> records;
+
+        /// Index of the next record to read
+        size_t nextRecord;
 
       public:
 
@@ -120,8 +130,9 @@ class TraceGen : public BaseGen
          * Create a trace input stream for a given file name.
          *
          * @param filename Path to the file to read from
+         * @param prefetch Read a protobuf trace in a helper thread
          */
-        InputStream(const std::string& filename);
+        InputStream(const std::string& filename, bool prefetch);
 
         /**
          * Reset the stream such that it can be played once
@@ -156,11 +167,13 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param prefetch Read a protobuf trace in a helper thread
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             bool prefetch=false)
         : BaseGen(obj, requestor_id, _duration),
-          trace(trace_file),
+          trace(trace_file, prefetch),
           tickOffset(0),
           addrOffset(addr_offset),
           traceComplete(false)
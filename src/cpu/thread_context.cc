@@ -163,6 +163,15 @@ ThreadContext::sendFunctional(PacketPtr pkt)
     port->sendFunctional(pkt);
 }
 
+void
+ThreadContext::sendMemBackdoorReq(const MemBackdoorReq &req,
+                                  MemBackdoorPtr &backdoor)
+{
+    auto *port = dynamic_cast<RequestPort *>(&getCpuPtr()->getDataPort());
+    assert(port);
+    port->sendMemBackdoorReq(req, backdoor);
+}
+
 void
 ThreadContext::quiesce()
 {
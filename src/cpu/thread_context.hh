@@ -63,6 +63,9 @@ class BaseTLB;
 class CheckerCPU;
 class Checkpoint;
 class InstDecoder;
+class MemBackdoor;
+using MemBackdoorPtr = MemBackdoor *;
+class MemBackdoorReq;
 class PortProxy;
 class Process;
 class System;
@@ -144,6 +147,13 @@ class ThreadContext : public PCEventScope
 
     virtual void sendFunctional(PacketPtr pkt);
 
+    /**
+     * Request a back door to physical memory through this thread's data
+     * port. The back door is left untouched if none is available.
+     */
+    virtual void sendMemBackdoorReq(const MemBackdoorReq &req,
+                                    MemBackdoorPtr &backdoor);
+
     virtual Process *getProcessPtr() = 0;
 
     virtual void setProcessPtr(Process *p) = 0;
@@ -67,6 +67,11 @@ class TraceCPU(ClockedObject):
     sizeLoadBuffer = Param.Unsigned(16, "Number of entries in the load buffer")
     sizeROB = Param.Unsigned(40, "Number of entries in the re-order buffer")
 
+    # Read the traces ahead in a helper thread per trace. This offloads
+    # the decompression from the simulation thread at the cost of two
+    # host threads per Trace CPU.
+    prefetchTraces = Param.Bool(False, "Read the traces in helper threads")
+
     # Frequency multiplier used to effectively scale the Trace CPU frequency
     # either up or down. Note that the Trace CPU's clock domain must also be
     # changed when frequency is scaled. A default value of 1.0 means the same
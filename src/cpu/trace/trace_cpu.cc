@@ -56,7 +56,8 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         dataRequestorID(params.system->getRequestorId(this, "data")),
         instTraceFile(params.instTraceFile),
         dataTraceFile(params.dataTraceFile),
-        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
+        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile,
+                  params.prefetchTraces),
         dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
                   params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
@@ -593,7 +594,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -1084,7 +1085,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, requestorId);
+    auto req = Request::create(addr, size, flags, requestorId);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -1203,8 +1204,9 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
-    trace(filename),
+        const std::string& filename, const double time_multiplier,
+        bool prefetch) :
+    trace(filename, prefetch),
     timeMultiplier(time_multiplier),
     microOpCount(0)
 {
@@ -1386,8 +1388,9 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
     return Record::RecordType_Name(type);
 }
 
-TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceCPU::FixedRetryGen::InputStream::InputStream(
+        const std::string& filename, bool prefetch)
+    : trace(filename, prefetch)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
@@ -367,8 +367,9 @@ class TraceCPU : public ClockedObject
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
+             * @param prefetch Read the trace in a helper thread
              */
-            InputStream(const std::string& filename);
+            InputStream(const std::string& filename, bool prefetch);
 
             /**
              * Reset the stream such that it can be played once
@@ -391,11 +392,11 @@ class TraceCPU : public ClockedObject
         /* Constructor */
         FixedRetryGen(TraceCPU& _owner, const std::string& _name,
                    RequestPort& _port, RequestorID requestor_id,
-                   const std::string& trace_file) :
+                   const std::string& trace_file, bool prefetch) :
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file),
+            trace(trace_file, prefetch),
             genName(owner.name() + ".fixedretry." + _name),
             retryPkt(nullptr),
             delta(0),
@@ -772,9 +773,10 @@ class TraceCPU : public ClockedObject
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param prefetch Read the trace in a helper thread
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier, bool prefetch);
 
             /**
              * Reset the stream such that it can be played once
@@ -809,7 +811,8 @@ class TraceCPU : public ClockedObject
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.prefetchTraces),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
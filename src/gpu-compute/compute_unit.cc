@@ -1362,7 +1362,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
     // Fences will never be issued to system memory, so we can mark the
     // requestor as a device memory ID here.
     if (!req) {
-        req = std::make_shared<Request>(
+        req = Request::create(
             0, 0, 0, vramRequestorId(), 0, gpuDynInst->wfDynId);
     } else {
         req->requestorId(vramRequestorId());
@@ -1436,7 +1436,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
 void
 ComputeUnit::sendInvL2(Addr paddr)
 {
-    auto req = std::make_shared<Request>(paddr, 64, 0, vramRequestorId());
+    auto req = Request::create(paddr, 64, 0, vramRequestorId());
     req->setCacheCoherenceFlags(Request::GL2_CACHE_INV);
 
     auto pkt = new Packet(req, MemCmd::MemSyncReq);
@@ -1643,7 +1643,7 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
             if (!stride)
                 break;
 
-            RequestPtr prefetch_req = std::make_shared<Request>(
+            RequestPtr prefetch_req = Request::create(
                 vaddr + stride * pf * X86ISA::PageBytes,
                 sizeof(uint8_t), 0,
                 computeUnit->requestorId(),
@@ -2188,7 +2188,7 @@ ComputeUnit::sendToLds(GPUDynInstPtr gpuDynInst)
 {
     // this is just a request to carry the GPUDynInstPtr
     // back and forth
-    RequestPtr newRequest = std::make_shared<Request>();
+    RequestPtr newRequest = Request::create();
     newRequest->setPaddr(0x0);
 
     // ReadReq is not evaluted by the LDS but the Packet ctor requires this
@@ -162,7 +162,7 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
             computeUnit.cu_id, wavefront->simdId, wavefront->wfSlotId, vaddr);
 
     // set up virtual request
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         vaddr, computeUnit.cacheLineSize(), Request::INST_FETCH,
         computeUnit.requestorId(), 0, 0, nullptr);
 
@@ -168,7 +168,7 @@ ScalarMemPipeline::injectScalarMemFence(GPUDynInstPtr gpuDynInst,
     assert(gpuDynInst->isScalar());
 
     if (!req) {
-        req = std::make_shared<Request>(
+        req = Request::create(
                 0, 0, 0, computeUnit.requestorId(), 0, gpuDynInst->wfDynId);
     } else {
         req->requestorId(computeUnit.requestorId());
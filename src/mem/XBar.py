@@ -151,8 +151,21 @@ class SnoopFilter(SimObject):
 
     system = Param.System(Parent.any, "System that the crossbar belongs to.")
 
-    # Sanity check on max capacity to track, adjust if needed.
+    # Sanity check on max capacity to track, adjust if needed. With a
+    # non-zero associativity this is instead the capacity of a bounded,
+    # set-associative tracking array, and lines evicted from it are
+    # back-invalidated in the caches above.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
+    assoc = Param.Unsigned(
+        0, "Associativity of the snoop filter, 0 for an unbounded filter"
+    )
+
+    # Number of snooping ports sharing one bit of the sharer vectors, 1
+    # tracks each port precisely. Coarser vectors allow more ports to be
+    # tracked, at the cost of extra snoops.
+    sharer_group_size = Param.Unsigned(
+        1, "Snooping ports tracked by each sharer vector bit"
+    )
 
 
 # We use a coherent crossbar to connect multiple requestors to the L2
@@ -249,7 +249,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -641,6 +641,15 @@ BaseCache::recvAtomic(PacketPtr pkt)
     // writebacks... that would mean that someone used an atomic
     // access in timing mode
 
+    // a block allocated while warming has no data yet, fetch it
+    // before the block is used to satisfy anything
+    if (warmedBlocks) {
+        CacheBlk *warmed_blk = tags->findBlock(pkt->getAddr(),
+                                               pkt->isSecure());
+        if (warmed_blk && warmed_blk->wasWarmed())
+            fillWarmedBlock(warmed_blk);
+    }
+
     // We use lookupLatency here because it is used to specify the latency
     // to access.
     Cycles lat = lookupLatency;
@@ -732,7 +741,7 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
     // we have it, but only declare it satisfied if we are the owner.
 
     // see if we have data at all (owned or otherwise)
-    bool have_data = blk && blk->isValid()
+    bool have_data = blk && blk->isValid() && !blk->wasWarmed()
         && pkt->trySatisfyFunctional(&cbpw, blk_addr, is_secure, blkSize,
                                      blk->data);
 
@@ -1714,7 +1723,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1757,7 +1766,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1831,7 +1840,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -1861,6 +1870,108 @@ BaseCache::invalidateVisitor(CacheBlk &blk)
     }
 }
 
+void
+BaseCache::startWarming()
+{
+    if (warming)
+        return;
+
+    DPRINTF(Cache, "Start warming\n");
+    memWriteback();
+    memInvalidate();
+    warming = true;
+    warmedBlocks = true;
+}
+
+void
+BaseCache::stopWarming()
+{
+    if (!warming)
+        return;
+
+    DPRINTF(Cache, "Stop warming\n");
+    warming = false;
+    tags->forEachBlk([this](CacheBlk &blk) {
+        if (blk.isValid() && blk.wasWarmed())
+            fillWarmedBlock(&blk);
+    });
+    warmedBlocks = false;
+}
+
+bool
+BaseCache::warmAccess(Addr addr, bool is_secure, RequestorID id)
+{
+    assert(warming);
+
+    RequestPtr req = Request::create(addr & ~Addr(blkSize - 1), blkSize,
+                                     0, id);
+    if (is_secure)
+        req->setFlags(Request::SECURE);
+    Packet pkt(req, MemCmd::ReadReq);
+
+    Cycles lat;
+    if (tags->accessBlock(&pkt, lat)) {
+        stats.warmingHits++;
+        return true;
+    }
+    stats.warmingMisses++;
+
+    const auto partition_id = partitionManager ?
+        partitionManager->readPacketPartitionID(&pkt) : 0;
+    std::vector<CacheBlk*> evict_blks;
+    CacheBlk *victim = tags->findVictim(pkt.getAddr(), is_secure,
+                                        blkSize * 8, evict_blks,
+                                        partition_id);
+    if (!victim)
+        return false;
+
+    // Everything was written back when warming started, so the
+    // victims are clean and can be dropped without telling anyone
+    for (auto &blk : evict_blks) {
+        if (blk->isValid()) {
+            assert(!blk->isSet(CacheBlk::DirtyBit));
+            stats.replacements++;
+            invalidateBlock(blk);
+        }
+    }
+
+    tags->insertBlock(&pkt, victim);
+    if (compressor)
+        compressor->setSizeBits(victim, blkSize * 8);
+    victim->setCoherenceBits(CacheBlk::ReadableBit);
+    victim->setWarmed();
+
+    return false;
+}
+
+void
+BaseCache::fillWarmedBlock(CacheBlk *blk)
+{
+    assert(blk->wasWarmed());
+
+    RequestPtr req = Request::create(
+        regenerateBlkAddr(blk), blkSize, 0, blk->getSrcRequestorId());
+    if (blk->isSecure())
+        req->setFlags(Request::SECURE);
+    req->taskId(blk->getTaskId());
+
+    Packet pkt(req, isReadOnly ? MemCmd::ReadCleanReq :
+               MemCmd::ReadSharedReq);
+    pkt.allocate();
+
+    // The block stays in the tags while the request is outstanding so
+    // that it is filled in place and keeps its replacement state
+    blk->clearWarmed();
+    blk->clearCoherenceBits(CacheBlk::ReadableBit);
+    memSidePort.sendAtomic(&pkt);
+    assert(pkt.isResponse());
+
+    PacketList writebacks;
+    handleFill(&pkt, blk, writebacks, true);
+    assert(writebacks.empty());
+    blk->setWhenReady(curTick());
+}
+
 Tick
 BaseCache::nextQueueReadyTime() const
 {
@@ -2284,6 +2395,10 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "average overall mshr uncacheable latency"),
     ADD_STAT(replacements, statistics::units::Count::get(),
              "number of replacements"),
+    ADD_STAT(warmingHits, statistics::units::Count::get(),
+             "number of tag-only warming accesses that hit"),
+    ADD_STAT(warmingMisses, statistics::units::Count::get(),
+             "number of tag-only warming accesses that missed"),
     ADD_STAT(dataExpansions, statistics::units::Count::get(),
              "number of data expansions"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
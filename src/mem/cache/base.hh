@@ -982,6 +982,12 @@ class BaseCache : public ClockedObject
     /** The number of misses to trigger an exit event. */
     Counter missCount;
 
+    /** Whether the cache is in warming mode. @sa startWarming */
+    bool warming = false;
+
+    /** Whether any block may still be waiting for its warming fill. */
+    bool warmedBlocks = false;
+
     /**
      * The address range to which the cache responds on the CPU side.
      * Normally this is all possible memory addresses. */
@@ -1139,6 +1145,12 @@ class BaseCache : public ClockedObject
         /** Number of replacements of valid blocks. */
         statistics::Scalar replacements;
 
+        /** Number of tag-only accesses in warming mode that hit. */
+        statistics::Scalar warmingHits;
+
+        /** Number of tag-only accesses in warming mode that missed. */
+        statistics::Scalar warmingMisses;
+
         /** Number of data expansions. */
         statistics::Scalar dataExpansions;
 
@@ -1326,6 +1338,46 @@ class BaseCache : public ClockedObject
      */
     bool coalesce() const;
 
+    /**
+     * Put the cache in warming mode.
+     *
+     * In warming mode the cache is bypassed by the CPUs (see
+     * System::bypassCaches()) and only its tags and replacement state
+     * are updated, by calls to warmAccess(). Dirty data is written back
+     * and all blocks are invalidated when warming starts, so memory
+     * holds the only copy of the data while the tags are warmed.
+     */
+    void startWarming();
+
+    /**
+     * Leave warming mode and fill the data of all blocks allocated
+     * while warming.
+     *
+     * The data is fetched using atomic read requests so that the
+     * caches and snoop filters below see regular fills. Caches below
+     * that are still warming fill their own copy first, so the caches
+     * can be stopped in any order. This has to be called once the
+     * system has left the cache bypass mode and before any timing
+     * requests reach the cache.
+     */
+    void stopWarming();
+
+    /** @return True if the cache is in warming mode. */
+    bool isWarming() const { return warming; }
+
+    /**
+     * Update the tags and replacement state for an access to a block,
+     * as if it was a demand access, without moving any data. A miss
+     * allocates the block and silently drops any victims.
+     *
+     * @param addr Address of the access.
+     * @param is_secure Whether the access is to the secure space.
+     * @param id Requestor of the access.
+     * @return True if the block was present, in which case caches
+     * further away from the requestor would not have seen the access.
+     */
+    bool warmAccess(Addr addr, bool is_secure, RequestorID id);
+
 
     /**
      * Cache block visitor that writes back dirty cache blocks using
@@ -1340,6 +1392,13 @@ class BaseCache : public ClockedObject
      */
     void invalidateVisitor(CacheBlk &blk);
 
+    /**
+     * Fetch the data of a block allocated while warming.
+     *
+     * @param blk The warmed block to fill.
+     */
+    void fillWarmedBlock(CacheBlk *blk);
+
     /**
      * Take an MSHR, turn it into a suitable downstream packet, and
      * send it out. This construct allows a queue entry to choose a suitable
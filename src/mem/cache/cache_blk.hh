@@ -182,6 +182,9 @@ class CacheBlk : public TaggedEntry
         if (other.wasPrefetched()) {
             setPrefetched();
         }
+        if (other.wasWarmed()) {
+            setWarmed();
+        }
         setCoherenceBits(other.coherence);
         setTaskId(other.getTaskId());
         setPartitionId(other.getPartitionId());
@@ -204,6 +207,7 @@ class CacheBlk : public TaggedEntry
         TaggedEntry::invalidate();
 
         clearPrefetched();
+        clearWarmed();
         clearCoherenceBits(AllBits);
 
         setTaskId(context_switch_task_id::Unknown);
@@ -260,6 +264,19 @@ class CacheBlk : public TaggedEntry
     /** Marks this blocks as a recently prefetched block. */
     void setPrefetched() { _prefetched = true; }
 
+    /**
+     * Check if this block was allocated by cache warming, i.e., only its
+     * tag is valid and its data has yet to be fetched.
+     * @return True if the block holds no data.
+     */
+    bool wasWarmed() const { return _warmed; }
+
+    /** Clear the warming bit once the data has been filled in. */
+    void clearWarmed() { _warmed = false; }
+
+    /** Marks this block as allocated by cache warming. */
+    void setWarmed() { _warmed = true; }
+
     /**
      * Get tick at which block's data will be available for access.
      *
@@ -407,9 +424,9 @@ class CacheBlk : public TaggedEntry
           default:    s = 'T'; break; // @TODO add other types
         }
         return csprintf("state: %x (%c) writable: %d readable: %d "
-            "dirty: %d prefetched: %d | %s", coherence, s,
+            "dirty: %d prefetched: %d warmed: %d | %s", coherence, s,
             isSet(WritableBit), isSet(ReadableBit), isSet(DirtyBit),
-            wasPrefetched(), TaggedEntry::print());
+            wasPrefetched(), wasWarmed(), TaggedEntry::print());
     }
 
     /**
@@ -506,6 +523,9 @@ class CacheBlk : public TaggedEntry
 
     /** Whether this block is an unaccessed hardware prefetch. */
     bool _prefetched = 0;
+
+    /** Whether this block was allocated by warming and holds no data. */
+    bool _warmed = false;
 };
 
 /**
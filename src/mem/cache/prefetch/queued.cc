@@ -60,7 +60,7 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
+    RequestPtr req = Request::create(paddr, blk_size,
                                                 0, requestor_id);
 
     if (pfInfo.isSecure()) {
@@ -377,7 +377,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -62,6 +62,11 @@ CoherentXBar::CoherentXBar(const CoherentXBarParams &p)
       maxRoutingTableSizeCheck(p.max_routing_table_size),
       pointOfCoherency(p.point_of_coherency),
       pointOfUnification(p.point_of_unification),
+      backInvRequestorId(p.snoop_filter && p.snoop_filter->isBounded() ?
+          p.system->getRequestorId(this, "back_invalidate") :
+          Request::invldRequestorId),
+      backInvRetryEvent([this]{ retryBackInvalidated(); },
+                        name() + ".backInvRetry"),
 
       ADD_STAT(snoops, statistics::units::Count::get(), "Total snoops"),
       ADD_STAT(snoopTraffic, statistics::units::Byte::get(), "Total snoop traffic"),
@@ -141,8 +146,14 @@ CoherentXBar::init()
 
     // inform the snoop filter about the CPU-side ports so it can create
     // its own internal representation
-    if (snoopFilter)
+    if (snoopFilter) {
         snoopFilter->setCPUSidePorts(cpuSidePorts);
+        snoopFilter->setBackInvalidate(
+            [this](Addr addr, bool is_secure,
+                   const SnoopFilter::SnoopList &ports) {
+                backInvalidate(addr, is_secure, ports);
+            });
+    }
 }
 
 bool
@@ -158,6 +169,19 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     // and the cache responding flag should always be the same
     assert(is_express_snoop == cache_responding);
 
+    // hold back requests for lines that are still being written back
+    // after a back-invalidation, as they would see stale data below
+    if (!is_express_snoop && !backInvPending.empty()) {
+        auto pending = backInvPending.find(
+            backInvLine(pkt->getAddr(), pkt->isSecure()));
+        if (pending != backInvPending.end()) {
+            DPRINTF(CoherentXBar, "%s: src %s packet %s WRITEBACK PENDING\n",
+                    __func__, src_port->name(), pkt->print());
+            pending->second.push_back(cpu_side_port_id);
+            return false;
+        }
+    }
+
     // determine the destination based on the destination address range
     PortID mem_side_port_id = findPort(pkt);
 
@@ -569,6 +593,29 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
 bool
 CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
 {
+    // responses to our own back-invalidations end here, only a bounded
+    // snoop filter evicts lines
+    if (snoopFilter && snoopFilter->isBounded() &&
+        pkt->req->requestorId() == backInvRequestorId) {
+        DPRINTF(CoherentXBar, "%s: back-invalidation response %s\n",
+                __func__, pkt->print());
+        writebackInvalidated(pkt);
+
+        // the line is up to date below, let the requests for it that
+        // were held back try again
+        auto pending = backInvPending.find(
+            backInvLine(pkt->getAddr(), pkt->isSecure()));
+        assert(pending != backInvPending.end());
+        backInvRetries.insert(backInvRetries.end(), pending->second.begin(),
+                              pending->second.end());
+        backInvPending.erase(pending);
+        if (!backInvRetries.empty() && !backInvRetryEvent.scheduled())
+            schedule(backInvRetryEvent, clockEdge());
+
+        delete pkt;
+        return true;
+    }
+
     // determine the source port based on the id
     ResponsePort* src_port = cpuSidePorts[cpu_side_port_id];
 
@@ -997,10 +1044,96 @@ CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     return std::make_pair(snoop_response_cmd, snoop_response_latency);
 }
 
+void
+CoherentXBar::backInvalidate(Addr addr, bool is_secure,
+                             const std::vector<QueuedResponsePort*> &ports)
+{
+    // when bypassing caches they have all been flushed already
+    if (system->bypassCaches())
+        return;
+
+    DPRINTF(CoherentXBar, "%s: addr %#x secure %d ports %d\n", __func__,
+            addr, is_secure, ports.size());
+
+    // a read exclusive snoop makes every holder drop the line, and the
+    // owner, if any, respond with the data
+    RequestPtr req = Request::create(
+        addr, system->cacheLineSize(),
+        is_secure ? Request::SECURE : 0, backInvRequestorId);
+    PacketPtr pkt = new Packet(req, MemCmd::ReadExReq);
+    pkt->allocate();
+
+    const MemCmd orig_cmd = pkt->cmd;
+    for (const auto& p: ports) {
+        if (system->isTimingMode()) {
+            // any response comes back through recvTimingSnoopResp
+            p->sendTimingSnoopReq(pkt);
+        } else {
+            p->sendAtomicSnoop(pkt);
+            if (pkt->isResponse()) {
+                assert(pkt->cacheResponding());
+                writebackInvalidated(pkt);
+                pkt->cmd = orig_cmd;
+            }
+        }
+    }
+
+    // in timing mode a dirty owner sends the data later, until then
+    // the memory below is stale, so hold back any requests for the
+    // line
+    if (system->isTimingMode() && pkt->cacheResponding()) {
+        DPRINTF(CoherentXBar, "%s: addr %#x waiting for writeback\n",
+                __func__, addr);
+        backInvPending.emplace(backInvLine(addr, is_secure),
+                               std::vector<PortID>());
+    }
+
+    snoops += ports.size();
+    snoopFanout.sample(ports.size());
+
+    // the caches copy the snoop if they need to hold on to it
+    delete pkt;
+}
+
+void
+CoherentXBar::writebackInvalidated(PacketPtr pkt)
+{
+    RequestPtr req = Request::create(
+        pkt->getAddr(), pkt->getSize(), pkt->req->getFlags(),
+        backInvRequestorId);
+    Packet wb_pkt(req, MemCmd::WriteReq);
+    wb_pkt.dataStaticConst(pkt->getConstPtr<uint8_t>());
+    memSidePorts[findPort(wb_pkt.getAddrRange())]->sendFunctional(&wb_pkt);
+}
+
+void
+CoherentXBar::retryBackInvalidated()
+{
+    std::vector<PortID> ports;
+    std::swap(ports, backInvRetries);
+    for (PortID id : ports) {
+        DPRINTF(CoherentXBar, "%s: retrying %s\n", __func__,
+                cpuSidePorts[id]->name());
+        cpuSidePorts[id]->sendRetryReq();
+    }
+}
+
 void
 CoherentXBar::recvMemBackdoorReq(const MemBackdoorReq &req,
         MemBackdoorPtr &backdoor)
 {
+    // A back door bypasses any packets in flight as well as the caches
+    // above us, so only hand one out in atomic mode and if none of the
+    // caches can be holding a line in the requested range.
+    const bool may_be_cached = !snoopPorts.empty() &&
+        !system->bypassCaches() &&
+        (!snoopFilter || snoopFilter->isCached(req.range()));
+    if (!system->isAtomicMode() || may_be_cached) {
+        DPRINTF(CoherentXBar, "%s: refusing back door to %s\n", __func__,
+                req.range().to_string());
+        return;
+    }
+
     PortID dest_id = findPort(req.range());
     memSidePorts[dest_id]->sendMemBackdoorReq(req, backdoor);
 }
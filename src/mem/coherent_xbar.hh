@@ -48,6 +48,7 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "mem/snoop_filter.hh"
 #include "mem/xbar.hh"
@@ -299,6 +300,34 @@ class CoherentXBar : public BaseXBar
     /** Is this crossbar the point of unification? **/
     const bool pointOfUnification;
 
+    /**
+     * Requestor id for back-invalidations of snoop filter evictions,
+     * invalid unless the snoop filter is bounded
+     */
+    const RequestorID backInvRequestorId;
+
+    /**
+     * Lines whose back-invalidation is waiting for the data of a dirty
+     * copy, with the CPU-side ports that have been refused a request
+     * for the line meanwhile. The lines include the secure bit, see
+     * backInvLine().
+     */
+    std::unordered_map<Addr, std::vector<PortID>> backInvPending;
+
+    /** CPU-side ports to retry, as their lines have been written back */
+    std::vector<PortID> backInvRetries;
+
+    /** Event that sends the retries in backInvRetries */
+    EventFunctionWrapper backInvRetryEvent;
+
+    /** Key of a line in backInvPending */
+    Addr
+    backInvLine(Addr addr, bool is_secure) const
+    {
+        return (addr & ~Addr(system->cacheLineSize() - 1)) |
+            (is_secure ? 1 : 0);
+    }
+
     /**
      * Upstream caches need this packet until true is returned, so
      * hold it for deletion until a subsequent call
@@ -400,6 +429,32 @@ class CoherentXBar : public BaseXBar
      */
     void forwardFunctional(PacketPtr pkt, PortID exclude_cpu_side_port_id);
 
+    /**
+     * Remove a line evicted from the snoop filter from the caches
+     * above, by sending them an invalidating snoop. A dirty copy is
+     * written back to the memory below.
+     *
+     * @param addr Line address
+     * @param is_secure Whether the line is in the secure address space
+     * @param ports The CPU-side ports that may hold the line
+     */
+    void backInvalidate(Addr addr, bool is_secure,
+                        const std::vector<QueuedResponsePort*> &ports);
+
+    /**
+     * Write back the data of a back-invalidated dirty line. This is done
+     * functionally, without modelling its timing.
+     *
+     * @param pkt The snoop response carrying the data
+     */
+    void writebackInvalidated(PacketPtr pkt);
+
+    /**
+     * Let the CPU-side ports whose requests were held back by a
+     * back-invalidation try again.
+     */
+    void retryBackInvalidated();
+
     /**
      * Determine if the crossbar should sink the packet, as opposed to
      * forwarding it, or responding.
@@ -46,6 +46,7 @@
 #include "debug/DRAM.hh"
 #include "debug/DRAMPower.hh"
 #include "debug/DRAMState.hh"
+#include "mem/frfcfs.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -59,116 +60,17 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
+    const FRFCFSBanks banks{*this};
+    const auto selected = chooseFRFCFS(queue, min_col_at, banks);
 
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
-
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
-
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
-
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
-                }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
-            }
-        }
-    }
+#ifdef GEM5_DEBUG
+    gem5_assert(selected == chooseFRFCFSScan(queue, min_col_at, banks),
+                "Indexed FR-FCFS selection differs from a queue walk");
+#endif
 
-    if (selected_pkt_it == queue.end()) {
+    if (selected.first == queue.end())
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
-    }
-
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    return selected;
 }
 
 void
@@ -508,32 +410,26 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         bool got_bank_conflict = false;
 
         for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
+            // look for other packets to the bank in the queue, including
+            // any non-DRAM packets of this pseudo channel
             // 1) if a hit is found, then both open and close adaptive
             //    policies keep the page open
             // 2) if no hit is found, got_bank_conflict is set to true if a
             //    bank conflict request is waiting in the queue
             // 3) make sure we are not considering the packet that we are
             //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-
-                if ((*p)->pseudoChannel != pseudoChannel) {
-                    // only consider if this pkt belongs to this interface
-                    ++p;
+            for (bool dram : { true, false }) {
+                const MemPacketQueue::BankQueue* bank_queue =
+                    queue[i].bank(dram, pseudoChannel, mem_pkt->rank,
+                                  mem_pkt->bank);
+                if (!bank_queue)
                     continue;
-                }
-
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
 
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
-                }
-                ++p;
+                size_t hits = bank_queue->hits(mem_pkt->row);
+                got_bank_conflict |= bank_queue->packets.size() > hits;
+                if (dram == mem_pkt->isDram() && i == mem_pkt->qosValue())
+                    --hits;
+                got_more_hits |= hits > 0;
             }
 
             if (got_more_hits)
@@ -1041,7 +937,10 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
+    for (const auto& entry : queue.banks()) {
+        if (entry.second.packets.empty())
+            continue;
+        const MemPacket* p = entry.second.packets.front();
         if (p->pseudoChannel != pseudoChannel)
             continue;
         if (p->isDram() && ranks[p->rank]->inRefIdleState())
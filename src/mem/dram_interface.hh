@@ -649,6 +649,39 @@ class DRAMInterface : public MemInterface
     std::pair<std::vector<uint32_t>, bool>
     minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
 
+    /** The state of the banks, as needed by chooseFRFCFS() */
+    struct FRFCFSBanks
+    {
+        const DRAMInterface &dram;
+
+        bool
+        accepts(MemPacket *pkt) const
+        {
+            return pkt->isDram() && pkt->pseudoChannel == dram.pseudoChannel;
+        }
+
+        bool ready(MemPacket *pkt) const { return dram.burstReady(pkt); }
+
+        uint32_t
+        openRow(MemPacket *pkt) const
+        {
+            return dram.ranks[pkt->rank]->banks[pkt->bank].openRow;
+        }
+
+        Tick
+        colAllowedAt(MemPacket *pkt) const
+        {
+            const Bank &bank = dram.ranks[pkt->rank]->banks[pkt->bank];
+            return pkt->isRead() ? bank.rdAllowedAt : bank.wrAllowedAt;
+        }
+
+        std::pair<std::vector<uint32_t>, bool>
+        minBankPrep(const MemPacketQueue &queue, Tick min_col_at) const
+        {
+            return dram.minBankPrep(queue, min_col_at);
+        }
+    };
+
     /*
      * @return time to send a burst of data without gaps
      */
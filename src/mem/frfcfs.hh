@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2010-2020 ARM Limited
+ * All rights reserved
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2013 Amin Farmahini-Farahani
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * First-ready, first-come first-serve (FR-FCFS) selection of the next
+ * DRAM burst from a queue of memory packets
+ */
+
+#ifndef __MEM_FRFCFS_HH__
+#define __MEM_FRFCFS_HH__
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+#include "mem/mem_packet.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * Pick the next packet to issue from a queue, in order of preference:
+ * 1) the oldest row hit that can issue seamlessly,
+ * 2) the oldest row hit that is prepped but cannot issue seamlessly, or
+ *    the oldest packet to a closed row in one of the earliest available
+ *    banks, preferring the latter if the bank can be prepared without
+ *    incurring additional bus delay.
+ *
+ * Rather than walking the queue, this looks at the oldest row hit and
+ * the oldest row miss of each bank, and picks the same packet as
+ * chooseFRFCFSScan().
+ *
+ * The state of the banks is provided by a Banks object with the
+ * following const members:
+ * - bool accepts(MemPacket *pkt), whether the packet is for the banks,
+ *   this has to be the same for all the packets to a bank
+ * - bool ready(MemPacket *pkt), whether the rank of the packet is
+ *   available
+ * - uint32_t openRow(MemPacket *pkt), the open row of its bank
+ * - Tick colAllowedAt(MemPacket *pkt), when the bank allows the packet's
+ *   column command
+ * - std::pair<std::vector<uint32_t>, bool>
+ *   minBankPrep(const MemPacketQueue &queue, Tick min_col_at), a mask
+ *   of the earliest banks to prepare per rank, and whether they can be
+ *   prepared without delaying the data bus
+ *
+ * @param queue Queued requests to consider
+ * @param min_col_at Minimum tick for 'seamless' issue
+ * @param banks State of the banks
+ * @return an iterator to the selected packet, else queue.end()
+ * @return the tick when the packet selected will issue
+ */
+template <class Banks>
+std::pair<MemPacketQueue::iterator, Tick>
+chooseFRFCFS(MemPacketQueue &queue, Tick min_col_at, const Banks &banks)
+{
+    MemPacket* seamless_hit = nullptr;
+    MemPacket* prepped_hit = nullptr;
+    MemPacket* earliest_miss = nullptr;
+
+    std::vector<uint32_t> earliest_banks;
+    // Has minBankPrep been called to populate earliest_banks?
+    bool filled_earliest_banks = false;
+    // can the PRE/ACT sequence be done without impacting utlization?
+    bool hidden_bank_prep = false;
+
+    auto older = [](const MemPacket* pkt, const MemPacket* than) {
+        return !than || pkt->seqNum < than->seqNum;
+    };
+
+    for (const auto& entry : queue.banks()) {
+        const MemPacketQueue::BankQueue& bank_queue = entry.second;
+        if (bank_queue.packets.empty())
+            continue;
+
+        // check if rank is not doing a refresh and thus is available,
+        // if not, skip all packets to the bank
+        MemPacket* first = bank_queue.packets.front();
+        if (!banks.accepts(first) || !banks.ready(first))
+            continue;
+
+        const uint32_t open_row = banks.openRow(first);
+
+        if (MemPacket* hit = bank_queue.oldestHit(open_row)) {
+            if (banks.colAllowedAt(hit) <= min_col_at &&
+                older(hit, seamless_hit)) {
+                seamless_hit = hit;
+            }
+            if (older(hit, prepped_hit))
+                prepped_hit = hit;
+        }
+
+        MemPacket* miss = bank_queue.oldestMiss(open_row);
+        if (miss && !seamless_hit) {
+            // if we have not initialised the bank status, do it
+            // now, and only once per scheduling decisions
+            if (!filled_earliest_banks) {
+                // determine entries with earliest bank delay
+                std::tie(earliest_banks, hidden_bank_prep) =
+                    banks.minBankPrep(queue, min_col_at);
+                filled_earliest_banks = true;
+            }
+
+            // bank is amongst first available banks
+            if (bits(earliest_banks[miss->rank], miss->bank, miss->bank) &&
+                older(miss, earliest_miss)) {
+                earliest_miss = miss;
+            }
+        }
+    }
+
+    MemPacket* selected = seamless_hit;
+    if (!selected) {
+        if (earliest_miss && (hidden_bank_prep || !prepped_hit)) {
+            // give priority to packets that can issue bank commands
+            // 'behind the scenes'
+            selected = earliest_miss;
+        } else {
+            selected = prepped_hit;
+        }
+    }
+
+    if (!selected)
+        return std::make_pair(queue.end(), MaxTick);
+    return std::make_pair(queue.find(selected),
+                          banks.colAllowedAt(selected));
+}
+
+/**
+ * Reference implementation of chooseFRFCFS() that walks the whole
+ * queue rather than using its bank and row index.
+ */
+template <class Banks>
+std::pair<MemPacketQueue::iterator, Tick>
+chooseFRFCFSScan(MemPacketQueue &queue, Tick min_col_at, const Banks &banks)
+{
+    std::vector<uint32_t> earliest_banks;
+
+    // Has minBankPrep been called to populate earliest_banks?
+    bool filled_earliest_banks = false;
+    // can the PRE/ACT sequence be done without impacting utlization?
+    bool hidden_bank_prep = false;
+
+    // search for seamless row hits first, if no seamless row hit is
+    // found then determine if there are other packets that can be issued
+    // without incurring additional bus delay due to bank timing
+    // Will select closed rows first to enable more open row possibilies
+    // in future selections
+    bool found_hidden_bank = false;
+
+    // remember if we found a row hit, not seamless, but bank prepped
+    // and ready
+    bool found_prepped_pkt = false;
+
+    // if we have no row hit, prepped or not, and no seamless packet,
+    // just go for the earliest possible
+    bool found_earliest_pkt = false;
+
+    Tick selected_col_at = MaxTick;
+    auto selected_pkt_it = queue.end();
+
+    for (auto i = queue.begin(); i != queue.end() ; ++i) {
+        MemPacket* pkt = *i;
+
+        // select optimal DRAM packet in Q, if the rank is not doing a
+        // refresh and thus is available, if not, jump to the next packet
+        if (!banks.accepts(pkt) || !banks.ready(pkt))
+            continue;
+
+        const Tick col_allowed_at = banks.colAllowedAt(pkt);
+
+        // check if it is a row hit
+        if (banks.openRow(pkt) == pkt->row) {
+            // no additional rank-to-rank or same bank-group
+            // delays, or we switched read/write and might as well
+            // go for the row hit
+            if (col_allowed_at <= min_col_at) {
+                // FCFS within the hits, giving priority to
+                // commands that can issue seamlessly, without
+                // additional delay, such as same rank accesses
+                // and/or different bank-group accesses
+                selected_pkt_it = i;
+                selected_col_at = col_allowed_at;
+                // no need to look through the remaining queue entries
+                break;
+            } else if (!found_hidden_bank && !found_prepped_pkt) {
+                // if we did not find a packet to a closed row that can
+                // issue the bank commands without incurring delay, and
+                // did not yet find a packet to a prepped row, remember
+                // the current one
+                selected_pkt_it = i;
+                selected_col_at = col_allowed_at;
+                found_prepped_pkt = true;
+            }
+        } else if (!found_earliest_pkt) {
+            // if we have not initialised the bank status, do it
+            // now, and only once per scheduling decisions
+            if (!filled_earliest_banks) {
+                // determine entries with earliest bank delay
+                std::tie(earliest_banks, hidden_bank_prep) =
+                    banks.minBankPrep(queue, min_col_at);
+                filled_earliest_banks = true;
+            }
+
+            // bank is amongst first available banks
+            // minBankPrep will give priority to packets that can
+            // issue seamlessly
+            if (bits(earliest_banks[pkt->rank], pkt->bank, pkt->bank)) {
+                found_earliest_pkt = true;
+                found_hidden_bank = hidden_bank_prep;
+
+                // give priority to packets that can issue
+                // bank commands 'behind the scenes'
+                // any additional delay if any will be due to
+                // col-to-col command requirements
+                if (hidden_bank_prep || !found_prepped_pkt) {
+                    selected_pkt_it = i;
+                    selected_col_at = col_allowed_at;
+                }
+            }
+        }
+    }
+
+    return std::make_pair(selected_pkt_it, selected_col_at);
+}
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_FRFCFS_HH__
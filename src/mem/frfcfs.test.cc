@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/frfcfs.hh"
+#include "mem/mem_packet.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+const unsigned numRanks = 2;
+const unsigned numBanks = 8;
+const unsigned numRows = 4;
+const uint32_t noRow = -1;
+
+/** Bank state for chooseFRFCFS(), set up by the tests. */
+struct FakeBanks
+{
+    struct Bank
+    {
+        uint32_t openRow = noRow;
+        Tick rdAllowedAt = 0;
+        Tick wrAllowedAt = 0;
+    };
+
+    Bank banks[numRanks][numBanks];
+    bool rankReady[numRanks] = {true, true};
+    std::vector<uint32_t> earliestBanks =
+        std::vector<uint32_t>(numRanks, 0);
+    bool hiddenBankPrep = false;
+
+    bool
+    accepts(MemPacket *pkt) const
+    {
+        return pkt->isDram() && pkt->pseudoChannel == 0;
+    }
+
+    bool ready(MemPacket *pkt) const { return rankReady[pkt->rank]; }
+
+    uint32_t
+    openRow(MemPacket *pkt) const
+    {
+        return banks[pkt->rank][pkt->bank].openRow;
+    }
+
+    Tick
+    colAllowedAt(MemPacket *pkt) const
+    {
+        const Bank &bank = banks[pkt->rank][pkt->bank];
+        return pkt->isRead() ? bank.rdAllowedAt : bank.wrAllowedAt;
+    }
+
+    std::pair<std::vector<uint32_t>, bool>
+    minBankPrep(const MemPacketQueue &queue, Tick min_col_at) const
+    {
+        return std::make_pair(earliestBanks, hiddenBankPrep);
+    }
+};
+
+/** Creates memory packets, and keeps them and their packets alive. */
+class PacketFactory
+{
+  public:
+    MemPacket *
+    create(bool read, bool dram, uint8_t channel, uint8_t rank,
+           uint8_t bank, uint32_t row)
+    {
+        RequestPtr req = std::make_shared<Request>(0, 64, 0, 0);
+        packets.emplace_back(std::make_unique<Packet>(req,
+            read ? MemCmd::ReadReq : MemCmd::WriteReq));
+        memPackets.emplace_back(std::make_unique<MemPacket>(
+            packets.back().get(), read, dram, channel, rank, bank, row,
+            rank * numBanks + bank, 0, 64));
+        return memPackets.back().get();
+    }
+
+  private:
+    std::vector<std::unique_ptr<Packet>> packets;
+    std::vector<std::unique_ptr<MemPacket>> memPackets;
+};
+
+/** Check the bank and row index of a queue against its arrival order. */
+void
+checkIndex(MemPacketQueue &queue)
+{
+    size_t indexed = 0;
+    for (const auto &entry : queue.banks()) {
+        const auto &bank_queue = entry.second;
+        indexed += bank_queue.packets.size();
+
+        std::vector<MemPacket *> expected;
+        for (auto pkt : queue) {
+            if (!bank_queue.packets.empty() &&
+                pkt->isDram() == bank_queue.packets[0]->isDram() &&
+                pkt->pseudoChannel ==
+                    bank_queue.packets[0]->pseudoChannel &&
+                pkt->rank == bank_queue.packets[0]->rank &&
+                pkt->bank == bank_queue.packets[0]->bank) {
+                expected.push_back(pkt);
+            }
+        }
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                               bank_queue.packets.begin(),
+                               bank_queue.packets.end()));
+
+        size_t in_rows = 0;
+        for (const auto &row : bank_queue.rows) {
+            ASSERT_FALSE(row.second.empty());
+            in_rows += row.second.size();
+            ASSERT_EQ(bank_queue.hits(row.first), row.second.size());
+            std::vector<MemPacket *> row_expected;
+            for (auto pkt : bank_queue.packets) {
+                if (pkt->row == row.first)
+                    row_expected.push_back(pkt);
+            }
+            ASSERT_TRUE(std::equal(row_expected.begin(), row_expected.end(),
+                                   row.second.begin(), row.second.end()));
+        }
+        ASSERT_EQ(in_rows, bank_queue.packets.size());
+    }
+    ASSERT_EQ(indexed, queue.size());
+
+    for (auto it = queue.begin(); it != queue.end(); ++it)
+        ASSERT_EQ(queue.find(*it), it);
+}
+
+/**
+ * Randomly queue packets, change the bank state and take packets out of
+ * the queue, checking that the indexed selection always matches the
+ * queue walk.
+ */
+void
+randomSelections(bool read, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    auto random = [&rng](unsigned n) { return unsigned(rng() % n); };
+
+    PacketFactory factory;
+    MemPacketQueue queue;
+    FakeBanks banks;
+    unsigned selections = 0;
+
+    for (int step = 0; step < 5000; step++) {
+        // keep the queue at a few dozen packets on average
+        if (random(64) >= queue.size()) {
+            queue.push_back(factory.create(read, random(10) != 0,
+                                           random(8) == 0, random(numRanks),
+                                           random(numBanks),
+                                           random(numRows)));
+        } else if (random(4) == 0) {
+            // requests leave out of order, e.g., when merged
+            auto it = queue.begin();
+            std::advance(it, random(queue.size()));
+            queue.erase(it);
+        }
+
+        if (random(3) == 0) {
+            for (auto &rank : banks.banks) {
+                for (auto &bank : rank) {
+                    bank.openRow = random(numRows + 1) == numRows ?
+                        noRow : random(numRows);
+                    bank.rdAllowedAt = random(20);
+                    bank.wrAllowedAt = random(20);
+                }
+            }
+            for (unsigned rank = 0; rank < numRanks; rank++) {
+                banks.rankReady[rank] = random(5) != 0;
+                banks.earliestBanks[rank] = random(1 << numBanks);
+            }
+            banks.hiddenBankPrep = random(2);
+        }
+
+        const Tick min_col_at = random(20);
+        const auto selected = chooseFRFCFS(queue, min_col_at, banks);
+        const auto expected = chooseFRFCFSScan(queue, min_col_at, banks);
+        ASSERT_TRUE(selected == expected) << "step " << step;
+
+        // issue the selected packet now and then
+        if (selected.first != queue.end() && random(2) == 0) {
+            queue.erase(selected.first);
+            selections++;
+        }
+
+        checkIndex(queue);
+        if (testing::Test::HasFatalFailure())
+            return;
+    }
+
+    // make sure the test actually exercised the scheduler
+    EXPECT_GT(selections, 500U);
+}
+
+} // anonymous namespace
+
+/** The queue keeps its index in sync when packets come and go. */
+TEST(MemPacketQueueTest, Index)
+{
+    PacketFactory factory;
+    MemPacketQueue queue;
+    std::vector<MemPacket *> pkts;
+    for (unsigned i = 0; i < 12; i++) {
+        pkts.push_back(factory.create(true, true, 0, i % 2, i % 3, i % 4));
+        queue.push_back(pkts.back());
+    }
+    checkIndex(queue);
+
+    const auto *bank = queue.bank(true, 0, 0, 0);
+    ASSERT_NE(bank, nullptr);
+    EXPECT_EQ(bank->packets.size(), 2U);
+    EXPECT_EQ(bank->oldestHit(0), pkts[0]);
+    EXPECT_EQ(bank->oldestHit(1), nullptr);
+    EXPECT_EQ(bank->oldestMiss(0), pkts[6]);
+    EXPECT_EQ(queue.bank(false, 0, 0, 0), nullptr);
+
+    queue.erase(queue.find(pkts[0]));
+    queue.erase(queue.find(pkts[11]));
+    checkIndex(queue);
+    EXPECT_EQ(queue.find(pkts[0]), queue.end());
+    EXPECT_EQ(bank->oldestHit(0), nullptr);
+    EXPECT_EQ(bank->oldestMiss(0), pkts[6]);
+
+    queue.erase(queue.find(pkts[6]));
+    EXPECT_EQ(queue.bank(true, 0, 0, 0), nullptr);
+
+    // a later packet to an emptied bank starts a new row list
+    pkts.push_back(factory.create(true, true, 0, 0, 0, 0));
+    queue.push_back(pkts.back());
+    checkIndex(queue);
+    EXPECT_EQ(queue.bank(true, 0, 0, 0)->oldestHit(0), pkts.back());
+}
+
+/** Seamless row hits win over older packets, oldest first. */
+TEST(FRFCFSTest, SeamlessHit)
+{
+    PacketFactory factory;
+    MemPacketQueue queue;
+    FakeBanks banks;
+    banks.banks[0][0].openRow = 1;
+    banks.banks[0][1].openRow = 2;
+    banks.banks[0][1].rdAllowedAt = 100;
+    banks.banks[1][0].openRow = 3;
+
+    queue.push_back(factory.create(true, true, 0, 0, 0, 0));
+    queue.push_back(factory.create(true, true, 0, 0, 1, 2));
+    MemPacket *hit = factory.create(true, true, 0, 1, 0, 3);
+    queue.push_back(hit);
+    queue.push_back(factory.create(true, true, 0, 0, 0, 1));
+
+    auto selected = chooseFRFCFS(queue, 10, banks);
+    ASSERT_NE(selected.first, queue.end());
+    EXPECT_EQ(*selected.first, hit);
+    EXPECT_EQ(selected.second, Tick(0));
+    EXPECT_TRUE(selected == chooseFRFCFSScan(queue, 10, banks));
+
+    // nothing is selected while the ranks are refreshing
+    banks.rankReady[0] = banks.rankReady[1] = false;
+    selected = chooseFRFCFS(queue, 10, banks);
+    EXPECT_EQ(selected.first, queue.end());
+    EXPECT_EQ(selected.second, MaxTick);
+}
+
+/**
+ * Without seamless hits, a miss to one of the earliest banks is only
+ * preferred over a prepped row hit if it can be prepared behind the
+ * scenes.
+ */
+TEST(FRFCFSTest, HiddenBankPrep)
+{
+    PacketFactory factory;
+    MemPacketQueue queue;
+    FakeBanks banks;
+    banks.banks[0][0].openRow = 1;
+    banks.banks[0][0].rdAllowedAt = 100;
+    banks.earliestBanks[1] = 1 << 2;
+
+    MemPacket *hit = factory.create(true, true, 0, 0, 0, 1);
+    queue.push_back(hit);
+    MemPacket *miss = factory.create(true, true, 0, 1, 2, 0);
+    queue.push_back(miss);
+
+    EXPECT_EQ(*chooseFRFCFS(queue, 10, banks).first, hit);
+    banks.hiddenBankPrep = true;
+    EXPECT_EQ(*chooseFRFCFS(queue, 10, banks).first, miss);
+    EXPECT_TRUE(chooseFRFCFS(queue, 10, banks) ==
+                chooseFRFCFSScan(queue, 10, banks));
+}
+
+TEST(FRFCFSTest, RandomReads)
+{
+    for (unsigned seed = 1; seed <= 10; seed++)
+        randomSelections(true, seed);
+}
+
+TEST(FRFCFSTest, RandomWrites)
+{
+    for (unsigned seed = 1; seed <= 10; seed++)
+        randomSelections(false, seed);
+}
@@ -94,7 +94,7 @@ class HeteroMemCtrl : public MemCtrl
     pktSizeCheck(MemPacket* mem_pkt, MemInterface* mem_intr) const override;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req) override;
 
@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -219,27 +221,24 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
         // the controller
         bool foundInWrQ = false;
         Addr burst_addr = burstAlign(addr, mem_intr);
-        // if the burst address is not present then there is no need
-        // looking any further
-        if (isInWriteQueue.find(burst_addr) != isInWriteQueue.end()) {
-            for (const auto& vec : writeQueue) {
-                for (const auto& p : vec) {
-                    // check if the read is subsumed in the write queue
-                    // packet we are looking at
-                    if (p->addr <= addr &&
-                       ((addr + size) <= (p->addr + p->size))) {
-
-                        foundInWrQ = true;
-                        stats.servicedByWrQ++;
-                        pktsServicedByWrQ++;
-                        DPRINTF(MemCtrl,
-                                "Read to addr %#x with size %d serviced by "
-                                "write queue\n",
-                                addr, size);
-                        stats.bytesReadWrQ += burst_size;
-                        break;
-                    }
-                }
+        // the write queue holds at most one packet per burst address,
+        // so only that one can hold the data
+        auto wr_pkt = isInWriteQueue.find(burst_addr);
+        if (wr_pkt != isInWriteQueue.end()) {
+            const MemPacket *p = wr_pkt->second;
+            // check if the read is subsumed in the write queue
+            // packet we are looking at
+            if (p->addr <= addr &&
+               ((addr + size) <= (p->addr + p->size))) {
+
+                foundInWrQ = true;
+                stats.servicedByWrQ++;
+                pktsServicedByWrQ++;
+                DPRINTF(MemCtrl,
+                        "Read to addr %#x with size %d serviced by "
+                        "write queue\n",
+                        addr, size);
+                stats.bytesReadWrQ += burst_size;
             }
         }
 
@@ -344,7 +343,7 @@ MemCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
             DPRINTF(MemCtrl, "Adding to write queue\n");
 
             writeQueue[mem_pkt->qosValue()].push_back(mem_pkt);
-            isInWriteQueue.insert(burstAlign(addr, mem_intr));
+            isInWriteQueue.emplace(burstAlign(addr, mem_intr), mem_pkt);
 
             // log packet
             logRequest(MemCtrl::WRITE, pkt->requestorId(),
@@ -486,7 +485,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -879,7 +878,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -48,13 +48,14 @@
 
 #include <deque>
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "base/callback.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
+#include "mem/mem_packet.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
 #include "params/MemCtrl.hh"
@@ -70,156 +71,6 @@ class MemInterface;
 class DRAMInterface;
 class NVMInterface;
 
-/**
- * A burst helper helps organize and manage a packet that is larger than
- * the memory burst size. A system packet that is larger than the burst size
- * is split into multiple packets and all those packets point to
- * a single burst helper such that we know when the whole packet is served.
- */
-class BurstHelper
-{
-  public:
-
-    /** Number of bursts requred for a system packet **/
-    const unsigned int burstCount;
-
-    /** Number of bursts serviced so far for a system packet **/
-    unsigned int burstsServiced;
-
-    BurstHelper(unsigned int _burstCount)
-        : burstCount(_burstCount), burstsServiced(0)
-    { }
-};
-
-/**
- * A memory packet stores packets along with the timestamp of when
- * the packet entered the queue, and also the decoded address.
- */
-class MemPacket
-{
-  public:
-
-    /** When did request enter the controller */
-    const Tick entryTime;
-
-    /** When will request leave the controller */
-    Tick readyTime;
-
-    /** This comes from the outside world */
-    const PacketPtr pkt;
-
-    /** RequestorID associated with the packet */
-    const RequestorID _requestorId;
-
-    const bool read;
-
-    /** Does this packet access DRAM?*/
-    const bool dram;
-
-    /** pseudo channel num*/
-    const uint8_t pseudoChannel;
-
-    /** Will be populated by address decoder */
-    const uint8_t rank;
-    const uint8_t bank;
-    const uint32_t row;
-
-    /**
-     * Bank id is calculated considering banks in all the ranks
-     * eg: 2 ranks each with 8 banks, then bankId = 0 --> rank0, bank0 and
-     * bankId = 8 --> rank1, bank0
-     */
-    const uint16_t bankId;
-
-    /**
-     * The starting address of the packet.
-     * This address could be unaligned to burst size boundaries. The
-     * reason is to keep the address offset so we can accurately check
-     * incoming read packets with packets in the write queue.
-     */
-    Addr addr;
-
-    /**
-     * The size of this dram packet in bytes
-     * It is always equal or smaller than the burst size
-     */
-    unsigned int size;
-
-    /**
-     * A pointer to the BurstHelper if this MemPacket is a split packet
-     * If not a split packet (common case), this is set to NULL
-     */
-    BurstHelper* burstHelper;
-
-    /**
-     * QoS value of the encapsulated packet read at queuing time
-     */
-    uint8_t _qosValue;
-
-    /**
-     * Set the packet QoS value
-     * (interface compatibility with Packet)
-     */
-    inline void qosValue(const uint8_t qv) { _qosValue = qv; }
-
-    /**
-     * Get the packet QoS value
-     * (interface compatibility with Packet)
-     */
-    inline uint8_t qosValue() const { return _qosValue; }
-
-    /**
-     * Get the packet RequestorID
-     * (interface compatibility with Packet)
-     */
-    inline RequestorID requestorId() const { return _requestorId; }
-
-    /**
-     * Get the packet size
-     * (interface compatibility with Packet)
-     */
-    inline unsigned int getSize() const { return size; }
-
-    /**
-     * Get the packet address
-     * (interface compatibility with Packet)
-     */
-    inline Addr getAddr() const { return addr; }
-
-    /**
-     * Return true if its a read packet
-     * (interface compatibility with Packet)
-     */
-    inline bool isRead() const { return read; }
-
-    /**
-     * Return true if its a write packet
-     * (interface compatibility with Packet)
-     */
-    inline bool isWrite() const { return !read; }
-
-    /**
-     * Return true if its a DRAM access
-     */
-    inline bool isDram() const { return dram; }
-
-    MemPacket(PacketPtr _pkt, bool is_read, bool is_dram, uint8_t _channel,
-               uint8_t _rank, uint8_t _bank, uint32_t _row, uint16_t bank_id,
-               Addr _addr, unsigned int _size)
-        : entryTime(curTick()), readyTime(curTick()), pkt(_pkt),
-          _requestorId(pkt->requestorId()),
-          read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
-          bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
-          burstHelper(NULL), _qosValue(_pkt->qosValue())
-    { }
-
-};
-
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
-
-
 /**
  * The memory controller is a single-channel memory controller capturing
  * the most important timing constraints associated with a
@@ -300,14 +151,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -474,12 +325,12 @@ class MemCtrl : public qos::MemCtrl
 
     /**
      * To avoid iterating over the write queue to check for
-     * overlapping transactions, maintain a set of burst addresses
-     * that are currently queued. Since we merge writes to the same
-     * location we never have more than one address to the same burst
-     * address.
+     * overlapping transactions, maintain a map of the burst addresses
+     * that are currently queued to their packets. Since we merge
+     * writes to the same location we never have more than one packet
+     * to the same burst address.
      */
-    std::unordered_set<Addr> isInWriteQueue;
+    std::unordered_map<Addr, MemPacket*> isInWriteQueue;
 
     /**
      * Response queue where read packets wait after we're done working
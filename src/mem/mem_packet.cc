@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2010-2020 ARM Limited
+ * All rights reserved
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2013 Amin Farmahini-Farahani
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/mem_packet.hh"
+
+#include <algorithm>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+void
+MemPacketQueue::push_back(MemPacket *pkt)
+{
+    pkt->seqNum = nextSeqNum++;
+    packets.push_back(pkt);
+
+    BankQueue &bank_queue = _banks[bankKey(pkt->isDram(), pkt->pseudoChannel,
+                                           pkt->rank, pkt->bank)];
+    bank_queue.packets.push_back(pkt);
+    bank_queue.rows[pkt->row].push_back(pkt);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    MemPacket *pkt = *it;
+    BankQueue &bank_queue = _banks.at(bankKey(pkt->isDram(),
+                                              pkt->pseudoChannel,
+                                              pkt->rank, pkt->bank));
+
+    // Packets are mostly taken from the front of the queues, so a linear
+    // search is fine here
+    auto &bank_packets = bank_queue.packets;
+    bank_packets.erase(std::find(bank_packets.begin(), bank_packets.end(),
+                                 pkt));
+
+    auto row = bank_queue.rows.find(pkt->row);
+    auto &row_packets = row->second;
+    row_packets.erase(std::find(row_packets.begin(), row_packets.end(),
+                                pkt));
+    if (row_packets.empty())
+        bank_queue.rows.erase(row);
+
+    return packets.erase(it);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const MemPacket *pkt)
+{
+    // The packets are ordered by their sequence numbers
+    auto it = std::lower_bound(packets.begin(), packets.end(), pkt->seqNum,
+        [](const MemPacket *p, uint64_t seq_num) {
+            return p->seqNum < seq_num;
+        });
+    return it != packets.end() && *it == pkt ? it : packets.end();
+}
+
+} // namespace memory
+} // namespace gem5
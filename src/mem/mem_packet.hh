@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2012-2020 ARM Limited
+ * All rights reserved
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2013 Amin Farmahini-Farahani
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the packets queued in the memory controllers
+ */
+
+#ifndef __MEM_MEM_PACKET_HH__
+#define __MEM_MEM_PACKET_HH__
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A burst helper helps organize and manage a packet that is larger than
+ * the memory burst size. A system packet that is larger than the burst size
+ * is split into multiple packets and all those packets point to
+ * a single burst helper such that we know when the whole packet is served.
+ */
+class BurstHelper
+{
+  public:
+
+    /** Number of bursts requred for a system packet **/
+    const unsigned int burstCount;
+
+    /** Number of bursts serviced so far for a system packet **/
+    unsigned int burstsServiced;
+
+    BurstHelper(unsigned int _burstCount)
+        : burstCount(_burstCount), burstsServiced(0)
+    { }
+};
+
+/**
+ * A memory packet stores packets along with the timestamp of when
+ * the packet entered the queue, and also the decoded address.
+ */
+class MemPacket
+{
+  public:
+
+    /** When did request enter the controller */
+    const Tick entryTime;
+
+    /** When will request leave the controller */
+    Tick readyTime;
+
+    /** This comes from the outside world */
+    const PacketPtr pkt;
+
+    /** RequestorID associated with the packet */
+    const RequestorID _requestorId;
+
+    const bool read;
+
+    /** Does this packet access DRAM?*/
+    const bool dram;
+
+    /** pseudo channel num*/
+    const uint8_t pseudoChannel;
+
+    /** Will be populated by address decoder */
+    const uint8_t rank;
+    const uint8_t bank;
+    const uint32_t row;
+
+    /**
+     * Bank id is calculated considering banks in all the ranks
+     * eg: 2 ranks each with 8 banks, then bankId = 0 --> rank0, bank0 and
+     * bankId = 8 --> rank1, bank0
+     */
+    const uint16_t bankId;
+
+    /**
+     * The starting address of the packet.
+     * This address could be unaligned to burst size boundaries. The
+     * reason is to keep the address offset so we can accurately check
+     * incoming read packets with packets in the write queue.
+     */
+    Addr addr;
+
+    /**
+     * The size of this dram packet in bytes
+     * It is always equal or smaller than the burst size
+     */
+    unsigned int size;
+
+    /**
+     * A pointer to the BurstHelper if this MemPacket is a split packet
+     * If not a split packet (common case), this is set to NULL
+     */
+    BurstHelper* burstHelper;
+
+    /**
+     * The position of the packet in the read or write queue it is in,
+     * packets queued later have larger numbers
+     */
+    uint64_t seqNum;
+
+    /**
+     * QoS value of the encapsulated packet read at queuing time
+     */
+    uint8_t _qosValue;
+
+    /**
+     * Set the packet QoS value
+     * (interface compatibility with Packet)
+     */
+    inline void qosValue(const uint8_t qv) { _qosValue = qv; }
+
+    /**
+     * Get the packet QoS value
+     * (interface compatibility with Packet)
+     */
+    inline uint8_t qosValue() const { return _qosValue; }
+
+    /**
+     * Get the packet RequestorID
+     * (interface compatibility with Packet)
+     */
+    inline RequestorID requestorId() const { return _requestorId; }
+
+    /**
+     * Get the packet size
+     * (interface compatibility with Packet)
+     */
+    inline unsigned int getSize() const { return size; }
+
+    /**
+     * Get the packet address
+     * (interface compatibility with Packet)
+     */
+    inline Addr getAddr() const { return addr; }
+
+    /**
+     * Return true if its a read packet
+     * (interface compatibility with Packet)
+     */
+    inline bool isRead() const { return read; }
+
+    /**
+     * Return true if its a write packet
+     * (interface compatibility with Packet)
+     */
+    inline bool isWrite() const { return !read; }
+
+    /**
+     * Return true if its a DRAM access
+     */
+    inline bool isDram() const { return dram; }
+
+    MemPacket(PacketPtr _pkt, bool is_read, bool is_dram, uint8_t _channel,
+               uint8_t _rank, uint8_t _bank, uint32_t _row, uint16_t bank_id,
+               Addr _addr, unsigned int _size)
+        : entryTime(curTick()), readyTime(curTick()), pkt(_pkt),
+          _requestorId(pkt->requestorId()),
+          read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
+          bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
+          burstHelper(NULL), seqNum(0), _qosValue(_pkt->qosValue())
+    { }
+
+};
+
+/**
+ * The memory packets of a single QoS priority, in the order they were
+ * queued. Besides the arrival order, the queue indexes the packets by
+ * bank and row, so that the schedulers can find the oldest row hit of
+ * a bank, and check for other requests to a bank, without walking the
+ * whole queue.
+ */
+class MemPacketQueue
+{
+  private:
+    typedef std::deque<MemPacket*> Container;
+
+  public:
+    typedef Container::iterator iterator;
+    typedef Container::const_iterator const_iterator;
+
+    /** The packets queued for a single bank */
+    struct BankQueue
+    {
+        /** All the packets to the bank, in arrival order */
+        std::deque<MemPacket*> packets;
+
+        /** The packets to the bank by row, in arrival order */
+        std::unordered_map<uint32_t, std::deque<MemPacket*>> rows;
+
+        /** The number of packets to a row */
+        size_t
+        hits(uint32_t row) const
+        {
+            auto it = rows.find(row);
+            return it == rows.end() ? 0 : it->second.size();
+        }
+
+        /** The oldest packet to a row, if any */
+        MemPacket *
+        oldestHit(uint32_t row) const
+        {
+            auto it = rows.find(row);
+            return it == rows.end() ? nullptr : it->second.front();
+        }
+
+        /** The oldest packet to any row but the given one, if any */
+        MemPacket *
+        oldestMiss(uint32_t row) const
+        {
+            if (packets.size() == hits(row))
+                return nullptr;
+            for (auto pkt : packets) {
+                if (pkt->row != row)
+                    return pkt;
+            }
+            return nullptr;
+        }
+    };
+
+    typedef std::unordered_map<uint32_t, BankQueue> BankQueues;
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    bool empty() const { return packets.empty(); }
+    size_t size() const { return packets.size(); }
+    MemPacket *front() const { return packets.front(); }
+    MemPacket *back() const { return packets.back(); }
+
+    void push_back(MemPacket *pkt);
+    iterator erase(iterator it);
+
+    /** Find a queued packet, return end() if it isn't in the queue */
+    iterator find(const MemPacket *pkt);
+
+    /**
+     * The queues of all the banks that have had packets queued, some of
+     * which may be empty now.
+     */
+    const BankQueues &banks() const { return _banks; }
+
+    /** The packets queued for a bank, or nullptr if there are none */
+    const BankQueue *
+    bank(bool dram, uint8_t pseudo_channel, uint8_t rank, uint8_t bank) const
+    {
+        auto it = _banks.find(bankKey(dram, pseudo_channel, rank, bank));
+        if (it == _banks.end() || it->second.packets.empty())
+            return nullptr;
+        return &it->second;
+    }
+
+  private:
+    static uint32_t
+    bankKey(bool dram, uint8_t pseudo_channel, uint8_t rank, uint8_t bank)
+    {
+        return (uint32_t(dram) << 24) | (uint32_t(pseudo_channel) << 16) |
+            (uint32_t(rank) << 8) | bank;
+    }
+
+    Container packets;
+    BankQueues _banks;
+
+    /** Sequence number of the next packet to be queued */
+    uint64_t nextSeqNum = 0;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_MEM_PACKET_HH__
@@ -62,6 +62,8 @@
 namespace gem5
 {
 
+PoolAllocator Packet::pool("packet", sizeof(Packet));
+
 const MemCmd::CommandInfo
 MemCmd::commandInfo[] =
 {
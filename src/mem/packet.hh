@@ -58,6 +58,7 @@
 #include "base/extensible.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/pool_alloc.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
@@ -419,6 +420,18 @@ class Packet : public Printable, public Extensible<Packet>
      */
     uint64_t htmTransactionUid;
 
+    /**
+     * Storage for small data payloads, used by allocate() to avoid a
+     * heap allocation for accesses of up to a cache line. Data stored
+     * here is still flagged as DYNAMIC_DATA, and has the same lifetime
+     * as heap allocated data.
+     */
+    static constexpr unsigned InlineDataSize = 64;
+    alignas(uint64_t) uint8_t inlineData[InlineDataSize];
+
+    /** Recycling pool the packets are allocated from. */
+    static PoolAllocator pool;
+
   public:
 
     /**
@@ -1054,6 +1067,29 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+    /**
+     * @{
+     * Packets are allocated and freed at a very high rate, so recycle
+     * their memory rather than going through malloc every time.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        if (size == sizeof(Packet))
+            return pool.allocate();
+        return ::operator new(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        if (size == sizeof(Packet))
+            pool.deallocate(p);
+        else
+            ::operator delete(p);
+    }
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1355,7 +1391,7 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(DYNAMIC_DATA) && data != inlineData)
             delete [] data;
 
         flags.clear(STATIC_DATA|DYNAMIC_DATA);
@@ -1371,7 +1407,10 @@ class Packet : public Printable, public Extensible<Packet>
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            if (getSize() <= InlineDataSize)
+                data = inlineData;
+            else
+                data = new uint8_t[getSize()];
         }
     }
 
@@ -44,17 +44,25 @@
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "base/atomicio.hh"
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/store_chunks.hh"
+#include "mem/store_image.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -76,6 +84,15 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+// The layout of the chunks of compressed stores, see store_chunks.hh
+const uint64_t cptChunkSize = 1 << 20;
+const uint64_t cptPageSize = 4096;
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
@@ -372,38 +389,68 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
             filename, range_size);
 
+    // binary checkpoints store a raw image that can be mapped
+    // directly when restoring
+    bool compressed = !CheckpointIn::binary();
+
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(compressed);
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
-    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'\n",
-              filename);
-
-    uint64_t pass_size = 0;
-
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
+    if (!compressed) {
+        serializeRawStore(filepath, range, pmem);
+        return;
+    }
 
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
+    int fd = createImage(filepath);
+
+    // Compress a batch of chunks at a time to bound the amount of
+    // memory needed for the compressed data, and write them in order.
+    const uint64_t num_chunks = divCeil(range.size(), cptChunkSize);
+    const uint64_t batch_size =
+        4 * std::max(1u, std::thread::hardware_concurrency());
+    std::vector<uint64_t> compressed_sizes(num_chunks);
+    std::vector<std::vector<uint8_t>> batch(batch_size);
+    for (uint64_t first = 0; first < num_chunks; first += batch_size) {
+        const uint64_t count = std::min(batch_size, num_chunks - first);
+        std::atomic<bool> failed(false);
+        parallelFor(count, [&](size_t i) {
+            const uint64_t offset = (first + i) * cptChunkSize;
+            if (!compressChunk(pmem + offset,
+                               std::min(cptChunkSize, range.size() - offset),
+                               cptPageSize, batch[i])) {
+                failed = true;
+            }
+        });
+        if (failed)
+            fatal("Failed to compress physical memory\n");
+
+        for (uint64_t i = 0; i < count; i++) {
+            compressed_sizes[first + i] = batch[i].size();
+            const ssize_t size = batch[i].size();
+            if (atomic_write(fd, batch[i].data(), size) != size)
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", filename);
         }
     }
 
-    // close the compressed stream and check that the exit status
-    // is zero
-    if (gzclose(compressed_mem))
-        fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+    replaceImage(fd, filepath);
 
+    uint64_t chunk_size = cptChunkSize;
+    uint64_t page_size = cptPageSize;
+    SERIALIZE_SCALAR(chunk_size);
+    SERIALIZE_SCALAR(page_size);
+    SERIALIZE_CONTAINER(compressed_sizes);
+}
+
+void
+PhysicalMemory::serializeRawStore(const std::string &filepath,
+                                  AddrRange range, const uint8_t *pmem) const
+{
+    writeRawImage(filepath, pmem, range.size(), pageSize);
 }
 
 void
@@ -434,7 +481,7 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
+    const uint32_t read_size = 16384;
 
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
@@ -443,11 +490,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -462,12 +504,84 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // checkpoints that predate raw images are always compressed
+    bool compressed = true;
+    UNSERIALIZE_OPT_SCALAR(compressed);
+    if (!compressed) {
+        unserializeRawStore(filepath, backingStore[store_id]);
+        return;
+    }
+
+    // stores that are split into chunks are decompressed in parallel,
+    // older checkpoints have a single gzip stream
+    uint64_t chunk_size;
+    if (UNSERIALIZE_OPT_SCALAR(chunk_size)) {
+        uint64_t page_size;
+        std::vector<uint64_t> compressed_sizes;
+        UNSERIALIZE_SCALAR(page_size);
+        UNSERIALIZE_CONTAINER(compressed_sizes);
+        if (compressed_sizes.size() != divCeil(range.size(), chunk_size))
+            fatal("Wrong number of chunks in physical memory checkpoint "
+                  "file '%s'\n", filename);
+
+        int fd = open(filepath.c_str(), O_RDONLY);
+        if (fd == -1)
+            fatal("Can't open physical memory checkpoint file '%s'\n",
+                  filename);
+
+        std::vector<uint64_t> file_offsets(compressed_sizes.size());
+        for (size_t i = 1; i < file_offsets.size(); i++)
+            file_offsets[i] = file_offsets[i - 1] + compressed_sizes[i - 1];
+
+        // the workers can't call fatal(), so they only note failures
+        // and leave reporting them to this thread
+        std::atomic<bool> read_failed(false);
+        std::atomic<bool> corrupt(false);
+        parallelFor(compressed_sizes.size(), [&](size_t i) {
+            if (!compressed_sizes[i] || read_failed || corrupt)
+                return;
+            std::vector<uint8_t> in(compressed_sizes[i]);
+            uint64_t done = 0;
+            while (done < in.size()) {
+                ssize_t ret = pread(fd, in.data() + done, in.size() - done,
+                                    file_offsets[i] + done);
+                if (ret == -1 && errno == EINTR)
+                    continue;
+                if (ret <= 0) {
+                    read_failed = true;
+                    return;
+                }
+                done += ret;
+            }
+
+            const uint64_t offset = i * chunk_size;
+            if (!decompressChunk(in, pmem + offset,
+                                 std::min(chunk_size, range.size() - offset),
+                                 page_size)) {
+                corrupt = true;
+            }
+        });
+
+        close(fd);
+        if (read_failed)
+            fatal("Read failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        if (corrupt)
+            fatal("Physical memory checkpoint file '%s' is corrupt\n",
+                  filename);
+        return;
+    }
+
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
     uint64_t curr_size = 0;
-    long* temp_page = new long[chunk_size];
+    long* temp_page = new long[read_size];
     long* pmem_current;
     uint32_t bytes_read;
     while (curr_size < range.size()) {
-        bytes_read = gzread(compressed_mem, temp_page, chunk_size);
+        bytes_read = gzread(compressed_mem, temp_page, read_size);
         if (bytes_read == 0)
             break;
 
@@ -491,5 +605,26 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
               filename);
 }
 
+void
+PhysicalMemory::unserializeRawStore(const std::string &filepath,
+                                    const BackingStoreEntry &store)
+{
+    // Map the image over the backing store rather than reading it. The
+    // mapping is private, so the guest only ever writes to its own
+    // copies of the pages, and pages are only read from the file once
+    // they are touched. Shared backing stores have to stay shared, so
+    // they are read the slow way.
+    if (store.shmFd == -1) {
+        if (mapRawImage(filepath, store.pmem, store.range.size(),
+                        mmapUsingNoReserve)) {
+            return;
+        }
+        warn("Failed to map physical memory checkpoint file '%s', "
+             "reading it instead\n", filepath);
+    }
+
+    readRawImage(filepath, store.pmem, store.range.size(), pageSize);
+}
+
 } // namespace memory
 } // namespace gem5
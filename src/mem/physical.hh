@@ -275,7 +275,9 @@ class PhysicalMemory : public Serializable
     void serialize(CheckpointOut &cp) const override;
 
     /**
-     * Serialize a specific store.
+     * Serialize a specific store. Compressed stores are split into
+     * chunks that are compressed in parallel, and pages that are all
+     * zero are left out.
      *
      * @param store_id Unique identifier of this backing store
      * @param range The address range of this backing store
@@ -284,6 +286,18 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Write a store as an uncompressed image for a binary checkpoint.
+     * The image has the same layout as the store, and pages that are
+     * all zero are left as holes in the file.
+     *
+     * @param filepath The file to write the image to
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeRawStore(const std::string &filepath, AddrRange range,
+                           const uint8_t *pmem) const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -296,6 +310,14 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+    /**
+     * Restore a store from an uncompressed image. Where possible, the
+     * image is mapped copy-on-write over the backing store so that
+     * pages are only read when the guest touches them.
+     */
+    void unserializeRawStore(const std::string &filepath,
+                             const BackingStoreEntry &store);
+
 };
 
 } // namespace memory
@@ -177,7 +177,7 @@ RequestPort::getAddrRanges() const
 void
 RequestPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         a, 1, 0, Request::funcRequestorId);
 
     Packet pkt(req, MemCmd::PrintReq);
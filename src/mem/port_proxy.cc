@@ -37,6 +37,8 @@
 
 #include "mem/port_proxy.hh"
 
+#include <cstring>
+
 #include "base/chunk_generator.hh"
 #include "cpu/thread_context.hh"
 #include "mem/port.hh"
@@ -46,22 +48,61 @@ namespace gem5
 
 PortProxy::PortProxy(ThreadContext *tc, Addr cache_line_size) :
     PortProxy([tc](PacketPtr pkt)->void { tc->sendFunctional(pkt); },
+        [tc](const MemBackdoorReq &req, MemBackdoorPtr &backdoor)->void {
+            tc->sendMemBackdoorReq(req, backdoor);
+        },
         cache_line_size)
 {}
 
 PortProxy::PortProxy(const RequestPort &port, Addr cache_line_size) :
     PortProxy([&port](PacketPtr pkt)->void { port.sendFunctional(pkt); },
+        [&port](const MemBackdoorReq &req, MemBackdoorPtr &backdoor)->void {
+            // Asking for a back door doesn't change the port's state, the
+            // request port API just isn't const qualified.
+            const_cast<RequestPort &>(port).sendMemBackdoorReq(req,
+                                                               backdoor);
+        },
         cache_line_size)
 {}
 
+MemBackdoorPtr
+PortProxy::getBackdoor(Addr addr, uint64_t size, Request::Flags flags,
+                       MemBackdoor::Flags access) const
+{
+    // Uncacheable and strictly ordered accesses may have side effects,
+    // so they always go through the memory system.
+    if (!sendMemBackdoorReq || size == 0 ||
+        flags.isSet(Request::UNCACHEABLE | Request::STRICT_ORDER)) {
+        return nullptr;
+    }
+
+    const AddrRange range = RangeSize(addr, size);
+    MemBackdoorPtr backdoor = nullptr;
+    sendMemBackdoorReq(MemBackdoorReq(range, access), backdoor);
+    if (!backdoor || !backdoor->ptr() ||
+        (backdoor->flags() & access) != access ||
+        backdoor->range().interleaved() ||
+        !range.isSubset(backdoor->range())) {
+        return nullptr;
+    }
+    return backdoor;
+}
+
 void
 PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
                         void *p, uint64_t size) const
 {
+    if (auto *backdoor = getBackdoor(addr, size, flags,
+                                     MemBackdoor::Readable)) {
+        std::memcpy(p, backdoor->ptr() + (addr - backdoor->range().start()),
+                    size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::ReadReq);
@@ -75,10 +116,17 @@ void
 PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
                          const void *p, uint64_t size) const
 {
+    if (auto *backdoor = getBackdoor(addr, size, flags,
+                                     MemBackdoor::Writeable)) {
+        std::memcpy(backdoor->ptr() + (addr - backdoor->range().start()),
+                    p, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::WriteReq);
@@ -92,6 +140,13 @@ void
 PortProxy::memsetBlobPhys(Addr addr, Request::Flags flags,
                           uint8_t v, uint64_t size) const
 {
+    if (auto *backdoor = getBackdoor(addr, size, flags,
+                                     MemBackdoor::Writeable)) {
+        std::memset(backdoor->ptr() + (addr - backdoor->range().start()),
+                    v, size);
+        return;
+    }
+
     // quick and dirty...
     uint8_t *buf = new uint8_t[size];
 
@@ -60,6 +60,7 @@
 #include <functional>
 #include <limits>
 
+#include "mem/backdoor.hh"
 #include "mem/protocol/functional.hh"
 #include "sim/byteswap.hh"
 
@@ -87,10 +88,20 @@ class PortProxy : FunctionalRequestProtocol
 {
   public:
     typedef std::function<void(PacketPtr pkt)> SendFunctionalFunc;
+    typedef std::function<void(const MemBackdoorReq &req,
+                               MemBackdoorPtr &backdoor)>
+        SendMemBackdoorReqFunc;
 
   private:
     SendFunctionalFunc sendFunctional;
 
+    /**
+     * Optional way to ask for a back door to physical memory. When one
+     * covering an access is available, the access is done with a host
+     * memcpy instead of a functional packet per cache line.
+     */
+    SendMemBackdoorReqFunc sendMemBackdoorReq;
+
     /** Granularity of any transactions issued through this proxy. */
     const Addr _cacheLineSize;
 
@@ -102,11 +113,27 @@ class PortProxy : FunctionalRequestProtocol
         panic("Port proxies should never receive snoops.");
     }
 
+    /**
+     * Look for a back door which covers [addr, addr + size) and allows
+     * the requested kind of access.
+     *
+     * @return The back door, or nullptr if the access needs packets.
+     */
+    MemBackdoorPtr getBackdoor(Addr addr, uint64_t size,
+                               Request::Flags flags,
+                               MemBackdoor::Flags access) const;
+
   public:
     PortProxy(SendFunctionalFunc func, Addr cache_line_size) :
         sendFunctional(func), _cacheLineSize(cache_line_size)
     {}
 
+    PortProxy(SendFunctionalFunc func, SendMemBackdoorReqFunc backdoor_func,
+              Addr cache_line_size) :
+        sendFunctional(func), sendMemBackdoorReq(backdoor_func),
+        _cacheLineSize(cache_line_size)
+    {}
+
     // Helpers which create typical SendFunctionalFunc-s from other objects.
     PortProxy(ThreadContext *tc, Addr cache_line_size);
     PortProxy(const RequestPort &port, Addr cache_line_size);
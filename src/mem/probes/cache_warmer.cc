@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/cache_warmer.hh"
+
+#include <algorithm>
+
+#include "mem/cache/base.hh"
+#include "params/CacheWarmer.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+CacheWarmer::CacheWarmer(const CacheWarmerParams &p)
+    : BaseMemProbe(p), system(p.system), caches(p.caches),
+      blkSize(p.system->cacheLineSize())
+{
+    fatal_if(caches.empty(), "%s: No caches to warm.\n", name());
+}
+
+void
+CacheWarmer::startup()
+{
+    // m5.switchCpus() only starts warming when changing the memory mode
+    if (system->bypassCaches())
+        startWarming();
+}
+
+void
+CacheWarmer::startWarming()
+{
+    for (auto cache : caches)
+        cache->startWarming();
+}
+
+void
+CacheWarmer::stopWarming()
+{
+    for (auto cache : caches)
+        cache->stopWarming();
+}
+
+void
+CacheWarmer::handleRequest(const probing::PacketInfo &pi)
+{
+    if (!pi.cmd.isRequest() || !(pi.cmd.isRead() || pi.cmd.isWrite()) ||
+        (pi.flags & Request::UNCACHEABLE) || !caches.front()->isWarming()) {
+        return;
+    }
+
+    const bool is_secure = pi.flags & Request::SECURE;
+    const Addr end = pi.addr + std::max(pi.size, 1u);
+    for (Addr blk_addr = pi.addr & ~Addr(blkSize - 1); blk_addr < end;
+         blk_addr += blkSize) {
+        for (auto cache : caches) {
+            if (!cache->isWarming() ||
+                cache->warmAccess(blk_addr, is_secure, pi.id)) {
+                break;
+            }
+        }
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PROBES_CACHE_WARMER_HH__
+#define __MEM_PROBES_CACHE_WARMER_HH__
+
+#include <vector>
+
+#include "mem/probes/base.hh"
+
+namespace gem5
+{
+
+class BaseCache;
+struct CacheWarmerParams;
+class System;
+
+/**
+ * Probe that warms up the tags of a set of caches from a stream of
+ * memory requests.
+ *
+ * The caches are bypassed while a fast CPU runs in the
+ * atomic_noncaching memory mode, so they would otherwise be cold when
+ * switching to a detailed CPU. The warmer is typically hooked up to the
+ * PktRequest probe of a CommMonitor between the CPU and its first level
+ * cache. Each request performs a tag-only access (see
+ * BaseCache::warmAccess()) in the caches on its path, starting with the
+ * one closest to the requestor and stopping at the first hit.
+ */
+class CacheWarmer : public BaseMemProbe
+{
+  public:
+    CacheWarmer(const CacheWarmerParams &p);
+
+    /** Start warming if the simulation starts out bypassing caches. */
+    void startup() override;
+
+    /** Put all the caches in warming mode. */
+    void startWarming();
+
+    /** Take all the caches out of warming mode and fill their data. */
+    void stopWarming();
+
+  protected:
+    void handleRequest(const probing::PacketInfo &pkt_info) override;
+
+    /** System whose memory mode is checked at startup */
+    System *const system;
+
+    /** Caches on the request path, closest to the requestor first */
+    const std::vector<BaseCache *> caches;
+
+    /** Block size of the caches */
+    const unsigned blkSize;
+};
+
+} // namespace gem5
+
+#endif // __MEM_PROBES_CACHE_WARMER_HH__
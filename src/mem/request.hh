@@ -60,6 +60,7 @@
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/pool_alloc.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
@@ -470,8 +471,28 @@ class Request : public Extensible<Request>
     /** The cause for HTM transaction abort */
     HtmFailureFaultCause _htmAbortCause = HtmFailureFaultCause::INVALID;
 
+    /**
+     * Recycling pool that requests created by create() are allocated
+     * from. The blocks hold both the request and the reference counts
+     * of its shared pointer.
+     */
+    static PoolAllocator pool;
+
   public:
 
+    /**
+     * Create a request, forwarding the arguments to one of the
+     * constructors below. This should be preferred over
+     * std::make_shared, as the memory comes from a recycling pool.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+        return std::allocate_shared<Request>(PoolStdAllocator<Request>(pool),
+                                             std::forward<Args>(args)...);
+    }
+
     /**
      * Minimal constructor. No fields are initialized. (Note that
      *  _flags and privateFlags are cleared by Flags default
@@ -530,7 +551,7 @@ class Request : public Extensible<Request>
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = Request::create();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -612,8 +633,8 @@ class Request : public Extensible<Request>
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = Request::create(*this);
+        req2 = Request::create(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
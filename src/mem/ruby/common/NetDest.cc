@@ -29,6 +29,7 @@
 #include "mem/ruby/common/NetDest.hh"
 
 #include <algorithm>
+#include <cstring>
 
 namespace gem5
 {
@@ -38,22 +39,21 @@ namespace ruby
 
 NetDest::NetDest()
 {
-  resize();
+    clear();
 }
 
 void
 NetDest::add(MachineID newElement)
 {
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
+    assert(bitIndex(newElement.num) < MachineType_base_count(newElement.type));
+    word(newElement) |= bitMask(newElement);
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_words[i] |= netDest.m_words[i];
     }
 }
 
@@ -63,30 +63,33 @@ NetDest::setNetDest(MachineType machine, const Set& set)
     // assure that there is only one set of destinations for this machine
     assert(MachineType_base_level((MachineType)(machine + 1)) -
            MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
+    int base = MachineType_base_level(machine) * wordsPerType;
+    std::memset(&m_words[base], 0, wordsPerType * sizeof(uint64_t));
+    for (NodeID j = 0; j < set.getSize(); j++) {
+        if (set.isElement(j)) {
+            m_words[base + j / bitsPerWord] |= 1ULL << (j % bitsPerWord);
+        }
+    }
 }
 
 void
 NetDest::remove(MachineID oldElement)
 {
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
+    word(oldElement) &= ~bitMask(oldElement);
 }
 
 void
 NetDest::removeNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_words[i] &= ~netDest.m_words[i];
     }
 }
 
 void
 NetDest::clear()
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
-    }
+    std::memset(m_words, 0, sizeof(m_words));
 }
 
 void
@@ -112,14 +115,9 @@ std::vector<NodeID>
 NetDest::getAllDest()
 {
     std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
-            }
-        }
+    dest.reserve(count());
+    for (MachineID mach : *this) {
+        dest.push_back(MachineType_base_number(mach.type) + mach.num);
     }
     return dest;
 }
@@ -128,8 +126,8 @@ int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < numWords; i++) {
+        counter += popCount(m_words[i]);
     }
     return counter;
 }
@@ -137,20 +135,16 @@ NetDest::count() const
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return isElement(index);
 }
 
 MachineID
 NetDest::smallestElement() const
 {
     assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
-        }
+    const_iterator it = begin();
+    if (it != end()) {
+        return *it;
     }
     panic("No smallest element of an empty set.");
 }
@@ -158,10 +152,12 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
+    int base = MachineType_base_level(machine) * wordsPerType;
+    for (int w = 0; w < wordsPerType; w++) {
+        uint64_t bits = m_words[base + w];
+        if (bits) {
+            MachineID mach = {machine,
+                              (NodeID)(w * bitsPerWord + findLsbSet(bits))};
             return mach;
         }
     }
@@ -173,8 +169,12 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
+    for (int i = 0; i < MachineType_NUM; i++) {
+        int set_bits = 0;
+        for (int w = 0; w < wordsPerType; w++) {
+            set_bits += popCount(m_words[i * wordsPerType + w]);
+        }
+        if (set_bits != MachineType_base_count((MachineType)i)) {
             return false;
         }
     }
@@ -185,22 +185,20 @@ NetDest::isBroadcast() const
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
-            return false;
-        }
+    uint64_t any = 0;
+    for (int i = 0; i < numWords; i++) {
+        any |= m_words[i];
     }
-    return true;
+    return any == 0;
 }
 
 // returns the logical OR of "this" set and orNetDest
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_words[i] = m_words[i] | orNetDest.m_words[i];
     }
     return result;
 }
@@ -209,10 +207,9 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_words[i] = m_words[i] & andNetDest.m_words[i];
     }
     return result;
 }
@@ -221,53 +218,46 @@ NetDest::AND(const NetDest& andNetDest) const
 bool
 NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
-            return true;
-        }
+    uint64_t common = 0;
+    for (int i = 0; i < numWords; i++) {
+        common |= m_words[i] & other_netDest.m_words[i];
     }
-    return false;
+    return common != 0;
 }
 
 bool
 NetDest::isSuperset(const NetDest& test) const
 {
-    assert(m_bits.size() == test.getSize());
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
-            return false;
-        }
+    uint64_t missing = 0;
+    for (int i = 0; i < numWords; i++) {
+        missing |= test.m_words[i] & ~m_words[i];
     }
-    return true;
+    return missing == 0;
 }
 
 bool
 NetDest::isElement(MachineID element) const
 {
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
+    return (word(element) & bitMask(element)) != 0;
 }
 
 void
 NetDest::resize()
 {
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
-    }
+    // The slices have a fixed width, Network checks once that every
+    // machine type fits into them.
+    clear();
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << MachineType_NUM << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (int i = 0; i < MachineType_NUM; i++) {
+        MachineType machine = MachineType_from_base_level(i);
+        for (NodeID j = 0; j < MachineType_base_count(machine); j++) {
+            out << isElement({machine, j}) << " ";
         }
         out << " - ";
     }
@@ -277,12 +267,7 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
+    return std::memcmp(m_words, n.m_words, sizeof(m_words)) == 0;
 }
 
 } // namespace ruby
@@ -29,9 +29,12 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "mem/ruby/common/Set.hh"
 #include "mem/ruby/common/MachineID.hh"
 
@@ -41,16 +44,85 @@ namespace gem5
 namespace ruby
 {
 
-// NetDest specifies the network destination of a Message
+// NetDest specifies the network destination of a Message. The set is
+// stored as one flat, fixed-width array of 64-bit words with a slice of
+// NUMBER_BITS_PER_SET bits per machine type, so it never touches the heap
+// and copying, AND/OR and popcount are simple loops over the words.
 class NetDest
 {
+  private:
+    static constexpr int bitsPerWord = 64;
+    static constexpr int wordsPerType =
+        (NUMBER_BITS_PER_SET + bitsPerWord - 1) / bitsPerWord;
+    static constexpr int numWords = MachineType_NUM * wordsPerType;
+
   public:
+    // Iterates over the members of a NetDest in ascending order without
+    // allocating.
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = MachineID;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const MachineID *;
+        using reference = MachineID;
+
+        const_iterator(const NetDest *dest, int word)
+            : m_dest(dest), m_word(word),
+              m_bits(word < numWords ? dest->m_words[word] : 0)
+        {
+            skipEmpty();
+        }
+
+        MachineID
+        operator*() const
+        {
+            return {MachineType_from_base_level(m_word / wordsPerType),
+                    (NodeID)((m_word % wordsPerType) * bitsPerWord +
+                             findLsbSet(m_bits))};
+        }
+
+        const_iterator &
+        operator++()
+        {
+            m_bits &= m_bits - 1;
+            skipEmpty();
+            return *this;
+        }
+
+        bool
+        operator==(const const_iterator &other) const
+        {
+            return m_word == other.m_word && m_bits == other.m_bits;
+        }
+
+        bool
+        operator!=(const const_iterator &other) const
+        {
+            return !(*this == other);
+        }
+
+      private:
+        // Move to the next word with a set bit once the current one
+        // has been exhausted
+        void
+        skipEmpty()
+        {
+            while (m_bits == 0 && m_word < numWords - 1)
+                m_bits = m_dest->m_words[++m_word];
+            if (m_bits == 0)
+                m_word = numWords;
+        }
+
+        const NetDest *m_dest;
+        int m_word;
+        uint64_t m_bits;
+    };
+
     // Constructors
     // creates and empty set
     NetDest();
-    explicit NetDest(int bit_size);
-
-    NetDest& operator=(const Set& obj);
 
     ~NetDest()
     { }
@@ -87,11 +159,14 @@ class NetDest
     // For Princeton Network
     std::vector<NodeID> getAllDest();
 
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, numWords); }
+
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
     void resize();
-    int getSize() const { return m_bits.size(); }
+    int getSize() const { return MachineType_NUM; }
 
     // get element for a index
     NodeID elementAt(MachineID index);
@@ -99,19 +174,38 @@ class NetDest
     void print(std::ostream& out) const;
 
   private:
-    // returns a value >= MachineType_base_level("this machine")
-    // and < MachineType_base_level("next highest machine")
+    // returns the index of the first word of the slice belonging to
+    // "this machine"
     int
     vecIndex(MachineID m) const
     {
         int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
-        return vec_index;
+        assert(vec_index < MachineType_NUM);
+        return vec_index * wordsPerType;
     }
 
     NodeID bitIndex(NodeID index) const { return index; }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    uint64_t
+    bitMask(MachineID m) const
+    {
+        assert(m.num < NUMBER_BITS_PER_SET);
+        return 1ULL << (m.num % bitsPerWord);
+    }
+
+    uint64_t &
+    word(MachineID m)
+    {
+        return m_words[vecIndex(m) + bitIndex(m.num) / bitsPerWord];
+    }
+
+    uint64_t
+    word(MachineID m) const
+    {
+        return m_words[vecIndex(m) + bitIndex(m.num) / bitsPerWord];
+    }
+
+    uint64_t m_words[numWords];
 };
 
 inline std::ostream&
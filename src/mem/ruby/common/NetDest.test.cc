@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <ostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mem/ruby/common/NetDest.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+/*
+ * The machine type helpers are generated by SLICC for each protocol and
+ * need the controllers, so give every machine type a test-controlled
+ * number of machines instead.
+ */
+namespace
+{
+
+static_assert(MachineType_NUM >= 3, "Test needs three machine types");
+
+std::array<int, MachineType_NUM> machineCounts;
+
+const MachineType firstType = MachineType_FIRST;
+const MachineType fullType = MachineType(MachineType_FIRST + 1);
+const MachineType lastType = MachineType(MachineType_NUM - 1);
+
+} // anonymous namespace
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+MachineType &
+operator++(MachineType &e)
+{
+    return e = MachineType(e + 1);
+}
+
+int
+MachineType_base_level(const MachineType &obj)
+{
+    return obj;
+}
+
+MachineType
+MachineType_from_base_level(int type)
+{
+    return MachineType(type);
+}
+
+int
+MachineType_base_count(const MachineType &obj)
+{
+    return machineCounts[obj];
+}
+
+int
+MachineType_base_number(const MachineType &obj)
+{
+    int number = 0;
+    for (int i = 0; i < obj; i++)
+        number += machineCounts[i];
+    return number;
+}
+
+std::string
+MachineType_to_string(const MachineType &obj)
+{
+    return "Machine" + std::to_string(obj);
+}
+
+std::ostream &
+operator<<(std::ostream &out, const MachineType &obj)
+{
+    return out << MachineType_to_string(obj);
+}
+
+} // namespace ruby
+} // namespace gem5
+
+namespace
+{
+
+/** Members of a NetDest, ordered the way it iterates over them. */
+using Reference = std::set<std::pair<int, NodeID>>;
+
+class NetDestTest : public testing::Test
+{
+  protected:
+    void
+    SetUp() override
+    {
+        machineCounts.fill(0);
+        // A partly used slice, one using every bit of its slice, and the
+        // last slice of the array
+        machineCounts[firstType] = 5;
+        machineCounts[fullType] = NUMBER_BITS_PER_SET;
+        machineCounts[lastType] = 2;
+
+        for (int i = 0; i < MachineType_NUM; i++) {
+            for (NodeID n = 0; n < (NodeID)machineCounts[i]; n++)
+                machines.push_back({MachineType(i), n});
+        }
+    }
+
+    /** Check that a NetDest holds exactly the members of a reference. */
+    void
+    expectSame(const NetDest &dest, const Reference &reference)
+    {
+        Reference members;
+        auto expected = reference.begin();
+        for (MachineID mach : dest) {
+            ASSERT_NE(expected, reference.end());
+            EXPECT_EQ(mach.type, expected->first);
+            EXPECT_EQ(mach.num, expected->second);
+            members.emplace(mach.type, mach.num);
+            ++expected;
+        }
+        EXPECT_EQ(expected, reference.end());
+        EXPECT_EQ(members, reference);
+
+        EXPECT_EQ(dest.count(), (int)reference.size());
+        EXPECT_EQ(dest.isEmpty(), reference.empty());
+        EXPECT_EQ(dest.isBroadcast(), reference.size() == machines.size());
+        for (const MachineID &mach : machines) {
+            EXPECT_EQ(dest.isElement(mach),
+                      reference.count({mach.type, mach.num}) == 1);
+        }
+        if (!reference.empty()) {
+            MachineID smallest = dest.smallestElement();
+            EXPECT_EQ(smallest.type, reference.begin()->first);
+            EXPECT_EQ(smallest.num, reference.begin()->second);
+        }
+    }
+
+    /** Fill a NetDest and its reference with random members. */
+    void
+    randomFill(std::mt19937 &rng, NetDest &dest, Reference &reference)
+    {
+        std::bernoulli_distribution member(0.3);
+        for (const MachineID &mach : machines) {
+            if (member(rng)) {
+                dest.add(mach);
+                reference.emplace(mach.type, mach.num);
+            }
+        }
+    }
+
+    std::vector<MachineID> machines;
+};
+
+} // anonymous namespace
+
+TEST_F(NetDestTest, StartsEmpty)
+{
+    NetDest dest;
+    expectSame(dest, {});
+    EXPECT_EQ(dest.begin(), dest.end());
+}
+
+TEST_F(NetDestTest, AddRemove)
+{
+    NetDest dest;
+    Reference reference;
+    for (const MachineID &mach : machines) {
+        dest.add(mach);
+        reference.emplace(mach.type, mach.num);
+        expectSame(dest, reference);
+    }
+    for (const MachineID &mach : machines) {
+        dest.remove(mach);
+        reference.erase({mach.type, mach.num});
+        expectSame(dest, reference);
+    }
+}
+
+TEST_F(NetDestTest, Broadcast)
+{
+    NetDest dest;
+    dest.broadcast(fullType);
+    Reference reference;
+    for (NodeID n = 0; n < NUMBER_BITS_PER_SET; n++)
+        reference.emplace(fullType, n);
+    expectSame(dest, reference);
+    EXPECT_EQ(dest.smallestElement(fullType), MachineID(fullType, 0));
+
+    dest.broadcast();
+    for (const MachineID &mach : machines)
+        reference.emplace(mach.type, mach.num);
+    expectSame(dest, reference);
+
+    dest.clear();
+    expectSame(dest, {});
+}
+
+TEST_F(NetDestTest, SmallestElementOfType)
+{
+    NetDest dest;
+    dest.add({fullType, NUMBER_BITS_PER_SET - 1});
+    dest.add({lastType, 1});
+    EXPECT_EQ(dest.smallestElement(fullType),
+              MachineID(fullType, NUMBER_BITS_PER_SET - 1));
+    EXPECT_EQ(dest.smallestElement(lastType), MachineID(lastType, 1));
+    EXPECT_ANY_THROW(dest.smallestElement(firstType));
+}
+
+TEST_F(NetDestTest, GetAllDest)
+{
+    NetDest dest;
+    dest.add({firstType, 4});
+    dest.add({fullType, 0});
+    dest.add({lastType, 1});
+    const NodeID full_base = machineCounts[firstType];
+    const NodeID last_base = MachineType_base_number(lastType);
+    EXPECT_EQ(dest.getAllDest(),
+              std::vector<NodeID>({4, full_base, last_base + 1}));
+}
+
+/** Random sets combined with every set operation match std::set. */
+TEST_F(NetDestTest, RandomSetOperations)
+{
+    std::mt19937 rng(12345);
+    for (int round = 0; round < 500; round++) {
+        NetDest a, b;
+        Reference ref_a, ref_b;
+        randomFill(rng, a, ref_a);
+        randomFill(rng, b, ref_b);
+        expectSame(a, ref_a);
+        expectSame(b, ref_b);
+
+        Reference ref_or = ref_a;
+        ref_or.insert(ref_b.begin(), ref_b.end());
+        Reference ref_and;
+        Reference ref_diff;
+        for (const auto &member : ref_a) {
+            if (ref_b.count(member))
+                ref_and.insert(member);
+            else
+                ref_diff.insert(member);
+        }
+
+        expectSame(a.OR(b), ref_or);
+        expectSame(a.AND(b), ref_and);
+        EXPECT_EQ(a.intersectionIsNotEmpty(b), !ref_and.empty());
+        EXPECT_EQ(a.isSuperset(a.AND(b)), true);
+        EXPECT_EQ(a.AND(b).isSubset(b), true);
+        EXPECT_EQ(a.isSuperset(b), ref_and.size() == ref_b.size());
+        EXPECT_EQ(a.isSubset(b), ref_and.size() == ref_a.size());
+        EXPECT_EQ(a.isEqual(b), ref_a == ref_b);
+
+        NetDest c = a;
+        EXPECT_TRUE(c.isEqual(a));
+        c.addNetDest(b);
+        expectSame(c, ref_or);
+        c = a;
+        c.removeNetDest(b);
+        expectSame(c, ref_diff);
+    }
+}
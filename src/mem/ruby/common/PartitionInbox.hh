@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_PARTITIONINBOX_HH__
+#define __MEM_RUBY_COMMON_PARTITIONINBOX_HH__
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Items posted to an object by other partitions when Ruby is split
+ * across several event queues, i.e., by threads servicing other
+ * queues.
+ *
+ * The receiving object takes the items in from a barrier callback of
+ * its event queue, while all other queues are stopped, so no item is
+ * seen before the end of the quantum it was posted in. Senders must
+ * therefore only post items the receiver doesn't need before then,
+ * which holds as long as the latency between the partitions is no
+ * shorter than the quantum.
+ */
+template <typename T>
+class PartitionInbox
+{
+  private:
+    mutable std::mutex mutex;
+    std::vector<T> items;
+    /** Items being taken in, kept to reuse their storage. */
+    std::vector<T> taken;
+
+  public:
+    /**
+     * Post an item.
+     *
+     * @return Whether this is the first item since the last drain.
+     */
+    bool
+    post(T item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.push_back(std::move(item));
+        return items.size() == 1;
+    }
+
+    /**
+     * Remove all posted items and call f on the vector holding them.
+     * Items posted by the same thread are in the order they were
+     * posted.
+     */
+    template <typename F>
+    void
+    drain(F f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (items.empty())
+                return;
+            items.swap(taken);
+        }
+        f(taken);
+        taken.clear();
+    }
+
+    /** Call f on all items that haven't been taken in yet. */
+    template <typename F>
+    void
+    forEach(F f) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &item : items)
+            f(item);
+    }
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_PARTITIONINBOX_HH__
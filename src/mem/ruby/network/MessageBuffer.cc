@@ -40,6 +40,7 @@
 
 #include "mem/ruby/network/MessageBuffer.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cprintf.hh"
@@ -57,6 +58,23 @@ namespace ruby
 
 using stl_helpers::operator<<;
 
+namespace
+{
+
+uint32_t
+queueIndex(const EventQueue *eq)
+{
+    auto it = std::find(mainEventQueue.begin(), mainEventQueue.end(), eq);
+    assert(it != mainEventQueue.end());
+    return it - mainEventQueue.begin();
+}
+
+} // anonymous namespace
+
+std::vector<std::unique_ptr<PartitionInbox<MessageBuffer *>>>
+    MessageBuffer::remoteBuffers;
+uint64_t MessageBuffer::numBuffers = 0;
+
 MessageBuffer::MessageBuffer(const Params &p)
     : SimObject(p), m_stall_map_size(0), m_max_size(p.buffer_size),
     m_max_dequeue_rate(p.max_dequeue_rate), m_dequeues_this_cy(0),
@@ -67,6 +85,7 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_randomization(p.randomization),
     m_allow_zero_latency(p.allow_zero_latency),
     m_routing_priority(p.routing_priority),
+    m_index(numBuffers++), m_consumer_queue(0),
     ADD_STAT(m_not_avail_count, statistics::units::Count::get(),
              "Number of times this buffer did not have N slots available"),
     ADD_STAT(m_msg_count, statistics::units::Count::get(),
@@ -133,6 +152,26 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_avg_stall_time = m_stall_time / m_msg_count;
 }
 
+void
+MessageBuffer::startup()
+{
+    // Objects on other event queues may send messages to this buffer,
+    // which are delivered at global barriers
+    if (numMainEventQueues > 1 && m_consumer) {
+        EventQueue *eq = m_consumer->getObject()->eventQueue();
+        m_consumer_queue = queueIndex(eq);
+        if (remoteBuffers.size() < numMainEventQueues)
+            remoteBuffers.resize(numMainEventQueues);
+        auto &buffers = remoteBuffers[m_consumer_queue];
+        if (!buffers) {
+            buffers = std::make_unique<PartitionInbox<MessageBuffer *>>();
+            eq->addBarrierCallback([queue = m_consumer_queue]() {
+                deliverRemoteMessages(queue);
+            });
+        }
+    }
+}
+
 unsigned int
 MessageBuffer::getSize(Tick curTime)
 {
@@ -218,6 +257,27 @@ void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
                        bool bypassStrictFIFO)
 {
+    assert(m_consumer != NULL);
+
+    // A sender in another partition hands the message over to the
+    // consumer's thread at the end of the quantum
+    if (inParallelMode &&
+        m_consumer->getObject()->eventQueue() != curEventQueue()) {
+        fatal_if(m_max_size != 0, "%s: Buffers between Ruby partitions "
+                 "must have an infinite size.\n", name());
+        fatal_if(m_randomization == MessageRandomization::enabled ||
+                 (m_randomization == MessageRandomization::ruby_system &&
+                  RubySystem::getRandomization()),
+                 "%s: Messages between Ruby partitions can't be "
+                 "randomized.\n", name());
+        if (m_remote_msgs.post({message, current_time, delta,
+                                bypassStrictFIFO,
+                                queueIndex(curEventQueue())})) {
+            remoteBuffers[m_consumer_queue]->post(this);
+        }
+        return;
+    }
+
     // record current time incase we have a pop that also adjusts my size
     if (m_time_last_time_enqueue < current_time) {
         m_msgs_this_cycle = 0;  // first msg this cycle
@@ -285,6 +345,7 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     // Insert the message into the priority heap
     m_prio_heap.push_back(message);
     push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    updateReadyMask();
     // Increment the number of messages statistic
     m_buf_msgs++;
 
@@ -295,11 +356,49 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
             arrival_time, *(message.get()));
 
     // Schedule the wakeup
-    assert(m_consumer != NULL);
     m_consumer->scheduleEventAbsolute(arrival_time);
     m_consumer->storeEventInfo(m_vnet_id);
 }
 
+void
+MessageBuffer::deliverRemoteMessages(uint32_t queue)
+{
+    remoteBuffers[queue]->drain([](std::vector<MessageBuffer *> &buffers) {
+        std::sort(buffers.begin(), buffers.end(),
+            [](const MessageBuffer *a, const MessageBuffer *b) {
+                return a->m_index < b->m_index;
+            });
+        for (MessageBuffer *buffer : buffers)
+            buffer->deliverRemoteMessages();
+    });
+}
+
+void
+MessageBuffer::deliverRemoteMessages()
+{
+    m_remote_msgs.drain([this](std::vector<RemoteMsg> &msgs) {
+        // Senders in different partitions post their messages in no
+        // particular order. Enqueue them in the order of their send
+        // times, and messages sent at the same time by partition.
+        std::stable_sort(msgs.begin(), msgs.end(),
+            [](const RemoteMsg &a, const RemoteMsg &b) {
+                if (a.current_time != b.current_time)
+                    return a.current_time < b.current_time;
+                return a.queue < b.queue;
+            });
+
+        for (auto &msg : msgs) {
+            fatal_if(msg.current_time + msg.delta < curTick(),
+                     "%s: Message from another partition is late, the "
+                     "quantum (%d ticks) must not be longer than the "
+                     "latency between partitions (%d ticks).\n",
+                     name(), simQuantum, msg.delta);
+            enqueue(msg.message, msg.current_time, msg.delta,
+                    msg.bypassStrictFIFO);
+        }
+    });
+}
+
 Tick
 MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 {
@@ -325,6 +424,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 
     pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
     m_prio_heap.pop_back();
+    updateReadyMask();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -359,6 +459,7 @@ void
 MessageBuffer::clear()
 {
     m_prio_heap.clear();
+    updateReadyMask();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -385,22 +486,24 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::reanalyzeList(MsgPtr m, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
+    while (m) {
+        MsgPtr next = m->getNext();
+        m->setNext(MsgPtr());
         assert(m->getLastEnqueueTime() <= schdTick);
 
         m_prio_heap.push_back(m);
         push_heap(m_prio_heap.begin(), m_prio_heap.end(),
                   std::greater<MsgPtr>());
+        updateReadyMask();
 
         m_consumer->scheduleEventAbsolute(schdTick);
 
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
 
-        lt.pop_front();
+        m = next;
     }
 }
 
@@ -408,7 +511,7 @@ void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    assert(m_stall_msg_map.contains(addr));
 
     //
     // Put all stalled messages associated with this address back on the
@@ -416,10 +519,11 @@ MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
+    unsigned size;
+    MsgPtr list = m_stall_msg_map.take(addr, size);
+    m_stall_map_size -= size;
     assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    reanalyzeList(list, current_time);
 }
 
 void
@@ -432,14 +536,14 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
     // prio heap.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
+    // The order of the lines doesn't matter, as the heap is ordered by the
+    // original enqueue time of the messages.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
+    m_stall_msg_map.drain([&](MsgPtr list, unsigned size) {
+        m_stall_map_size -= size;
         assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
-    }
-    m_stall_msg_map.clear();
+        reanalyzeList(list, current_time);
+    });
 }
 
 void
@@ -459,7 +563,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    m_stall_msg_map.push(addr, message);
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -467,7 +571,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 bool
 MessageBuffer::hasStalledMsg(Addr addr) const
 {
-    return (m_stall_msg_map.count(addr) != 0);
+    return m_stall_msg_map.contains(addr);
 }
 
 void
@@ -560,24 +664,26 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
-            if (is_read && !mask && msg->functionalRead(pkt))
-                return 1;
-            else if (is_read && mask && msg->functionalRead(pkt, *mask))
-                num_functional_accesses++;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
-        }
-    }
+    auto access = [&](Message *msg) {
+        if (is_read && !mask && msg->functionalRead(pkt))
+            return true;
+        else if (is_read && mask && msg->functionalRead(pkt, *mask))
+            num_functional_accesses++;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
+        return false;
+    };
+
+    if (m_stall_msg_map.anyOf(access))
+        return 1;
+
+    // Check the messages still on their way from other partitions.
+    bool found = false;
+    m_remote_msgs.forEach([&](const RemoteMsg &remote) {
+        found = found || access(remote.message.get());
+    });
 
-    return num_functional_accesses;
+    return found ? 1 : num_functional_accesses;
 }
 
 } // namespace ruby
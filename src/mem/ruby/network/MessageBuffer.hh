@@ -50,6 +50,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -60,6 +61,8 @@
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/PartitionInbox.hh"
+#include "mem/ruby/network/StallMsgMap.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
@@ -77,6 +80,8 @@ class MessageBuffer : public SimObject
     typedef MessageBufferParams Params;
     MessageBuffer(const Params &p);
 
+    void startup() override;
+
     void reanalyzeMessages(Addr addr, Tick current_time);
     void reanalyzeAllMessages(Tick current_time);
     void stallMessage(Addr addr, Tick current_time);
@@ -115,6 +120,20 @@ class MessageBuffer : public SimObject
 
     Consumer* getConsumer() { return m_consumer; }
 
+    /**
+     * Have this buffer keep a bit in a mask owned by its consumer set
+     * while it holds messages, so the consumer can skip empty buffers
+     * without polling them. Stalled messages don't count.
+     */
+    void
+    setReadyMask(uint64_t *mask, unsigned bit)
+    {
+        assert(bit < 64);
+        m_ready_mask = mask;
+        m_ready_bit = 1ULL << bit;
+        updateReadyMask();
+    }
+
     bool getOrdered() { return m_strict_fifo; }
 
     //! Function for extracting the message at the head of the
@@ -194,7 +213,42 @@ class MessageBuffer : public SimObject
     int routingPriority() const { return m_routing_priority; }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    void reanalyzeList(MsgPtr, Tick);
+
+    void
+    updateReadyMask()
+    {
+        if (!m_ready_mask)
+            return;
+        if (m_prio_heap.empty())
+            *m_ready_mask &= ~m_ready_bit;
+        else
+            *m_ready_mask |= m_ready_bit;
+    }
+
+    /**
+     * Enqueue the messages other partitions sent during the last
+     * quantum. Called by the consumer's thread at global barriers.
+     */
+    void deliverRemoteMessages();
+
+    /**
+     * Deliver the remote messages of every buffer consumed on an event
+     * queue that received some during the last quantum.
+     */
+    static void deliverRemoteMessages(uint32_t queue);
+
+    /**
+     * Buffers sent messages by other partitions during the current
+     * quantum, per event queue of their consumers. There is a single
+     * barrier callback per queue, so buffers that never receive remote
+     * messages cost nothing at barriers.
+     */
+    static std::vector<std::unique_ptr<PartitionInbox<MessageBuffer *>>>
+        remoteBuffers;
+
+    /** Number of buffers created, to number them. */
+    static uint64_t numBuffers;
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
@@ -206,9 +260,9 @@ class MessageBuffer : public SimObject
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
+    //! Consumer owned mask tracking if m_prio_heap is empty, can be NULL
+    uint64_t *m_ready_mask = nullptr;
+    uint64_t m_ready_bit = 0;
 
     /**
      * A map from line addresses to lists of stalled messages for that line.
@@ -223,7 +277,7 @@ class MessageBuffer : public SimObject
      * moved back to the m_prio_heap in the same order. This prevents starving
      * older requests with younger ones.
      */
-    StallMsgMapType m_stall_msg_map;
+    StallMsgMap m_stall_msg_map;
 
     /**
      * A map from line addresses to corresponding vectors of messages that
@@ -233,6 +287,25 @@ class MessageBuffer : public SimObject
     typedef std::unordered_map<Addr, std::vector<MsgPtr>> DeferredMsgMapType;
     DeferredMsgMapType m_deferred_msg_map;
 
+    /** An enqueue by a sender in another partition. */
+    struct RemoteMsg
+    {
+        MsgPtr message;
+        Tick current_time;
+        Tick delta;
+        bool bypassStrictFIFO;
+        /** Index of the sender's event queue, to order the messages. */
+        uint32_t queue;
+    };
+
+    /**
+     * Messages sent by objects in other partitions (i.e., on other
+     * event queues) than the consumer when Ruby runs on several
+     * threads. They are enqueued at the end of the quantum, so the
+     * buffer itself is only ever touched by the consumer's thread.
+     */
+    PartitionInbox<RemoteMsg> m_remote_msgs;
+
     /**
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
@@ -281,6 +354,14 @@ class MessageBuffer : public SimObject
 
     const int m_routing_priority;
 
+    /**
+     * Creation order of the buffer, so the buffers are sent their
+     * remote messages in the same order in every run.
+     */
+    const uint64_t m_index;
+    /** Index of the consumer's event queue. */
+    uint32_t m_consumer_queue;
+
     int m_input_link_id;
     int m_vnet_id;
 
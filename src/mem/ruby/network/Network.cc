@@ -93,6 +93,16 @@ Network::Network(const Params &p)
         }
     }
 
+    // NetDest has a fixed slice of NUMBER_BITS_PER_SET bits per machine
+    // type, so check once that all the controllers fit into it
+    for (int i = 0; i < MachineType_NUM; ++i) {
+        int count = MachineType_base_count(static_cast<MachineType>(i));
+        fatal_if(count > NUMBER_BITS_PER_SET,
+                 "Number of bits(%d) < size specified(%d). "
+                 "Increase the number of bits and recompile.\n",
+                 NUMBER_BITS_PER_SET, count);
+    }
+
     // Total nodes/controllers in network is equal to the local node count
     // Must make sure this is called after the State Machine constructors
     m_nodes = local_node_id;
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_STALLMSGMAP_HH__
+#define __MEM_RUBY_NETWORK_STALLMSGMAP_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * The messages a MessageBuffer holds back until the line they are
+ * waiting for changes state, kept by line address.
+ *
+ * The lines are stored in an open-addressed hash table with linear
+ * probing, and the messages stalled on a line form a FIFO list linked
+ * through the messages themselves. Once the table has grown to the
+ * number of lines a buffer stalls on at the same time, stalling and
+ * releasing messages doesn't allocate any memory.
+ */
+class StallMsgMap
+{
+  private:
+    struct Entry
+    {
+        Addr addr = 0;
+        MsgPtr head;
+        Message *tail = nullptr;
+        unsigned size = 0;
+    };
+
+    /** Power of two number of slots, empty slots have no head. */
+    std::vector<Entry> slots;
+    unsigned numLines = 0;
+    unsigned shift = 64;
+
+    size_t
+    home(Addr addr) const
+    {
+        return (addr * 0x9e3779b97f4a7c15ULL) >> shift;
+    }
+
+    size_t mask() const { return slots.size() - 1; }
+
+    /** The slot of the line or the empty slot it would go into. */
+    size_t
+    slot(Addr addr) const
+    {
+        size_t i = home(addr);
+        while (slots[i].head && slots[i].addr != addr)
+            i = (i + 1) & mask();
+        return i;
+    }
+
+    void
+    grow()
+    {
+        size_t num_slots = slots.empty() ? 16 : slots.size() * 2;
+        std::vector<Entry> old(num_slots);
+        old.swap(slots);
+        shift = 64 - floorLog2(num_slots);
+        for (auto &entry : old) {
+            if (entry.head)
+                slots[slot(entry.addr)] = std::move(entry);
+        }
+    }
+
+    /**
+     * Empty a slot and move later entries of the probe sequence back,
+     * so no tombstones are needed.
+     */
+    void
+    erase(size_t i)
+    {
+        for (size_t j = (i + 1) & mask(); slots[j].head;
+             j = (j + 1) & mask()) {
+            size_t k = home(slots[j].addr);
+            // Leave the entry if its home lies cyclically in (i, j]
+            if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+                continue;
+            slots[i] = std::move(slots[j]);
+            i = j;
+        }
+        slots[i] = Entry();
+        numLines--;
+    }
+
+  public:
+    /** Number of lines that have stalled messages. */
+    unsigned size() const { return numLines; }
+    bool empty() const { return numLines == 0; }
+
+    bool
+    contains(Addr addr) const
+    {
+        return numLines && slots[slot(addr)].head;
+    }
+
+    /** Append a message to the list of the line. */
+    void
+    push(Addr addr, const MsgPtr &msg)
+    {
+        assert(!msg->getNext());
+        if ((numLines + 1) * 4 > slots.size() * 3)
+            grow();
+
+        Entry &entry = slots[slot(addr)];
+        if (entry.head) {
+            entry.tail->setNext(msg);
+        } else {
+            entry.addr = addr;
+            entry.head = msg;
+            numLines++;
+        }
+        entry.tail = msg.get();
+        entry.size++;
+    }
+
+    /**
+     * Remove the messages of a line. The messages are returned as a
+     * list starting with the oldest one, and the number of messages is
+     * returned in size.
+     */
+    MsgPtr
+    take(Addr addr, unsigned &size)
+    {
+        assert(contains(addr));
+        size_t i = slot(addr);
+        MsgPtr head = std::move(slots[i].head);
+        size = slots[i].size;
+        erase(i);
+        return head;
+    }
+
+    /**
+     * Remove the messages of all lines, calling f with the list and
+     * the number of messages of each line.
+     */
+    template <typename F>
+    void
+    drain(F f)
+    {
+        for (auto &entry : slots) {
+            if (entry.head) {
+                f(std::move(entry.head), entry.size);
+                entry = Entry();
+            }
+        }
+        numLines = 0;
+    }
+
+    /** Call f on all stalled messages, stopping once it returns true. */
+    template <typename F>
+    bool
+    anyOf(F f) const
+    {
+        for (const auto &entry : slots) {
+            for (Message *msg = entry.head.get(); msg;
+                 msg = msg->getNext().get()) {
+                if (f(msg))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void
+    clear()
+    {
+        drain([](MsgPtr msg, unsigned size) {
+            while (msg) {
+                MsgPtr next = msg->getNext();
+                msg->setNext(MsgPtr());
+                msg = next;
+            }
+        });
+    }
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_STALLMSGMAP_HH__
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/fast/FastNetwork.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/BasicLink.hh"
+#include "mem/ruby/network/BasicRouter.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+FastNetwork::FastNetwork(const Params &p)
+    : Network(p), m_epoch_length(p.epoch_length),
+      m_max_utilization(p.max_link_utilization),
+      networkStats(this)
+{
+    fatal_if(m_epoch_length == 0, "%s: epoch_length must be non-zero",
+             name());
+    fatal_if(m_max_utilization <= 0 || m_max_utilization >= 1,
+             "%s: max_link_utilization must be in (0, 1)", name());
+
+    // record the router latencies
+    for (auto *router : p.routers) {
+        auto id = static_cast<size_t>(router->params().router_id);
+        if (id >= m_router_latency.size()) {
+            m_router_latency.resize(id + 1, Cycles(0));
+            m_router_out_links.resize(id + 1);
+        }
+        m_router_latency[id] = router->params().latency;
+    }
+
+    m_node_in_link.resize(m_nodes, -1);
+    m_node_ports.resize(m_nodes);
+    m_last_arrival.resize(m_nodes);
+}
+
+void
+FastNetwork::init()
+{
+    Network::init();
+
+    // The topology pointer should have already been initialized in
+    // the parent class network constructor.
+    assert(m_topology_ptr != NULL);
+    m_topology_ptr->createLinks(this);
+}
+
+int
+FastNetwork::addLink(int dest_router, NodeID dest_node, Cycles latency,
+                     BasicLink *link,
+                     std::vector<NetDest>& routing_table_entry)
+{
+    fatal_if(link->m_bandwidth_factor <= 0,
+             "%s: FastNetwork needs a positive bandwidth_factor",
+             link->name());
+
+    m_links.push_back({dest_router, dest_node, latency, link->m_weight,
+                       routing_table_entry,
+                       LinkQueue(link->m_bandwidth_factor, m_epoch_length,
+                                 m_max_utilization)});
+    return m_links.size() - 1;
+}
+
+// From a switch to an endpoint node
+void
+FastNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
+                            BasicLink* link,
+                            std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_dest = getLocalNodeID(global_dest);
+    assert(local_dest < m_nodes);
+    assert(src < m_router_out_links.size());
+
+    // some destinations don't use all vnets, make room for all of them
+    int num_vnets = params().number_of_virtual_networks;
+    gem5_assert(num_vnets >= m_fromNetQueues[local_dest].size());
+    m_fromNetQueues[local_dest].resize(num_vnets, nullptr);
+    m_last_arrival[local_dest].resize(num_vnets, 0);
+
+    int link_id = addLink(-1, local_dest, link->m_latency, link,
+                          routing_table_entry);
+    m_router_out_links[src].push_back(link_id);
+}
+
+// From an endpoint node to a switch
+void
+FastNetwork::makeExtInLink(NodeID global_src, SwitchID dest, BasicLink* link,
+                           std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_src = getLocalNodeID(global_src);
+    assert(local_src < m_nodes);
+    assert(dest < m_router_latency.size());
+
+    int link_id = addLink(dest, 0, link->m_latency + m_router_latency[dest],
+                          link, routing_table_entry);
+
+    // A node injects through its first link only
+    if (m_node_in_link[local_src] != -1)
+        return;
+
+    m_node_in_link[local_src] = link_id;
+    m_node_ports[local_src] = std::make_unique<NodePort>(this, local_src);
+    for (auto *buffer : m_toNetQueues[local_src]) {
+        if (buffer)
+            buffer->setConsumer(m_node_ports[local_src].get());
+    }
+}
+
+// From a switch to a switch
+void
+FastNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
+                              std::vector<NetDest>& routing_table_entry,
+                              PortDirection src_outport,
+                              PortDirection dst_inport)
+{
+    assert(src < m_router_out_links.size());
+    assert(dest < m_router_latency.size());
+
+    int link_id = addLink(dest, 0, link->m_latency + m_router_latency[dest],
+                          link, routing_table_entry);
+    m_router_out_links[src].push_back(link_id);
+}
+
+/*
+ * Move every ready message from the node's buffers into the network. A
+ * message that cannot be delivered because a destination buffer is full
+ * blocks its vnet, and the node is woken again next cycle.
+ */
+void
+FastNetwork::inject(NodeID node)
+{
+    Tick current_time = curTick();
+    bool stalled = false;
+
+    for (int vnet = 0; vnet < m_toNetQueues[node].size(); vnet++) {
+        MessageBuffer *buffer = m_toNetQueues[node][vnet];
+        if (!buffer)
+            continue;
+
+        while (buffer->isReady(current_time)) {
+            MsgPtr msg = buffer->peekMsgPtr();
+            if (!canDeliver(msg, vnet)) {
+                stalled = true;
+                break;
+            }
+            // dequeue before delivering, as a unicast is delivered as is
+            // and enqueueing it updates its last enqueue time
+            buffer->dequeue(current_time);
+            deliver(node, msg, vnet);
+        }
+    }
+
+    if (stalled) {
+        networkStats.stallCycles++;
+        m_node_ports[node]->scheduleEvent(Cycles(1));
+    }
+}
+
+bool
+FastNetwork::canDeliver(const MsgPtr &msg, int vnet) const
+{
+    for (MachineID dest : msg->getDestination()) {
+        NodeID local_dest = getLocalNodeID(
+            MachineType_base_number(dest.type) + dest.num);
+        panic_if(vnet >= m_fromNetQueues[local_dest].size() ||
+                 !m_fromNetQueues[local_dest][vnet],
+                 "%s: no buffer for vnet %d at %s", name(), vnet, dest);
+        if (!m_fromNetQueues[local_dest][vnet]->areNSlotsAvailable(
+                1, curTick())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+FastNetwork::deliver(NodeID src, const MsgPtr &msg, int vnet)
+{
+    const NetDest &dests = msg->getDestination();
+    int bytes = MessageSizeType_to_int(msg->getMessageSize());
+    bool multicast = dests.count() > 1;
+
+    // A multicast is charged to every link of every destination's path,
+    // so links shared by several destinations are counted more than once
+    for (MachineID dest : dests) {
+        NodeID local_dest = getLocalNodeID(
+            MachineType_base_number(dest.type) + dest.num);
+        const Path &path = getPath(src, dest, vnet);
+
+        double queueing = 0;
+        for (int link_id : path.links)
+            queueing += m_links[link_id].queue.wait(curCycle(), bytes);
+
+        Cycles latency = path.latency +
+            Cycles(divCeil(bytes, path.bottleneck)) +
+            Cycles(std::ceil(queueing));
+        Tick arrival = clockEdge(latency);
+
+        MessageBuffer *buffer = m_fromNetQueues[local_dest][vnet];
+        if (buffer->getOrdered()) {
+            arrival = std::max(arrival, m_last_arrival[local_dest][vnet]);
+            m_last_arrival[local_dest][vnet] = arrival;
+        }
+
+        MsgPtr out_msg = msg;
+        if (multicast) {
+            out_msg = msg->clone();
+            NetDest personal_dest;
+            personal_dest.add(dest);
+            out_msg->getDestination() = personal_dest;
+        }
+
+        DPRINTF(RubyNetwork, "Node %d to %s vnet %d: %d cycles "
+                "(%d queueing)\n", src, dest, vnet, latency,
+                Cycles(std::ceil(queueing)));
+
+        buffer->enqueue(out_msg, curTick(), arrival - curTick());
+
+        networkStats.msgCount++;
+        networkStats.msgBytes += bytes;
+        networkStats.totalLatency += latency;
+        networkStats.totalQueueingLatency += queueing;
+    }
+}
+
+const FastNetwork::Path &
+FastNetwork::getPath(NodeID src, MachineID dest, int vnet)
+{
+    NodeID global_dest = MachineType_base_number(dest.type) + dest.num;
+    uint64_t key = (uint64_t(src) * m_nodes + getLocalNodeID(global_dest)) *
+        m_virtual_networks + vnet;
+    auto it = m_paths.find(key);
+    if (it != m_paths.end())
+        return it->second;
+
+    Path &path = m_paths[key];
+    int link_id = m_node_in_link[src];
+    fatal_if(link_id == -1, "%s: node %d has no link into the network",
+             name(), src);
+    path.bottleneck = m_links[link_id].queue.bandwidth();
+
+    // A route can visit each router at most once
+    for (int hops = 0; ; hops++) {
+        panic_if(hops > m_router_out_links.size(),
+                 "%s: routing loop from node %d to %s on vnet %d",
+                 name(), src, dest, vnet);
+
+        const Link &link = m_links[link_id];
+        path.links.push_back(link_id);
+        path.latency += link.latency;
+        path.bottleneck = std::min(path.bottleneck,
+                                   link.queue.bandwidth());
+
+        if (link.destRouter == -1)
+            break;
+        link_id = selectOutLink(link.destRouter, dest, vnet);
+    }
+
+    return path;
+}
+
+// Pick the lowest weight output link that leads to the destination, as
+// the topology's shortest path routing intends
+int
+FastNetwork::selectOutLink(int router, MachineID dest, int vnet) const
+{
+    int best = -1;
+    for (int link_id : m_router_out_links[router]) {
+        const Link &link = m_links[link_id];
+        if (vnet >= link.routes.size() || !link.routes[vnet].isElement(dest))
+            continue;
+        if (best == -1 || link.weight < m_links[best].weight)
+            best = link_id;
+    }
+    fatal_if(best == -1, "%s: no route from router %d to %s on vnet %d",
+             name(), router, dest, vnet);
+    return best;
+}
+
+void
+FastNetwork::print(std::ostream& out) const
+{
+    out << "[FastNetwork]";
+}
+
+void
+FastNetwork::NodePort::print(std::ostream& out) const
+{
+    out << "[FastNetwork port " << m_node << "]";
+}
+
+FastNetwork::
+NetworkStats::NetworkStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(msgCount, statistics::units::Count::get(),
+        "Number of messages delivered, one per destination"),
+      ADD_STAT(msgBytes, statistics::units::Byte::get(),
+        "Number of bytes delivered"),
+      ADD_STAT(totalLatency, statistics::units::Cycle::get(),
+        "Total network latency of the delivered messages"),
+      ADD_STAT(totalQueueingLatency, statistics::units::Cycle::get(),
+        "Total modelled queuing delay of the delivered messages"),
+      ADD_STAT(stallCycles, statistics::units::Cycle::get(),
+        "Cycles a node was blocked by a full destination buffer"),
+      ADD_STAT(avgLatency, statistics::units::Rate<
+            statistics::units::Cycle, statistics::units::Count>::get(),
+        "Average network latency per message"),
+      ADD_STAT(avgQueueingLatency, statistics::units::Rate<
+            statistics::units::Cycle, statistics::units::Count>::get(),
+        "Average modelled queuing delay per message")
+{
+    avgLatency = totalLatency / msgCount;
+    avgQueueingLatency = totalQueueingLatency / msgCount;
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_FAST_FASTNETWORK_HH__
+#define __MEM_RUBY_NETWORK_FAST_FASTNETWORK_HH__
+
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/Network.hh"
+#include "mem/ruby/network/fast/LinkQueue.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+#include "params/FastNetwork.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+class MessageBuffer;
+
+/**
+ * An analytical, contention-aware network model.
+ *
+ * The network takes the routers and links of a regular Topology, but it
+ * does not model them cycle by cycle. When a message is injected, the
+ * network walks the topology's routing tables to find the path to each
+ * destination. The message latency is the sum of the link and router
+ * latencies along the path, plus the serialization delay at the
+ * narrowest link, plus a queuing delay for each link. Each link's
+ * queuing delay comes from an M/D/1 model fed by that link's
+ * utilization over the previous epoch. The message is then enqueued
+ * straight into the destination MessageBuffer with that delay.
+ */
+class FastNetwork : public Network
+{
+  public:
+    PARAMS(FastNetwork);
+
+    FastNetwork(const Params &p);
+    ~FastNetwork() = default;
+
+    void init() override;
+
+    // Methods used by Topology to setup the network
+    void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
+                     std::vector<NetDest>& routing_table_entry) override;
+    void makeExtInLink(NodeID src, SwitchID dest, BasicLink* link,
+                    std::vector<NetDest>& routing_table_entry) override;
+    void makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
+                          std::vector<NetDest>& routing_table_entry,
+                          PortDirection src_outport,
+                          PortDirection dst_inport) override;
+
+    void collateStats() override {}
+    void print(std::ostream& out) const override;
+
+    // Messages in flight already sit in the destination buffers, which
+    // the controllers cover, so the network itself holds nothing.
+    bool functionalRead(Packet *pkt) override { return false; }
+    bool
+    functionalRead(Packet *pkt, WriteMask &mask) override
+    {
+        return false;
+    }
+    uint32_t functionalWrite(Packet *pkt) override { return 0; }
+
+  private:
+    // Consumer of the buffers a node injects into
+    class NodePort : public Consumer
+    {
+      public:
+        NodePort(FastNetwork *net, NodeID node)
+            : Consumer(net), m_net(net), m_node(node)
+        {}
+
+        void wakeup() override { m_net->inject(m_node); }
+        void print(std::ostream& out) const override;
+
+      private:
+        FastNetwork *m_net;
+        NodeID m_node;
+    };
+
+    struct Link
+    {
+        // Router at the far end, or -1 for a link to an endpoint node
+        int destRouter;
+        NodeID destNode;
+        // Link latency plus the latency of the router it feeds
+        Cycles latency;
+        int weight;
+        std::vector<NetDest> routes;
+        LinkQueue queue;
+    };
+
+    struct Path
+    {
+        std::vector<int> links;
+        Cycles latency = Cycles(0);
+        int bottleneck = 0;
+    };
+
+    void inject(NodeID node);
+    bool canDeliver(const MsgPtr &msg, int vnet) const;
+    void deliver(NodeID src, const MsgPtr &msg, int vnet);
+
+    const Path &getPath(NodeID src, MachineID dest, int vnet);
+    int selectOutLink(int router, MachineID dest, int vnet) const;
+
+    int addLink(int dest_router, NodeID dest_node, Cycles latency,
+                BasicLink *link, std::vector<NetDest>& routing_table_entry);
+
+    // Private copy constructor and assignment operator
+    FastNetwork(const FastNetwork& obj);
+    FastNetwork& operator=(const FastNetwork& obj);
+
+    const Cycles m_epoch_length;
+    const double m_max_utilization;
+
+    // Indexed by router id
+    std::vector<Cycles> m_router_latency;
+    std::vector<std::vector<int>> m_router_out_links;
+
+    std::vector<Link> m_links;
+    // Link from each local node into the network, -1 if none
+    std::vector<int> m_node_in_link;
+    std::vector<std::unique_ptr<NodePort>> m_node_ports;
+    // Last arrival time per destination buffer, to keep ordered
+    // buffers FIFO
+    std::vector<std::vector<Tick>> m_last_arrival;
+
+    // Paths are found lazily, keyed by (source, destination, vnet)
+    std::unordered_map<uint64_t, Path> m_paths;
+
+    struct NetworkStats : public statistics::Group
+    {
+        NetworkStats(statistics::Group *parent);
+
+        statistics::Scalar msgCount;
+        statistics::Scalar msgBytes;
+        statistics::Scalar totalLatency;
+        statistics::Scalar totalQueueingLatency;
+        statistics::Scalar stallCycles;
+        statistics::Formula avgLatency;
+        statistics::Formula avgQueueingLatency;
+    } networkStats;
+};
+
+inline std::ostream&
+operator<<(std::ostream& out, const FastNetwork& obj)
+{
+    obj.print(out);
+    out << std::flush;
+    return out;
+}
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_FAST_FASTNETWORK_HH__
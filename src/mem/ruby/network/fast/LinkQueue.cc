@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/fast/LinkQueue.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+LinkQueue::LinkQueue(int bandwidth, Cycles epoch_length,
+                     double max_utilization)
+    : _bandwidth(bandwidth), epochLength(epoch_length),
+      maxUtilization(max_utilization)
+{
+    panic_if(bandwidth <= 0, "Link bandwidth must be positive");
+    panic_if(epoch_length == 0, "Epoch length must be non-zero");
+    panic_if(max_utilization <= 0 || max_utilization >= 1,
+             "Maximum utilization must be in (0, 1)");
+}
+
+double
+LinkQueue::wait(Cycles now, int bytes)
+{
+    uint64_t now_epoch = now / epochLength;
+    if (epoch != now_epoch) {
+        if (epoch + 1 == now_epoch && epochMsgs > 0) {
+            double capacity = double(_bandwidth) * epochLength;
+            double rho = std::min(epochBytes / capacity, maxUtilization);
+            double service = epochBytes / (epochMsgs * _bandwidth);
+            delay = rho / (2 * (1 - rho)) * service;
+        } else {
+            delay = 0;
+        }
+        epoch = now_epoch;
+        epochBytes = 0;
+        epochMsgs = 0;
+    }
+
+    epochBytes += bytes;
+    epochMsgs++;
+    return delay;
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_FAST_LINKQUEUE_HH__
+#define __MEM_RUBY_NETWORK_FAST_LINKQUEUE_HH__
+
+#include <cstdint>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * The queuing model of a FastNetwork link.
+ *
+ * The expected queuing delay only changes at epoch boundaries. When the
+ * first message of an epoch is accounted, the link's utilization over
+ * the epoch that just ended becomes the arrival rate of an M/D/1 queue
+ * whose service time is the mean time to send a message of that epoch.
+ * A link that was idle for a whole epoch starts again with no delay.
+ */
+class LinkQueue
+{
+  public:
+    /**
+     * @param bandwidth Bytes the link sends per cycle
+     * @param epoch_length Cycles over which utilization is measured
+     * @param max_utilization Utilization at which the delay saturates,
+     *        in (0, 1)
+     */
+    LinkQueue(int bandwidth, Cycles epoch_length, double max_utilization);
+
+    /**
+     * Account a message on the link.
+     *
+     * @param now Current cycle
+     * @param bytes Size of the message
+     * @return Expected queuing delay of the message, in cycles
+     */
+    double wait(Cycles now, int bytes);
+
+    int bandwidth() const { return _bandwidth; }
+
+  private:
+    const int _bandwidth;
+    const Cycles epochLength;
+    const double maxUtilization;
+
+    // Utilization of the current epoch and the delay derived from the
+    // previous one
+    uint64_t epoch = 0;
+    double epochBytes = 0;
+    uint64_t epochMsgs = 0;
+    double delay = 0;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_FAST_LINKQUEUE_HH__
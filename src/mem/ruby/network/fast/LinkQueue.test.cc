@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/ruby/network/fast/LinkQueue.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+/** Messages of the first epoch have nothing to queue behind. */
+TEST(LinkQueueTest, FirstEpoch)
+{
+    LinkQueue queue(16, Cycles(100), 0.9);
+    EXPECT_EQ(queue.bandwidth(), 16);
+    for (int cycle = 0; cycle < 100; cycle++)
+        EXPECT_EQ(queue.wait(Cycles(cycle), 64), 0);
+}
+
+/**
+ * The delay of an epoch is the M/D/1 waiting time for the utilization
+ * and the mean message size of the previous one, and doesn't change
+ * with the load of the epoch itself.
+ */
+TEST(LinkQueueTest, MD1Delay)
+{
+    LinkQueue queue(16, Cycles(100), 0.9);
+
+    // 800 of 1600 bytes: rho = 0.5, 1 cycle per message
+    for (int i = 0; i < 50; i++)
+        queue.wait(Cycles(2 * i), 16);
+    EXPECT_DOUBLE_EQ(queue.wait(Cycles(100), 16), 0.5);
+    for (int i = 1; i < 100; i++)
+        EXPECT_DOUBLE_EQ(queue.wait(Cycles(100 + i), 16), 0.5);
+
+    // 100 messages of 16 bytes were just sent: rho = 1 is capped at 0.9
+    EXPECT_DOUBLE_EQ(queue.wait(Cycles(200), 16), 0.9 / (2 * 0.1));
+
+    // 8 + 72 bytes: rho = 80 / 1600, 2.5 cycles per message
+    LinkQueue mixed(16, Cycles(100), 0.9);
+    mixed.wait(Cycles(10), 8);
+    mixed.wait(Cycles(20), 72);
+    EXPECT_DOUBLE_EQ(mixed.wait(Cycles(150), 8),
+                     0.05 / (2 * 0.95) * 2.5);
+}
+
+/** A whole idle epoch drains the queue. */
+TEST(LinkQueueTest, IdleEpoch)
+{
+    LinkQueue queue(8, Cycles(10), 0.95);
+    for (int i = 0; i < 10; i++)
+        queue.wait(Cycles(i), 8);
+    EXPECT_GT(queue.wait(Cycles(10), 8), 0);
+
+    // Nothing is sent in cycles 20 to 29
+    EXPECT_EQ(queue.wait(Cycles(30), 8), 0);
+    EXPECT_EQ(queue.wait(Cycles(39), 8), 0);
+
+    // The two messages of cycles 30 to 39 set the next delay
+    EXPECT_DOUBLE_EQ(queue.wait(Cycles(40), 8), 0.2 / (2 * 0.8));
+}
+
+/** Links must be able to send something, and must not saturate. */
+TEST(LinkQueueTest, BadParams)
+{
+    EXPECT_ANY_THROW(LinkQueue(0, Cycles(10), 0.5));
+    EXPECT_ANY_THROW(LinkQueue(8, Cycles(0), 0.5));
+    EXPECT_ANY_THROW(LinkQueue(8, Cycles(10), 0));
+    EXPECT_ANY_THROW(LinkQueue(8, Cycles(10), 1));
+}
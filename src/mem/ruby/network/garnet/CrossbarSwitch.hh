@@ -63,6 +63,7 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_num_buffered_flits++;
     }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
@@ -76,6 +77,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    // Number of flits across all switchBuffers
+    int m_num_buffered_flits;
 };
 
 } // namespace garnet
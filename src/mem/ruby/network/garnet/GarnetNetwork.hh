@@ -32,7 +32,9 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/network/Network.hh"
@@ -117,6 +119,13 @@ class GarnetNetwork : public Network
     void resetStats();
     void print(std::ostream& out) const;
 
+    /**
+     * Protects the counters below, which network interfaces in
+     * different partitions update concurrently when Ruby runs on
+     * several event queues.
+     */
+    std::mutex &statsMutex() { return m_stats_mutex; }
+
     // increment counters
     void increment_injected_packets(int vnet) { m_packets_injected[vnet]++; }
     void increment_received_packets(int vnet) { m_packets_received[vnet]++; }
@@ -155,7 +164,11 @@ class GarnetNetwork : public Network
     }
 
     void update_traffic_distribution(RouteInfo route);
-    int getNextPacketID() { return m_next_packet_id++; }
+    int
+    getNextPacketID()
+    {
+        return m_next_packet_id.fetch_add(1, std::memory_order_relaxed);
+    }
 
   protected:
     // Configuration
@@ -213,7 +226,9 @@ class GarnetNetwork : public Network
     std::vector<NetworkBridge *> m_networkbridges; // All network bridges
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
-    int m_next_packet_id; // static vairable for packet id allocation
+    // static vairable for packet id allocation
+    std::atomic<int> m_next_packet_id;
+    std::mutex m_stats_mutex;
 };
 
 inline std::ostream&
@@ -31,6 +31,9 @@
 
 #include "mem/ruby/network/garnet/InputUnit.hh"
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/Credit.hh"
 #include "mem/ruby/network/garnet/Router.hh"
@@ -46,7 +49,7 @@ namespace garnet
 
 InputUnit::InputUnit(int id, PortDirection direction, Router *router)
   : Consumer(router), m_router(router), m_id(id), m_direction(direction),
-    m_vc_per_vnet(m_router->get_vc_per_vnet())
+    m_vc_per_vnet(m_router->get_vc_per_vnet()), m_num_occupied_vcs(0)
 {
     const int m_num_vcs = m_router->get_num_vcs();
     m_num_buffer_reads.resize(m_num_vcs/m_vc_per_vnet);
@@ -61,6 +64,7 @@ InputUnit::InputUnit(int id, PortDirection direction, Router *router)
     for (int i=0; i < m_num_vcs; i++) {
         virtualChannels.emplace_back();
     }
+    m_occupied_vcs.resize(divCeil(m_num_vcs, 64), 0);
 }
 
 /*
@@ -109,6 +113,7 @@ InputUnit::wakeup()
 
         // Buffer the flit
         virtualChannels[vc].insertFlit(t_flit);
+        set_vc_occupied(vc);
 
         int vnet = vc/m_vc_per_vnet;
         // number of writes same as reads
@@ -139,6 +144,31 @@ InputUnit::wakeup()
     }
 }
 
+int
+InputUnit::next_occupied_vc(int vc) const
+{
+    if (m_num_occupied_vcs == 0)
+        return -1;
+
+    const int num_words = m_occupied_vcs.size();
+    const int num_vcs = virtualChannels.size();
+    if (vc >= num_vcs)
+        vc = 0;
+
+    // Scan from vc to the end, then wrap around to the start. The word
+    // holding vc is visited twice, masked differently each time.
+    int word = vc / 64;
+    uint64_t bits = m_occupied_vcs[word] & (~0ULL << (vc % 64));
+    for (int i = 0; i <= num_words; i++) {
+        if (bits)
+            return word * 64 + findLsbSet(bits);
+        word = (word + 1) % num_words;
+        bits = m_occupied_vcs[word];
+    }
+
+    panic("Occupied VC count and bitmap are out of sync");
+}
+
 // Send a credit back to upstream router for this VC.
 // Called by SwitchAllocator when the flit in this VC wins the Switch.
 void
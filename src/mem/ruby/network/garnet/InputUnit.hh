@@ -32,6 +32,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_INPUTUNIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_INPUTUNIT_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -116,9 +117,24 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
-        return virtualChannels[vc].getTopFlit();
+        flit *t_flit = virtualChannels[vc].getTopFlit();
+        if (virtualChannels[vc].isEmpty())
+            clear_vc_occupied(vc);
+        return t_flit;
     }
 
+    // True if any input VC is holding a flit
+    inline bool has_occupied_vc() const { return m_num_occupied_vcs > 0; }
+
+    /**
+     * Find the first VC at or after vc, wrapping around, that holds a
+     * flit. This lets the switch allocator visit only occupied VCs while
+     * keeping its round-robin order.
+     *
+     * @return The VC, or -1 if all VCs are empty.
+     */
+    int next_occupied_vc(int vc) const;
+
     inline bool
     need_stage(int vc, flit_stage stage, Tick time)
     {
@@ -169,6 +185,32 @@ class InputUnit : public Consumer
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
 
+    // Bitmap of the input VCs that hold at least one flit
+    std::vector<uint64_t> m_occupied_vcs;
+    int m_num_occupied_vcs;
+
+    inline void
+    set_vc_occupied(int vc)
+    {
+        uint64_t &word = m_occupied_vcs[vc / 64];
+        uint64_t bit = 1ULL << (vc % 64);
+        if (!(word & bit)) {
+            word |= bit;
+            m_num_occupied_vcs++;
+        }
+    }
+
+    inline void
+    clear_vc_occupied(int vc)
+    {
+        uint64_t &word = m_occupied_vcs[vc / 64];
+        uint64_t bit = 1ULL << (vc % 64);
+        if (word & bit) {
+            word &= ~bit;
+            m_num_occupied_vcs--;
+        }
+    }
+
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
     std::vector<double> m_num_buffer_reads;
@@ -95,6 +95,17 @@ NetworkBridge::~NetworkBridge()
 {
 }
 
+void
+NetworkBridge::startup()
+{
+    // A bridge works on the clock of its consumer, so both have to be
+    // in the same partition
+    fatal_if(numMainEventQueues > 1 && link_consumer &&
+             link_consumer->getObject()->eventQueue() != eventQueue(),
+             "%s: Bridges can't connect different Ruby partitions.\n",
+             name());
+}
+
 void
 NetworkBridge::scheduleFlit(flit *t_flit, Cycles latency)
 {
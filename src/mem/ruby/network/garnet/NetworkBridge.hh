@@ -64,6 +64,8 @@ class NetworkBridge: public CreditLink
 
     void initBridge(NetworkBridge *coBrid, bool cdc_en, bool serdes_en);
 
+    void startup() override;
+
     void wakeup();
     void neutralize(int vc, int eCredit);
 
@@ -34,6 +34,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <mutex>
 
 #include "base/cast.hh"
 #include "debug/RubyNetwork.hh"
@@ -155,6 +156,8 @@ NetworkInterface::incrementStats(flit *t_flit)
 {
     int vnet = t_flit->get_vnet();
 
+    std::lock_guard<std::mutex> lock(m_net_ptr->statsMutex());
+
     // Latency
     m_net_ptr->increment_received_flits(vnet);
     Tick network_delay =
@@ -369,10 +372,10 @@ bool
 NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
 {
     Message *net_msg_ptr = msg_ptr.get();
-    NetDest net_msg_dest = net_msg_ptr->getDestination();
+    const NetDest net_msg_dest = net_msg_ptr->getDestination();
 
-    // gets all the destinations associated with this message.
-    std::vector<NodeID> dest_nodes = net_msg_dest.getAllDest();
+    // gets the number of destinations associated with this message.
+    int num_dests = net_msg_dest.count();
 
     // Number of flits is dependent on the link bandwidth available.
     // This is expressed in terms of bytes/cycle or the flit size
@@ -386,7 +389,7 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         vnet, oPort->bitWidth());
 
     // loop to convert all multicast messages into unicast messages
-    for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
+    for (MachineID dest : net_msg_dest) {
 
         // this will return a free output virtual channel
         int vc = calculateVC(vnet);
@@ -395,23 +398,14 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
             return false ;
         }
         MsgPtr new_msg_ptr = msg_ptr->clone();
-        NodeID destID = dest_nodes[ctr];
+        NodeID destID = MachineType_base_number(dest.type) + dest.num;
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
-        if (dest_nodes.size() > 1) {
+        if (num_dests > 1) {
+            // calculating the NetDest associated with this destID
             NetDest personal_dest;
-            for (int m = 0; m < (int) MachineType_NUM; m++) {
-                if ((destID >= MachineType_base_number((MachineType) m)) &&
-                    destID < MachineType_base_number((MachineType) (m+1))) {
-                    // calculating the NetDest associated with this destID
-                    personal_dest.clear();
-                    personal_dest.add((MachineID) {(MachineType) m, (destID -
-                        MachineType_base_number((MachineType) m))});
-                    new_net_msg_ptr->getDestination() = personal_dest;
-                    break;
-                }
-            }
-            net_msg_dest.removeNetDest(personal_dest);
+            personal_dest.add(dest);
+            new_net_msg_ptr->getDestination() = personal_dest;
             // removing the destination from the original message to reflect
             // that a message with this particular destination has been
             // flitisized and an output vc is acquired
@@ -434,11 +428,15 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         // so that the first router increments it to 0
         route.hops_traversed = -1;
 
-        m_net_ptr->increment_injected_packets(vnet);
-        m_net_ptr->update_traffic_distribution(route);
+        {
+            std::lock_guard<std::mutex> lock(m_net_ptr->statsMutex());
+            m_net_ptr->increment_injected_packets(vnet);
+            m_net_ptr->update_traffic_distribution(route);
+            for (int i = 0; i < num_flits; i++)
+                m_net_ptr->increment_injected_flits(vnet);
+        }
         int packet_id = m_net_ptr->getNextPacketID();
         for (int i = 0; i < num_flits; i++) {
-            m_net_ptr->increment_injected_flits(vnet);
             flit *fl = new flit(packet_id,
                 i, vc, vnet, route, num_flits, new_msg_ptr,
                 m_net_ptr->MessageSizeType_to_int(
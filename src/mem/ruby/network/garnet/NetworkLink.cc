@@ -32,9 +32,12 @@
 
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -48,8 +51,8 @@ namespace garnet
 NetworkLink::NetworkLink(const Params &p)
     : ClockedObject(p), Consumer(this), m_id(p.link_id),
       m_type(NUM_LINK_TYPES_),
-      m_latency(p.link_latency), m_link_utilized(0),
-      m_virt_nets(p.virt_nets), linkBuffer(),
+      m_latency(p.link_latency), src_object(nullptr), m_link_utilized(0),
+      m_remote_consumer(false), m_virt_nets(p.virt_nets), linkBuffer(),
       link_consumer(nullptr), link_srcQueue(nullptr)
 {
     int num_vnets = (p.supported_vnets).size();
@@ -79,6 +82,44 @@ NetworkLink::setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObj)
     src_object = srcClockObj;
 }
 
+void
+NetworkLink::startup()
+{
+    // Links that aren't connected (e.g., unused bridges) and links
+    // within a partition need nothing
+    if (numMainEventQueues == 1 || !link_consumer ||
+        link_consumer->getObject()->eventQueue() == eventQueue()) {
+        return;
+    }
+
+    fatal_if(src_object && src_object->eventQueue() != eventQueue(),
+             "%s: A link between Ruby partitions must be on the event "
+             "queue of its source %s.\n", name(), src_object->name());
+
+    const Tick lookahead = cyclesToTicks(m_latency);
+    fatal_if(std::max(simQuantum, simQuantumMax) > lookahead,
+             "%s: The quantum (%d ticks) must not be longer than the latency "
+             "of links between Ruby partitions (%d ticks).\n",
+             name(), std::max(simQuantum, simQuantumMax), lookahead);
+
+    m_remote_consumer = true;
+    link_consumer->getObject()->eventQueue()->addBarrierCallback(
+        [this]() { deliverRemoteFlits(); });
+}
+
+void
+NetworkLink::deliverRemoteFlits()
+{
+    m_remote_flits.drain([this](std::vector<flit *> &flits) {
+        for (flit *t_flit : flits) {
+            panic_if(t_flit->get_time() < curTick(),
+                     "%s: Flit for another partition is late.\n", name());
+            linkBuffer.insert(t_flit);
+            link_consumer->scheduleEventAbsolute(t_flit->get_time());
+        }
+    });
+}
+
 void
 NetworkLink::wakeup()
 {
@@ -98,8 +139,12 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (m_remote_consumer) {
+            m_remote_flits.post(t_flit);
+        } else {
+            linkBuffer.insert(t_flit);
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
@@ -122,13 +167,23 @@ NetworkLink::resetStats()
 bool
 NetworkLink::functionalRead(Packet *pkt, WriteMask &mask)
 {
-    return linkBuffer.functionalRead(pkt, mask);
+    bool read = linkBuffer.functionalRead(pkt, mask);
+    m_remote_flits.forEach([&](flit *t_flit) {
+        if (t_flit->functionalRead(pkt, mask))
+            read = true;
+    });
+    return read;
 }
 
 uint32_t
 NetworkLink::functionalWrite(Packet *pkt)
 {
-    return linkBuffer.functionalWrite(pkt);
+    uint32_t num_functional_writes = linkBuffer.functionalWrite(pkt);
+    m_remote_flits.forEach([&](flit *t_flit) {
+        if (t_flit->functionalWrite(pkt))
+            num_functional_writes++;
+    });
+    return num_functional_writes;
 }
 
 } // namespace garnet
@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/PartitionInbox.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 #include "params/NetworkLink.hh"
@@ -60,6 +61,8 @@ class NetworkLink : public ClockedObject, public Consumer
     NetworkLink(const Params &p);
     ~NetworkLink() = default;
 
+    void startup() override;
+
     void setLinkConsumer(Consumer *consumer);
     void setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObject);
     virtual void setVcsPerVnet(uint32_t consumerVcs);
@@ -99,6 +102,18 @@ class NetworkLink : public ClockedObject, public Consumer
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
 
+    /**
+     * Flits for a consumer in another partition (i.e., on another
+     * event queue) when Ruby runs on several threads. The link runs in
+     * the partition of its source, and its latency is the lookahead
+     * that lets the flits be delivered at the end of the quantum.
+     */
+    bool m_remote_consumer;
+    PartitionInbox<flit *> m_remote_flits;
+
+    /** Insert the flits sent during the last quantum in linkBuffer. */
+    void deliverRemoteFlits();
+
   protected:
     uint32_t m_virt_nets;
     flitBuffer linkBuffer;
@@ -55,6 +55,7 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+    m_num_port_requests = 0;
 }
 
 void
@@ -113,11 +114,15 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
-        int invc = m_round_robin_invc[inport];
+        auto input_unit = m_router->getInputUnit(inport);
 
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
+        // Only VCs holding a flit can be in SA, so visit just those,
+        // in round robin order from the last winner
+        int first_vc =
+            input_unit->next_occupied_vc(m_round_robin_invc[inport]);
+        int invc = first_vc;
 
+        while (invc != -1) {
             if (input_unit->need_stage(invc, SA_, curTick())) {
                 // This flit is in SA stage
 
@@ -133,14 +138,15 @@ SwitchAllocator::arbitrate_inports()
                     m_input_arbiter_activity++;
                     m_port_requests[inport] = outport;
                     m_vc_winners[inport] = invc;
+                    m_num_port_requests++;
 
                     break; // got one vc winner for this port
                 }
             }
 
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
+            invc = input_unit->next_occupied_vc(invc + 1);
+            if (invc == first_vc)
+                break;
         }
     }
 }
@@ -165,7 +171,12 @@ SwitchAllocator::arbitrate_outports()
     // Now there are a set of input vc requests for output vcs.
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
+    int pending_requests = m_num_port_requests;
     for (int outport = 0; outport < m_num_outports; outport++) {
+        // Every request has been granted, the other outports are idle
+        if (pending_requests == 0)
+            break;
+
         int inport = m_round_robin_inport[outport];
 
         for (int inport_iter = 0; inport_iter < m_num_inports;
@@ -241,6 +252,7 @@ SwitchAllocator::arbitrate_outports()
 
                 // remove this request
                 m_port_requests[inport] = -1;
+                pending_requests--;
 
                 // Update Round Robin pointer
                 m_round_robin_inport[outport] = inport + 1;
@@ -363,11 +375,17 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+        auto input_unit = m_router->getInputUnit(i);
+        int first_vc = input_unit->next_occupied_vc(0);
+        int j = first_vc;
+        while (j != -1) {
+            if (input_unit->need_stage(j, SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
+            j = input_unit->next_occupied_vc(j + 1);
+            if (j == first_vc)
+                break;
         }
     }
 }
@@ -387,6 +405,7 @@ void
 SwitchAllocator::clear_request_vector()
 {
     std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    m_num_port_requests = 0;
 }
 
 void
@@ -90,6 +90,8 @@ class SwitchAllocator : public Consumer
     std::vector<int> m_round_robin_inport;
     std::vector<int> m_port_requests;
     std::vector<int> m_vc_winners;
+    // Number of inports with a request in m_port_requests
+    int m_num_port_requests;
 };
 
 } // namespace garnet
@@ -274,7 +274,7 @@ AbstractController::serviceMemoryQueue()
     }
 
     RequestPtr req
-        = std::make_shared<Request>(mem_msg->m_addr, req_size, 0, m_id);
+        = Request::create(mem_msg->m_addr, req_size, 0, m_id);
     PacketPtr pkt;
     if (mem_msg->getType() == MemoryRequestType_MEMORY_WB) {
         pkt = Packet::createWrite(req);
@@ -382,7 +382,7 @@ AbstractController::recvTimingResp(PacketPtr pkt)
         return false;
     }
 
-    std::shared_ptr<MemoryMsg> msg = std::make_shared<MemoryMsg>(clockEdge());
+    RefCountingPtr<MemoryMsg> msg = new MemoryMsg(clockEdge());
     (*msg).m_addr = pkt->getAddr();
     (*msg).m_Sender = m_machineID;
 
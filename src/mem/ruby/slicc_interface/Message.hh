@@ -42,9 +42,10 @@
 #define __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 
 #include <iostream>
-#include <memory>
 #include <stack>
 
+#include "base/pool_alloc.hh"
+#include "base/refcnt.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -57,9 +58,15 @@ namespace ruby
 {
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
 
-class Message
+/**
+ * Messages are reference counted with a plain (non-atomic) counter in
+ * the message itself. A message is only ever handled by the thread of
+ * the event queue it is on.
+ */
+typedef RefCountingPtr<Message> MsgPtr;
+
+class Message : public RefCounted
 {
   public:
     Message(Tick curTime)
@@ -68,7 +75,28 @@ class Message
           m_DelayedTicks(0), m_msg_counter(0)
     { }
 
-    Message(const Message &other) = default;
+    // The copy gets a reference count of its own
+    Message(const Message &other)
+        : RefCounted(),
+          m_time(other.m_time),
+          m_LastEnqueueTime(other.m_LastEnqueueTime),
+          m_DelayedTicks(other.m_DelayedTicks),
+          m_msg_counter(other.m_msg_counter),
+          incoming_link(other.incoming_link),
+          vnet(other.vnet)
+    { }
+
+    Message &
+    operator=(const Message &other)
+    {
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        incoming_link = other.incoming_link;
+        vnet = other.vnet;
+        return *this;
+    }
 
     virtual ~Message() { }
 
@@ -121,6 +149,37 @@ class Message
     int getVnet() const { return vnet; }
     void setVnet(int net) { vnet = net; }
 
+    //! Link to the next message in an intrusive list (e.g., of the
+    //! messages stalled on a line). It is not copied with the message.
+    const MsgPtr &getNext() const { return m_next; }
+    void setNext(const MsgPtr &next) { m_next = next; }
+
+  protected:
+    /**
+     * @{
+     * Helpers for message types that define a class specific operator
+     * new and delete to be allocated from a recycling pool of their
+     * own. Objects of other sizes (e.g., of a derived type) are
+     * allocated on the heap.
+     */
+    static void *
+    poolAllocate(PoolAllocator &pool, size_t size)
+    {
+        if (size == pool.blockSize())
+            return pool.allocate();
+        return ::operator new(size);
+    }
+
+    static void
+    poolDeallocate(PoolAllocator &pool, void *p, size_t size)
+    {
+        if (size == pool.blockSize())
+            pool.deallocate(p);
+        else
+            ::operator delete(p);
+    }
+    /** @} */
+
   private:
     Tick m_time;
     Tick m_LastEnqueueTime; // my last enqueue time
@@ -130,6 +189,8 @@ class Message
     // Variables for required network traversal
     int incoming_link;
     int vnet;
+
+    MsgPtr m_next;
 };
 
 inline bool
@@ -50,6 +50,8 @@ namespace gem5
 namespace ruby
 {
 
+PoolAllocator RubyRequest::pool("rubyRequest", sizeof(RubyRequest));
+
 void
 RubyRequest::print(std::ostream& out) const
 {
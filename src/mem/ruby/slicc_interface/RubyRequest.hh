@@ -60,6 +60,9 @@ namespace ruby
 
 class RubyRequest : public Message
 {
+  private:
+    static PoolAllocator pool;
+
   public:
     Addr m_PhysicalAddress;
     Addr m_LineAddress;
@@ -220,7 +223,19 @@ class RubyRequest : public Message
 
     RubyRequest(Tick curTime) : Message(curTime) {}
     MsgPtr clone() const
-    { return std::shared_ptr<Message>(new RubyRequest(*this)); }
+    { return MsgPtr(new RubyRequest(*this)); }
+
+    static void *
+    operator new(size_t size)
+    {
+        return poolAllocate(pool, size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        poolDeallocate(pool, p, size);
+    }
 
     Addr getLineAddress() const { return m_LineAddress; }
     Addr getPhysicalAddress() const { return m_PhysicalAddress; }
@@ -99,6 +99,7 @@ CacheMemory::init()
     m_cache_num_set_bits = floorLog2(m_cache_num_sets);
     assert(m_cache_num_set_bits > 0);
 
+    m_tag_index.init(m_cache_num_sets, m_cache_assoc);
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
     replacement_data.resize(m_cache_num_sets,
@@ -139,11 +140,10 @@ CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = m_tag_index.find(cacheSet, tag);
+    if (loc != -1 &&
+        m_cache[cacheSet][loc]->m_Permission != AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -155,10 +155,7 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
-    return -1; // Not found
+    return m_tag_index.find(cacheSet, tag);
 }
 
 // Given an unique cache block identifier (idx): return the valid address
@@ -304,7 +301,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: 0x%x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tag_index.insert(cacheSet, i, address);
             set[i]->setPosition(cacheSet, i);
             set[i]->replacementData = replacement_data[cacheSet][i];
             set[i]->setLastAccess(curTick());
@@ -330,7 +327,7 @@ CacheMemory::deallocate(Addr address)
     uint32_t way = entry->getWay();
     delete entry;
     m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    m_tag_index.erase(cache_set, way);
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -43,7 +43,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -57,6 +56,7 @@
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/structures/BankedArray.hh"
 #include "mem/ruby/structures/ALUFreeListArray.hh"
+#include "mem/ruby/structures/CacheTagIndex.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubyCache.hh"
 #include "sim/sim_object.hh"
@@ -179,7 +179,7 @@ class CacheMemory : public SimObject
 
     // The first index is the # of cache lines.
     // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
+    CacheTagIndex m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
     /** We use the replacement policies from the Classic memory system. */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_CACHETAGINDEX_HH__
+#define __MEM_RUBY_STRUCTURES_CACHETAGINDEX_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Maps the line addresses held by a set-associative cache to their
+ * way. The tags of the ways of each set are stored next to each other
+ * in a single array, so a lookup is a short linear scan over one or
+ * two host cache lines instead of a hash table probe.
+ */
+class CacheTagIndex
+{
+  private:
+    /** Tag of an unused way. Never a valid line address. */
+    static constexpr Addr InvalidTag = MaxAddr;
+
+    std::vector<Addr> tags;
+    int assoc = 0;
+
+  public:
+    void
+    init(int num_sets, int _assoc)
+    {
+        assoc = _assoc;
+        tags.assign((size_t)num_sets * assoc, InvalidTag);
+    }
+
+    /** Return the way holding the given line, or -1 if there is none. */
+    int
+    find(int64_t set, Addr line) const
+    {
+        const Addr *set_tags = &tags[set * assoc];
+        for (int way = 0; way < assoc; way++) {
+            if (set_tags[way] == line)
+                return way;
+        }
+        return -1;
+    }
+
+    void
+    insert(int64_t set, int way, Addr line)
+    {
+        assert(line != InvalidTag);
+        tags[set * assoc + way] = line;
+    }
+
+    void
+    erase(int64_t set, int way)
+    {
+        tags[set * assoc + way] = InvalidTag;
+    }
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_CACHETAGINDEX_HH__
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_LINEREQUESTTABLE_HH__
+#define __MEM_RUBY_STRUCTURES_LINEREQUESTTABLE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "mem/ruby/common/Address.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * A table of outstanding requests keyed by cache line address. Each line
+ * holds a FIFO of requests, oldest first.
+ *
+ * Lines are kept in an open-addressed, linearly probed hash table sized
+ * for the expected number of outstanding requests. The per-line lists and
+ * their request nodes come from free lists that are pre-populated for the
+ * same number of requests, so a table that stays within its expected size
+ * never allocates after construction. Exceeding it is still legal: the
+ * pools and the hash table grow on demand.
+ *
+ * A reference to a line's list stays valid until that line is erased,
+ * even if other lines are inserted or erased in the meantime.
+ */
+template<class REQUEST>
+class LineRequestTable
+{
+  private:
+    struct Node
+    {
+        alignas(REQUEST) unsigned char storage[sizeof(REQUEST)];
+        Node *next = nullptr;
+
+        REQUEST &value() { return *reinterpret_cast<REQUEST *>(storage); }
+
+        const REQUEST &
+        value() const
+        {
+            return *reinterpret_cast<const REQUEST *>(storage);
+        }
+    };
+
+  public:
+    class RequestList
+    {
+      public:
+        class const_iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = REQUEST;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const REQUEST *;
+            using reference = const REQUEST &;
+
+            explicit const_iterator(const Node *node) : m_node(node) {}
+
+            reference operator*() const { return m_node->value(); }
+            pointer operator->() const { return &m_node->value(); }
+
+            const_iterator &
+            operator++()
+            {
+                m_node = m_node->next;
+                return *this;
+            }
+
+            bool
+            operator==(const const_iterator &other) const
+            {
+                return m_node == other.m_node;
+            }
+
+            bool
+            operator!=(const const_iterator &other) const
+            {
+                return m_node != other.m_node;
+            }
+
+          private:
+            const Node *m_node;
+        };
+
+        bool empty() const { return m_head == nullptr; }
+        size_t size() const { return m_size; }
+
+        REQUEST &
+        front()
+        {
+            assert(!empty());
+            return m_head->value();
+        }
+
+        const REQUEST &
+        front() const
+        {
+            assert(!empty());
+            return m_head->value();
+        }
+
+        template<typename... Args>
+        void
+        emplace_back(Args&&... args)
+        {
+            Node *node = m_table->allocNode();
+            new (node->storage) REQUEST(std::forward<Args>(args)...);
+            if (m_tail)
+                m_tail->next = node;
+            else
+                m_head = node;
+            m_tail = node;
+            m_size++;
+        }
+
+        void
+        pop_front()
+        {
+            assert(!empty());
+            Node *node = m_head;
+            m_head = node->next;
+            if (!m_head)
+                m_tail = nullptr;
+            m_size--;
+            node->value().~REQUEST();
+            m_table->freeNode(node);
+        }
+
+        void
+        clear()
+        {
+            while (!empty())
+                pop_front();
+        }
+
+        const_iterator begin() const { return const_iterator(m_head); }
+        const_iterator end() const { return const_iterator(nullptr); }
+
+      private:
+        friend class LineRequestTable;
+
+        LineRequestTable *m_table = nullptr;
+        Node *m_head = nullptr;
+        Node *m_tail = nullptr;
+        size_t m_size = 0;
+        // Link for the free list of unused lists
+        RequestList *m_nextFree = nullptr;
+    };
+
+    struct Entry
+    {
+        Addr addr = 0;
+        RequestList *requests = nullptr;
+    };
+
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry *;
+        using reference = const Entry &;
+
+        const_iterator(const Entry *entry, const Entry *end)
+            : m_entry(entry), m_end(end)
+        {
+            skipEmpty();
+        }
+
+        reference operator*() const { return *m_entry; }
+        pointer operator->() const { return m_entry; }
+
+        const_iterator &
+        operator++()
+        {
+            ++m_entry;
+            skipEmpty();
+            return *this;
+        }
+
+        bool
+        operator==(const const_iterator &other) const
+        {
+            return m_entry == other.m_entry;
+        }
+
+        bool
+        operator!=(const const_iterator &other) const
+        {
+            return m_entry != other.m_entry;
+        }
+
+      private:
+        void
+        skipEmpty()
+        {
+            while (m_entry != m_end && !m_entry->requests)
+                ++m_entry;
+        }
+
+        const Entry *m_entry;
+        const Entry *m_end;
+    };
+
+    /**
+     * @param expected_requests The number of requests the table is
+     *        expected to hold at once, typically the owner's
+     *        max_outstanding_requests.
+     */
+    explicit LineRequestTable(int expected_requests)
+        : m_chunkSize(std::max(expected_requests, 16))
+    {
+        resizeSlots(size_t(1) << ceilLog2(2 * m_chunkSize));
+        growLists();
+        growNodes();
+    }
+
+    ~LineRequestTable()
+    {
+        for (auto &entry : m_slots) {
+            if (entry.requests)
+                entry.requests->clear();
+        }
+    }
+
+    bool empty() const { return m_numLines == 0; }
+
+    // Number of lines with outstanding requests
+    size_t size() const { return m_numLines; }
+
+    bool isPresent(Addr address) const { return lookup(address) != nullptr; }
+
+    RequestList *
+    lookup(Addr address) const
+    {
+        for (size_t i = slotOf(address); ; i = (i + 1) & m_mask) {
+            const Entry &entry = m_slots[i];
+            if (!entry.requests)
+                return nullptr;
+            if (entry.addr == address)
+                return entry.requests;
+        }
+    }
+
+    /** Get the list for a line, creating an empty one if needed. */
+    RequestList &
+    operator[](Addr address)
+    {
+        if (RequestList *list = lookup(address))
+            return *list;
+
+        if (2 * (m_numLines + 1) > m_slots.size())
+            resizeSlots(2 * m_slots.size());
+
+        RequestList *list = allocList();
+        insertEntry(address, list);
+        m_numLines++;
+        return *list;
+    }
+
+    /** Remove a line, discarding any requests still queued on it. */
+    void
+    erase(Addr address)
+    {
+        size_t i = slotOf(address);
+        while (m_slots[i].requests && m_slots[i].addr != address)
+            i = (i + 1) & m_mask;
+        if (!m_slots[i].requests)
+            return;
+
+        m_slots[i].requests->clear();
+        freeList(m_slots[i].requests);
+        m_slots[i] = Entry();
+        m_numLines--;
+
+        // Backward-shift the rest of the probe run so that lookups never
+        // need tombstones
+        size_t hole = i;
+        for (size_t j = (i + 1) & m_mask; m_slots[j].requests;
+             j = (j + 1) & m_mask) {
+            size_t home = slotOf(m_slots[j].addr);
+            if (((j - home) & m_mask) >= ((j - hole) & m_mask)) {
+                m_slots[hole] = m_slots[j];
+                m_slots[j] = Entry();
+                hole = j;
+            }
+        }
+    }
+
+    const_iterator
+    begin() const
+    {
+        return const_iterator(m_slots.data(), m_slots.data() + m_slots.size());
+    }
+
+    const_iterator
+    end() const
+    {
+        const Entry *last = m_slots.data() + m_slots.size();
+        return const_iterator(last, last);
+    }
+
+    void
+    print(std::ostream& out) const
+    {
+        out << "[";
+        for (const auto &entry : *this) {
+            out << " " << std::hex << entry.addr << std::dec << "=[";
+            for (const auto &req : *entry.requests)
+                out << " " << req;
+            out << " ]";
+        }
+        out << " ]";
+    }
+
+  private:
+    LineRequestTable(const LineRequestTable &) = delete;
+    LineRequestTable &operator=(const LineRequestTable &) = delete;
+
+    size_t
+    slotOf(Addr address) const
+    {
+        // Fibonacci hashing: the top bits of the product are well mixed
+        // even though line addresses have their low bits clear
+        return (uint64_t(address) * 0x9E3779B97F4A7C15ULL) >> m_shift;
+    }
+
+    void
+    insertEntry(Addr address, RequestList *list)
+    {
+        size_t i = slotOf(address);
+        while (m_slots[i].requests)
+            i = (i + 1) & m_mask;
+        m_slots[i].addr = address;
+        m_slots[i].requests = list;
+    }
+
+    void
+    resizeSlots(size_t num_slots)
+    {
+        std::vector<Entry> old_slots(num_slots);
+        old_slots.swap(m_slots);
+        m_mask = num_slots - 1;
+        m_shift = 64 - floorLog2(num_slots);
+        for (const auto &entry : old_slots) {
+            if (entry.requests)
+                insertEntry(entry.addr, entry.requests);
+        }
+    }
+
+    RequestList *
+    allocList()
+    {
+        if (!m_freeLists)
+            growLists();
+        RequestList *list = m_freeLists;
+        m_freeLists = list->m_nextFree;
+        list->m_nextFree = nullptr;
+        return list;
+    }
+
+    void
+    freeList(RequestList *list)
+    {
+        assert(list->empty());
+        list->m_nextFree = m_freeLists;
+        m_freeLists = list;
+    }
+
+    void
+    growLists()
+    {
+        m_listChunks.emplace_back(new RequestList[m_chunkSize]);
+        RequestList *chunk = m_listChunks.back().get();
+        for (size_t i = 0; i < m_chunkSize; i++) {
+            chunk[i].m_table = this;
+            freeList(&chunk[i]);
+        }
+    }
+
+    Node *
+    allocNode()
+    {
+        if (!m_freeNodes)
+            growNodes();
+        Node *node = m_freeNodes;
+        m_freeNodes = node->next;
+        node->next = nullptr;
+        return node;
+    }
+
+    void
+    freeNode(Node *node)
+    {
+        node->next = m_freeNodes;
+        m_freeNodes = node;
+    }
+
+    void
+    growNodes()
+    {
+        m_nodeChunks.emplace_back(new Node[m_chunkSize]);
+        Node *chunk = m_nodeChunks.back().get();
+        for (size_t i = 0; i < m_chunkSize; i++)
+            freeNode(&chunk[i]);
+    }
+
+    const size_t m_chunkSize;
+
+    std::vector<Entry> m_slots;
+    size_t m_mask = 0;
+    int m_shift = 0;
+    size_t m_numLines = 0;
+
+    std::vector<std::unique_ptr<RequestList[]>> m_listChunks;
+    RequestList *m_freeLists = nullptr;
+
+    std::vector<std::unique_ptr<Node[]>> m_nodeChunks;
+    Node *m_freeNodes = nullptr;
+};
+
+template<class REQUEST>
+inline std::ostream&
+operator<<(std::ostream& out, const LineRequestTable<REQUEST>& obj)
+{
+    obj.print(out);
+    out << std::flush;
+    return out;
+}
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_LINEREQUESTTABLE_HH__
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "mem/ruby/structures/LineRequestTable.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+using Table = LineRequestTable<int>;
+using Reference = std::unordered_map<Addr, std::list<int>>;
+
+/** Check that a table holds exactly the lines and requests of a model. */
+void
+expectSame(const Table &table, const Reference &reference)
+{
+    ASSERT_EQ(table.size(), reference.size());
+    EXPECT_EQ(table.empty(), reference.empty());
+
+    size_t num_lines = 0;
+    for (const auto &entry : table) {
+        num_lines++;
+        auto it = reference.find(entry.addr);
+        ASSERT_NE(it, reference.end()) << std::hex << entry.addr;
+        EXPECT_EQ(table.lookup(entry.addr), entry.requests);
+        ASSERT_EQ(entry.requests->size(), it->second.size());
+        auto expected = it->second.begin();
+        for (int req : *entry.requests)
+            EXPECT_EQ(req, *expected++);
+    }
+    EXPECT_EQ(num_lines, reference.size());
+
+    for (const auto &line : reference)
+        EXPECT_TRUE(table.isPresent(line.first)) << std::hex << line.first;
+}
+
+/**
+ * Slot a line maps to in a table with a number of slots, this has to
+ * match LineRequestTable::slotOf().
+ */
+size_t
+slotOf(Addr address, size_t num_slots)
+{
+    return (uint64_t(address) * 0x9E3779B97F4A7C15ULL) >>
+        (64 - floorLog2(num_slots));
+}
+
+} // anonymous namespace
+
+/**
+ * Lines whose home is the last slot probe past the end of the slot
+ * array and wrap around to the start. Lookups and erases, including the
+ * backward shift of the probe run, have to follow them there.
+ */
+TEST(LineRequestTableTest, WrapAround)
+{
+    // 16 expected requests give 32 slots
+    const size_t num_slots = 32;
+    std::vector<Addr> last_slot;
+    std::vector<Addr> first_slot;
+    for (Addr addr = 0; last_slot.size() < 3 || first_slot.size() < 1;
+         addr += 64) {
+        if (slotOf(addr, num_slots) == num_slots - 1)
+            last_slot.push_back(addr);
+        else if (slotOf(addr, num_slots) == 0)
+            first_slot.push_back(addr);
+    }
+
+    Table table(16);
+    Reference reference;
+    // The last slot's lines take slots 31, 0 and 1, pushing the line
+    // whose home is slot 0 to slot 2
+    for (int i = 0; i < 3; i++) {
+        table[last_slot[i]].emplace_back(i);
+        reference[last_slot[i]].push_back(i);
+    }
+    table[first_slot[0]].emplace_back(3);
+    reference[first_slot[0]].push_back(3);
+    expectSame(table, reference);
+
+    // Iteration is in slot order, so the wrapped lines come first
+    auto it = table.begin();
+    EXPECT_EQ(it->addr, last_slot[1]);
+    EXPECT_EQ((++it)->addr, last_slot[2]);
+    EXPECT_EQ((++it)->addr, first_slot[0]);
+    EXPECT_EQ((++it)->addr, last_slot[0]);
+
+    // Erasing the line in the last slot shifts the others back across
+    // the wrap, every line has to stay reachable
+    table.erase(last_slot[0]);
+    reference.erase(last_slot[0]);
+    expectSame(table, reference);
+    EXPECT_EQ(table.begin()->addr, last_slot[2]);
+
+    table.erase(last_slot[2]);
+    reference.erase(last_slot[2]);
+    expectSame(table, reference);
+
+    // Erasing a line that is not there is a no-op, even if its probe
+    // run wraps
+    table.erase(last_slot[0]);
+    expectSame(table, reference);
+}
+
+/**
+ * Grow far beyond the expected number of requests, which resizes the
+ * slots and grows the list and node pools, while holding on to a list.
+ */
+TEST(LineRequestTableTest, GrowBeyondExpected)
+{
+    Table table(4);
+    Table::RequestList &held = table[0x40];
+    held.emplace_back(1);
+    held.emplace_back(2);
+
+    Reference reference;
+    reference[0x40] = {1, 2};
+    for (int i = 0; i < 1000; i++) {
+        const Addr addr = 0x1000 + i * 64;
+        table[addr].emplace_back(i);
+        table[addr].emplace_back(-i);
+        reference[addr] = {i, -i};
+    }
+    expectSame(table, reference);
+
+    // The list reference survived every resizeSlots()
+    EXPECT_EQ(table.lookup(0x40), &held);
+    held.emplace_back(3);
+    reference[0x40].push_back(3);
+    expectSame(table, reference);
+
+    // Shrinking back and growing again reuses the freed lists and nodes
+    for (int i = 0; i < 1000; i++) {
+        table.erase(0x1000 + i * 64);
+        reference.erase(0x1000 + i * 64);
+    }
+    expectSame(table, reference);
+    EXPECT_EQ(table.lookup(0x40), &held);
+    for (int i = 0; i < 1000; i++) {
+        const Addr addr = 0x80000 + i * 64;
+        table[addr].emplace_back(i);
+        reference[addr] = {i};
+    }
+    expectSame(table, reference);
+    EXPECT_EQ(table.lookup(0x40), &held);
+}
+
+/** Random operations behave like a map of lists. */
+TEST(LineRequestTableTest, RandomAgainstReference)
+{
+    std::mt19937 rng(12345);
+    Table table(8);
+    Reference reference;
+
+    // Few enough lines that probe runs collide and wrap often, and
+    // enough that the table has to grow past its expected size
+    const unsigned num_addrs = 200;
+    std::uniform_int_distribution<unsigned> pick_addr(0, num_addrs - 1);
+    std::uniform_int_distribution<unsigned> pick_op(0, 9);
+
+    int next_req = 0;
+    for (int step = 0; step < 200000; step++) {
+        const Addr addr = Addr(pick_addr(rng)) * 64;
+        const unsigned op = pick_op(rng);
+        if (op < 5) {
+            table[addr].emplace_back(next_req);
+            reference[addr].push_back(next_req);
+            next_req++;
+        } else if (op < 7) {
+            // Retire the oldest request, and the line with it once it
+            // has no more, like the sequencer does
+            Table::RequestList *list = table.lookup(addr);
+            auto it = reference.find(addr);
+            ASSERT_EQ(list != nullptr, it != reference.end());
+            if (!list)
+                continue;
+            ASSERT_FALSE(list->empty());
+            EXPECT_EQ(list->front(), it->second.front());
+            list->pop_front();
+            it->second.pop_front();
+            if (list->empty()) {
+                table.erase(addr);
+                reference.erase(it);
+            }
+        } else if (op < 8) {
+            table.erase(addr);
+            reference.erase(addr);
+        } else {
+            Table::RequestList *list = table.lookup(addr);
+            auto it = reference.find(addr);
+            ASSERT_EQ(list != nullptr, it != reference.end());
+            if (list) {
+                EXPECT_EQ(list->size(), it->second.size());
+            }
+        }
+
+        if (step % 1000 == 0)
+            expectSame(table, reference);
+    }
+    expectSame(table, reference);
+}
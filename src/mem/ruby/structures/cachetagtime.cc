@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark comparing the tag lookup of Ruby's CacheMemory using
+ * a flat per-set tag array (CacheTagIndex) with the hash map that was
+ * used before.
+ *
+ * Every access looks up a line; roughly half of the accesses hit. On
+ * a miss, a random way of the set is evicted and replaced by the
+ * missing line, as CacheMemory::deallocate() and allocate() would do.
+ */
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "mem/ruby/structures/CacheTagIndex.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+const int BlockSize = 64;
+const int IndexBit = floorLog2(BlockSize);
+
+struct HashIndex
+{
+    std::unordered_map<Addr, int> map;
+
+    void init(int num_sets, int assoc) { map.clear(); }
+
+    int
+    find(int64_t set, Addr line) const
+    {
+        auto it = map.find(line);
+        return it == map.end() ? -1 : it->second;
+    }
+
+    void insert(int64_t set, int way, Addr line) { map[line] = way; }
+    void erase(int64_t set, int way, Addr line) { map.erase(line); }
+};
+
+struct FlatIndex
+{
+    CacheTagIndex index;
+
+    void init(int num_sets, int assoc) { index.init(num_sets, assoc); }
+
+    int
+    find(int64_t set, Addr line) const
+    {
+        return index.find(set, line);
+    }
+
+    void insert(int64_t set, int way, Addr line)
+    {
+        index.insert(set, way, line);
+    }
+
+    void erase(int64_t set, int way, Addr line) { index.erase(set, way); }
+};
+
+template <class Index>
+double
+run(uint64_t size, int assoc, uint64_t num_accesses, uint64_t &hits)
+{
+    const int num_sets = size / BlockSize / assoc;
+    // Twice as many lines as fit in the cache, so about half of the
+    // accesses miss
+    const Addr footprint = 2 * size;
+
+    std::mt19937_64 rng(size + assoc);
+    Index index;
+    index.init(num_sets, assoc);
+    std::vector<Addr> lines((size_t)num_sets * assoc);
+
+    auto set_of = [&](Addr line) {
+        return (line >> IndexBit) & (num_sets - 1);
+    };
+
+    for (int set = 0; set < num_sets; set++) {
+        for (int way = 0; way < assoc; way++) {
+            Addr line = ((Addr)(way * num_sets + set)) << IndexBit;
+            lines[set * assoc + way] = line;
+            index.insert(set, way, line);
+        }
+    }
+
+    std::vector<Addr> trace(1 << 20);
+    for (auto &line : trace)
+        line = (rng() % footprint) & ~(Addr)(BlockSize - 1);
+
+    hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < num_accesses; i++) {
+        const Addr line = trace[i & (trace.size() - 1)];
+        const int64_t set = set_of(line);
+        if (index.find(set, line) != -1) {
+            hits++;
+        } else {
+            const int way = rng() % assoc;
+            Addr &victim = lines[set * assoc + way];
+            index.erase(set, way, victim);
+            index.insert(set, way, line);
+            victim = line;
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return num_accesses / elapsed.count();
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+    const uint64_t num_accesses = 20000000;
+    const struct
+    {
+        const char *name;
+        uint64_t size;
+        int assoc;
+    } caches[] = {
+        { "L2 256kB", 256 * 1024, 8 },
+        { "L2 1MB", 1024 * 1024, 16 },
+        { "L3 8MB", 8 * 1024 * 1024, 16 },
+        { "L3 32MB", 32 * 1024 * 1024, 16 },
+    };
+
+    cprintf("%10s %6s %16s %16s %8s\n", "cache", "assoc", "hash (acc/s)",
+            "flat (acc/s)", "speedup");
+    for (const auto &cache : caches) {
+        uint64_t hash_hits, flat_hits;
+        double hash = run<HashIndex>(cache.size, cache.assoc, num_accesses,
+                                     hash_hits);
+        double flat = run<FlatIndex>(cache.size, cache.assoc, num_accesses,
+                                     flat_hits);
+        if (hash_hits != flat_hits) {
+            cprintf("Mismatch: %d hits vs. %d hits\n", hash_hits, flat_hits);
+            return 1;
+        }
+        cprintf("%10s %6d %16d %16d %8.2f\n", cache.name, cache.assoc,
+                (uint64_t)hash, (uint64_t)flat, flat / hash);
+    }
+
+    return 0;
+}
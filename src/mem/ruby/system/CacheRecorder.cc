@@ -93,9 +93,9 @@ CacheRecorder::enqueueNextFlushRequest()
     if (m_records_flushed < m_records.size()) {
         TraceRecord* rec = m_records[m_records_flushed];
         m_records_flushed++;
-        auto req = std::make_shared<Request>(rec->m_data_address,
-                                             m_block_size_bytes, 0,
-                                             Request::funcRequestorId);
+        auto req = Request::create(rec->m_data_address,
+                                   m_block_size_bytes, 0,
+                                   Request::funcRequestorId);
         MemCmd::Command requestType = MemCmd::FlushReq;
         Packet *pkt = new Packet(req, requestType);
         pkt->req->setReqInstSeqNum(m_records_flushed);
@@ -131,19 +131,19 @@ CacheRecorder::enqueueNextFetchRequest()
 
             if (traceRecord->m_type == RubyRequestType_LD) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                     traceRecord->m_data_address + rec_bytes_read,
                     RubySystem::getBlockSizeBytes(), 0,
                                     Request::funcRequestorId);
             }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                         traceRecord->m_data_address + rec_bytes_read,
                         RubySystem::getBlockSizeBytes(),
                         Request::INST_FETCH, Request::funcRequestorId);
             }   else {
                 requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                     traceRecord->m_data_address + rec_bytes_read,
                     RubySystem::getBlockSizeBytes(), 0,
                                 Request::funcRequestorId);
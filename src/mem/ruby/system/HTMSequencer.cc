@@ -173,7 +173,7 @@ HTMSequencer::htmCallback(Addr address,
                mode == HtmCallbackMode_ST_FAIL) {
         // transaction failed
         assert(address == makeLineAddress(address));
-        assert(m_RequestTable.find(address) != m_RequestTable.end());
+        assert(m_RequestTable.isPresent(address));
 
         auto &seq_req_list = m_RequestTable[address];
         while (!seq_req_list.empty()) {
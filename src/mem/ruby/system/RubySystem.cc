@@ -236,6 +236,11 @@ RubySystem::memWriteback()
         return;
     }
 
+    // The flush replays the trace on the Ruby system's own event queue
+    // only, which can't drive controllers in other partitions.
+    fatal_if(numMainEventQueues > 1,
+             "Can't flush Ruby caches with multiple event queues.\n");
+
     // save the current tick value
     Tick curtick_original = curTick();
     DPRINTF(RubyCacheTrace, "Recording current tick %ld\n", curtick_original);
@@ -449,6 +454,8 @@ RubySystem::startup()
     // state was checkpointed.
 
     if (m_warmup_enabled) {
+        fatal_if(numMainEventQueues > 1,
+                 "Can't warm up Ruby caches with multiple event queues.\n");
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
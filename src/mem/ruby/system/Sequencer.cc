@@ -45,6 +45,7 @@
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/str.hh"
+#include "config/ruby_sequencer_latency_hists.hh"
 #include "cpu/testers/rubytest/RubyTester.hh"
 #include "debug/LLSC.hh"
 #include "debug/MemoryAccess.hh"
@@ -68,7 +69,8 @@ namespace ruby
 {
 
 Sequencer::Sequencer(const Params &p)
-    : RubyPort(p), m_IncompleteTimes(MachineType_NUM),
+    : RubyPort(p), m_RequestTable(p.max_outstanding_requests),
+      m_IncompleteTimes(MachineType_NUM),
       deadlockCheckEvent([this]{ wakeup(); }, "Sequencer deadlock check")
 {
     m_outstanding_count = 0;
@@ -235,19 +237,19 @@ Sequencer::wakeup()
     [[maybe_unused]] int total_outstanding = 0;
 
     for (const auto &table_entry : m_RequestTable) {
-        for (const auto &seq_req : table_entry.second) {
+        for (const auto &seq_req : *table_entry.requests) {
             if (current_time - seq_req.issue_time < m_deadlock_threshold)
                 continue;
 
             panic("Possible Deadlock detected. Aborting!\n version: %d "
                   "request.paddr: 0x%x m_readRequestTable: %d current time: "
                   "%u issue_time: %d difference: %d\n", m_version,
-                  seq_req.pkt->getAddr(), table_entry.second.size(),
+                  seq_req.pkt->getAddr(), table_entry.requests->size(),
                   current_time * clockPeriod(), seq_req.issue_time
                   * clockPeriod(), (current_time * clockPeriod())
                   - (seq_req.issue_time * clockPeriod()));
         }
-        total_outstanding += table_entry.second.size();
+        total_outstanding += table_entry.requests->size();
     }
 
     assert(m_outstanding_count == total_outstanding);
@@ -264,7 +266,7 @@ Sequencer::functionalWrite(Packet *func_pkt)
     int num_written = RubyPort::functionalWrite(func_pkt);
 
     for (const auto &table_entry : m_RequestTable) {
-        for (const auto& seq_req : table_entry.second) {
+        for (const auto& seq_req : *table_entry.requests) {
             if (seq_req.functionalWrite(func_pkt))
                 ++num_written;
         }
@@ -389,7 +391,7 @@ Sequencer::recordMissLatency(SequencerRequest* srequest, bool llscSuccess,
                              Cycles forwardRequestTime,
                              Cycles firstResponseTime)
 {
-    RubyRequestType type = srequest->m_type;
+    [[maybe_unused]] RubyRequestType type = srequest->m_type;
     Cycles issued_time = srequest->issue_time;
     Cycles completion_time = curCycle();
 
@@ -410,10 +412,16 @@ Sequencer::recordMissLatency(SequencerRequest* srequest, bool llscSuccess,
              "", "", printAddress(srequest->pkt->getAddr()), total_lat);
 
     m_latencyHist.sample(total_lat);
+    if (isExternalHit) {
+        m_missLatencyHist.sample(total_lat);
+    } else {
+        m_hitLatencyHist.sample(total_lat);
+    }
+
+#if RUBY_SEQUENCER_LATENCY_HISTS
     m_typeLatencyHist[type]->sample(total_lat);
 
     if (isExternalHit) {
-        m_missLatencyHist.sample(total_lat);
         m_missTypeLatencyHist[type]->sample(total_lat);
 
         if (respondingMach != MachineType_NUM) {
@@ -438,7 +446,6 @@ Sequencer::recordMissLatency(SequencerRequest* srequest, bool llscSuccess,
             }
         }
     } else {
-        m_hitLatencyHist.sample(total_lat);
         m_hitTypeLatencyHist[type]->sample(total_lat);
 
         if (respondingMach != MachineType_NUM) {
@@ -446,6 +453,7 @@ Sequencer::recordMissLatency(SequencerRequest* srequest, bool llscSuccess,
             m_hitTypeMachLatencyHist[type][respondingMach]->sample(total_lat);
         }
     }
+#endif
 }
 
 void
@@ -468,7 +476,7 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     // to this cache line when response for the write comes back
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
+    assert(m_RequestTable.isPresent(address));
     auto &seq_req_list = m_RequestTable[address];
 
     // Perform hitCallback on every cpu request made to this cache block while
@@ -571,7 +579,7 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     // or end of the corresponding list.
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
+    assert(m_RequestTable.isPresent(address));
     auto &seq_req_list = m_RequestTable[address];
 
     // Perform hitCallback on every cpu request made to this cache block while
@@ -626,7 +634,7 @@ Sequencer::atomicCallback(Addr address, DataBlock& data,
     // (the opperation could be performed remotly)
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
+    assert(m_RequestTable.isPresent(address));
     auto &seq_req_list = m_RequestTable[address];
 
     // Perform hitCallback only on the first cpu request that
@@ -887,7 +895,7 @@ Sequencer::invL1()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Evict Read-only data
         RubyRequestType request_type = RubyRequestType_REPLACEMENT;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg = new RubyRequest(
             clockEdge(), addr, 0, 0,
             request_type, RubyAccessMode_Supervisor,
             nullptr);
@@ -1058,12 +1066,12 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
 
     // check if the packet has data as for example prefetch and flush
     // requests do not
-    std::shared_ptr<RubyRequest> msg;
+    RefCountingPtr<RubyRequest> msg;
     if (pkt->req->isMemMgmt()) {
-        msg = std::make_shared<RubyRequest>(clockEdge(),
-                                            pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            proc_id, core_id);
+        msg = new RubyRequest(clockEdge(),
+                              pc, secondary_type,
+                              RubyAccessMode_Supervisor, pkt,
+                              proc_id, core_id);
 
         DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %s\n",
                 curTick(), m_version, "Seq", "Begin", "", "",
@@ -1087,10 +1095,10 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
                     msg->m_tlbiTransactionUid);
         }
     } else {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
-                                            pkt->getSize(), pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            PrefetchBit_No, proc_id, core_id);
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(),
+                              pkt->getSize(), pc, secondary_type,
+                              RubyAccessMode_Supervisor, pkt,
+                              PrefetchBit_No, proc_id, core_id);
 
         if (pkt->isAtomicOp() &&
             ((secondary_type == RubyRequestType_ATOMIC_RETURN) ||
@@ -1126,13 +1134,12 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
 }
 
-template <class KEY, class VALUE>
 std::ostream &
-operator<<(std::ostream &out, const std::unordered_map<KEY, VALUE> &map)
+operator<<(std::ostream &out, const LineRequestTable<SequencerRequest> &table)
 {
-    for (const auto &table_entry : map) {
-        out << "[ " << table_entry.first << " =";
-        for (const auto &seq_req : table_entry.second) {
+    for (const auto &table_entry : table) {
+        out << "[ " << table_entry.addr << " =";
+        for (const auto &seq_req : *table_entry.requests) {
             out << " " << RubyRequestType_to_string(seq_req.m_second_type);
         }
     }
@@ -42,7 +42,6 @@
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
 #include <iostream>
-#include <list>
 #include <unordered_map>
 
 #include "mem/ruby/common/Address.hh"
@@ -50,6 +49,7 @@
 #include "mem/ruby/protocol/RubyRequestType.hh"
 #include "mem/ruby/protocol/SequencerRequestType.hh"
 #include "mem/ruby/structures/CacheMemory.hh"
+#include "mem/ruby/structures/LineRequestTable.hh"
 #include "mem/ruby/system/RubyPort.hh"
 #include "params/RubySequencer.hh"
 
@@ -232,8 +232,10 @@ class Sequencer : public RubyPort
     Sequencer& operator=(const Sequencer& obj);
 
   protected:
-    // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    // RequestTable contains both read and write requests, handles aliasing.
+    // It is sized from max_outstanding_requests so that steady-state
+    // inserts and removals do not allocate.
+    LineRequestTable<SequencerRequest> m_RequestTable;
     // UnadressedRequestTable contains "unaddressed" requests,
     // guaranteed not to alias each other
     std::unordered_map<uint64_t, SequencerRequest> m_UnaddressedRequestTable;
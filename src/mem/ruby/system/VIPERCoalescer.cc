@@ -157,16 +157,16 @@ VIPERCoalescer::issueRequest(CoalescedRequest* crequest)
             accessMask[tmpOffset + j] = true;
         }
     }
-    std::shared_ptr<RubyRequest> msg;
+    RefCountingPtr<RubyRequest> msg;
     if (pkt->isAtomicOp()) {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(),
                               pkt->getSize(), pc, crequest->getRubyType(),
                               RubyAccessMode_Supervisor, pkt,
                               PrefetchBit_No, proc_id, 100,
                               blockSize, accessMask,
                               dataBlock, atomicOps, crequest->getSeqNum());
     } else {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(),
                               pkt->getSize(), pc, crequest->getRubyType(),
                               RubyAccessMode_Supervisor, pkt,
                               PrefetchBit_No, proc_id, 100,
@@ -295,7 +295,7 @@ VIPERCoalescer::invTCP()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Evict Read-only data
         RubyRequestType request_type = RubyRequestType_REPLACEMENT;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg = new RubyRequest(
             clockEdge(), addr, 0, 0,
             request_type, RubyAccessMode_Supervisor,
             nullptr);
@@ -342,7 +342,7 @@ VIPERCoalescer::invTCC(PacketPtr pkt)
     Addr addr = pkt->req->getPaddr();
     RubyRequestType request_type = RubyRequestType_InvL2;
 
-    std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+    RefCountingPtr<RubyRequest> msg = new RubyRequest(
         clockEdge(), addr, 0, 0,
         request_type, RubyAccessMode_Supervisor,
         nullptr);
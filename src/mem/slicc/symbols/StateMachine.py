@@ -254,6 +254,19 @@ class StateMachine(Symbol):
                 in_msg_bufs[buf_name].append(port)
         return port_to_buf_map, in_msg_bufs, msg_bufs
 
+    def getReadyBits(self):
+        """Map the MessageBuffers read by in_ports to bits of the
+        controller's ready mask. Ports reading other queue types, or
+        buffers beyond the width of the mask, are always polled."""
+        ready_bits = {}
+        for port in self.in_ports:
+            if port["buffer_type"].ident != "MessageBuffer":
+                continue
+            buf_name = f"m_{port.pairs['buffer_expr'].name}_ptr"
+            if buf_name not in ready_bits and len(ready_bits) < 64:
+                ready_bits[buf_name] = len(ready_bits)
+        return ready_bits
+
     def writeCodeFiles(self, path, includes):
         self.printControllerPython(path)
         self.printControllerHH(path)
@@ -449,6 +462,9 @@ int m_counters[${ident}_State_NUM][${ident}_Event_NUM];
 int m_event_counters[${ident}_Event_NUM];
 bool m_possible[${ident}_State_NUM][${ident}_Event_NUM];
 
+// Bit mask of the input buffers holding messages, see getReadyBits()
+uint64_t m_ready_buffers = 0;
+
 static std::vector<statistics::Vector *> eventVec;
 static std::vector<std::vector<statistics::Vector *> > transVec;
 static int m_num_controllers;
@@ -786,6 +802,11 @@ $c_ident::init()
             # Set the queue consumers
             code("${{port.code}}.setConsumer(this);")
 
+        # Let the input buffers track if they hold messages, so wakeup()
+        # can skip the empty ones
+        for buf_name, bit in self.getReadyBits().items():
+            code("$buf_name->setReadyMask(&m_ready_buffers, $bit);")
+
         # Initialize the transition profiling
         code()
         for trans in self.transitions:
@@ -1447,6 +1468,7 @@ $c_ident::functionalReadBuffers(PacketPtr& pkt, WriteMask &mask)
             code('#include "${{include_path}}"')
 
         port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
+        ready_bits = self.getReadyBits()
 
         code(
             """
@@ -1488,6 +1510,13 @@ ${ident}_Controller::wakeup()
         for port in self.in_ports:
             code.indent()
             code("// ${ident}InPort $port")
+            # An in_port only acts on messages in its own buffer, skip
+            # it if the buffer is empty
+            buf_name = f"m_{port.pairs['buffer_expr'].name}_ptr"
+            if buf_name in ready_bits:
+                bit = ready_bits[buf_name]
+                code("if (m_ready_buffers & (1ULL << $bit)) {")
+                code.indent()
             if "rank" in port.pairs:
                 code('m_cur_in_port = ${{port.pairs["rank"]}};')
             else:
@@ -1506,6 +1535,9 @@ ${ident}_Controller::wakeup()
             }
 """
                 )
+            if buf_name in ready_bits:
+                code.dedent()
+                code("}")
             code.dedent()
             code("")
 
@@ -1546,6 +1578,114 @@ ${ident}_Controller::wakeup()
 
         code.write(path, f"{self.ident}_Wakeup.cc")
 
+    def getTransitionCases(self):
+        """Generate the code of each transition, returning a map from each
+        unique code block to the transitions sharing it."""
+        ident = self.ident
+
+        # This map will allow suppress generating duplicate code
+        cases = OrderedDict()
+
+        for trans in self.transitions:
+            case_string = (
+                f"{self.ident}_State_{trans.state.ident}",
+                f"{self.ident}_Event_{trans.event.ident}",
+            )
+
+            case = self.symtab.codeFormatter()
+            # Only set next_state if it changes
+            if trans.state != trans.nextState:
+                if trans.nextState.isWildcard():
+                    # When * is encountered as an end state of a transition,
+                    # the next state is determined by calling the
+                    # machine-specific getNextState function. The next state
+                    # is determined before any actions of the transition
+                    # execute, and therefore the next state calculation cannot
+                    # depend on any of the transitionactions.
+                    case(
+                        "next_state = getNextState(addr); "
+                        "m_curTransitionNextState = next_state;"
+                    )
+                else:
+                    ns_ident = trans.nextState.ident
+                    case(
+                        "next_state = ${ident}_State_${ns_ident}; "
+                        "m_curTransitionNextState = next_state;"
+                    )
+
+            actions = trans.actions
+            request_types = trans.request_types
+
+            # Check for resources
+            case_sorter = []
+            res = trans.resources
+            for key, val in res.items():
+                val = f"""
+if (!{key.code}.areNSlotsAvailable({val}, clockEdge()))
+    return TransitionResult_ResourceStall;
+"""
+                case_sorter.append(val)
+
+            # Check all of the request_types for resource constraints
+            for request_type in request_types:
+                val = """
+if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
+    return TransitionResult_ResourceStall;
+}}
+""".format(
+                    self.ident,
+                    request_type.ident,
+                )
+                case_sorter.append(val)
+
+            # Emit the code sequences in a sorted order.  This makes the
+            # output deterministic (without this the output order can vary
+            # since Map's keys() on a vector of pointers is not deterministic
+            for c in sorted(case_sorter):
+                case("$c")
+
+            # Record access types for this transition
+            for request_type in request_types:
+                case(
+                    "recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);"
+                )
+
+            # Figure out if we stall
+            stall = False
+            for action in actions:
+                if action.ident == "z_stall":
+                    stall = True
+                    break
+
+            if stall:
+                case("return TransitionResult_ProtocolStall;")
+            else:
+                if self.TBEType != None and self.EntryType != None:
+                    for action in actions:
+                        case(
+                            "${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);"
+                        )
+                elif self.TBEType != None:
+                    for action in actions:
+                        case("${{action.ident}}(m_tbe_ptr, addr);")
+                elif self.EntryType != None:
+                    for action in actions:
+                        case("${{action.ident}}(m_cache_entry_ptr, addr);")
+                else:
+                    for action in actions:
+                        case("${{action.ident}}(addr);")
+                case("return TransitionResult_Valid;")
+
+            case = str(case)
+
+            # Look to see if this transition code is unique.
+            if case not in cases:
+                cases[case] = []
+
+            cases[case].append(case_string)
+
+        return cases
+
     def printCSwitch(self, path):
         """Output switch statement for transition table"""
 
@@ -1568,8 +1708,6 @@ ${ident}_Controller::wakeup()
 #include "mem/ruby/protocol/Types.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
-#define HASH_FUN(state, event)  ((int(state)*${ident}_Event_NUM)+int(event))
-
 #define GET_TRANSITION_COMMENT() (${ident}_transitionComment.str())
 #define CLEAR_TRANSITION_COMMENT() (${ident}_transitionComment.str(""))
 
@@ -1578,6 +1716,40 @@ namespace gem5
 
 namespace ruby
 {
+"""
+        )
+
+        # Cases are numbered from 1 in a dense state x event table, 0
+        # marking invalid transitions, so the dispatch is a single lookup
+        # and a jump however sparse the transitions are
+        cases = self.getTransitionCases()
+        case_type = "uint8_t" if len(cases) < 256 else "uint16_t"
+        code(
+            """
+namespace
+{
+
+struct ${ident}_TransitionTable
+{
+    ${case_type} caseOf[${ident}_State_NUM][${ident}_Event_NUM] = {};
+
+    ${ident}_TransitionTable()
+    {
+"""
+        )
+        code.indent(2)
+        for case_id, transitions in enumerate(cases.values(), 1):
+            for trans in transitions:
+                code("caseOf[${{trans[0]}}][${{trans[1]}}] = $case_id;")
+        code.dedent(2)
+        code(
+            """
+    }
+};
+
+const ${ident}_TransitionTable ${ident}_transitionTable;
+
+} // anonymous namespace
 
 TransitionResult
 ${ident}_Controller::doTransition(${ident}_Event event,
@@ -1725,120 +1897,17 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
 {
     m_curTransitionEvent = event;
     m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
+    switch (${ident}_transitionTable.caseOf[state][event]) {
 """
         )
-
-        # This map will allow suppress generating duplicate code
-        cases = OrderedDict()
-
-        for trans in self.transitions:
-            case_string = "{}_State_{}, {}_Event_{}".format(
-                self.ident,
-                trans.state.ident,
-                self.ident,
-                trans.event.ident,
-            )
-
-            case = self.symtab.codeFormatter()
-            # Only set next_state if it changes
-            if trans.state != trans.nextState:
-                if trans.nextState.isWildcard():
-                    # When * is encountered as an end state of a transition,
-                    # the next state is determined by calling the
-                    # machine-specific getNextState function. The next state
-                    # is determined before any actions of the transition
-                    # execute, and therefore the next state calculation cannot
-                    # depend on any of the transitionactions.
-                    case(
-                        "next_state = getNextState(addr); "
-                        "m_curTransitionNextState = next_state;"
-                    )
-                else:
-                    ns_ident = trans.nextState.ident
-                    case(
-                        "next_state = ${ident}_State_${ns_ident}; "
-                        "m_curTransitionNextState = next_state;"
-                    )
-
-            actions = trans.actions
-            request_types = trans.request_types
-
-            # Check for resources
-            case_sorter = []
-            res = trans.resources
-            for key, val in res.items():
-                val = f"""
-if (!{key.code}.areNSlotsAvailable({val}, clockEdge()))
-    return TransitionResult_ResourceStall;
-"""
-                case_sorter.append(val)
-
-            # Check all of the request_types for resource constraints
-            for request_type in request_types:
-                val = """
-if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
-    return TransitionResult_ResourceStall;
-}}
-""".format(
-                    self.ident,
-                    request_type.ident,
-                )
-                case_sorter.append(val)
-
-            # Emit the code sequences in a sorted order.  This makes the
-            # output deterministic (without this the output order can vary
-            # since Map's keys() on a vector of pointers is not deterministic
-            for c in sorted(case_sorter):
-                case("$c")
-
-            # Record access types for this transition
-            for request_type in request_types:
-                case(
-                    "recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);"
-                )
-
-            # Figure out if we stall
-            stall = False
-            for action in actions:
-                if action.ident == "z_stall":
-                    stall = True
-                    break
-
-            if stall:
-                case("return TransitionResult_ProtocolStall;")
-            else:
-                if self.TBEType != None and self.EntryType != None:
-                    for action in actions:
-                        case(
-                            "${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);"
-                        )
-                elif self.TBEType != None:
-                    for action in actions:
-                        case("${{action.ident}}(m_tbe_ptr, addr);")
-                elif self.EntryType != None:
-                    for action in actions:
-                        case("${{action.ident}}(m_cache_entry_ptr, addr);")
-                else:
-                    for action in actions:
-                        case("${{action.ident}}(addr);")
-                case("return TransitionResult_Valid;")
-
-            case = str(case)
-
-            # Look to see if this transition code is unique.
-            if case not in cases:
-                cases[case] = []
-
-            cases[case].append(case_string)
-
         # Walk through all of the unique code blocks and spit out the
         # corresponding case statement elements
-        for case, transitions in cases.items():
+        for case_id, (case, transitions) in enumerate(cases.items(), 1):
             # Iterative over all the multiple transitions that share
             # the same code
             for trans in transitions:
-                code("  case HASH_FUN($trans):")
+                code("  // ${{trans[0]}}, ${{trans[1]}}")
+            code("  case $case_id:")
             code("    $case\n")
 
         code(
@@ -326,7 +326,19 @@ $klass ${{self.c_ident}}$parent
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return MsgPtr(new ${{self.c_ident}}(*this));
+}
+
+static void *
+operator new(size_t size)
+{
+    return poolAllocate(pool, size);
+}
+
+static void
+operator delete(void *p, size_t size)
+{
+    poolDeallocate(pool, p, size);
 }
 """
             )
@@ -414,6 +426,10 @@ set${{dm.ident}}(const ${{dm.real_c_type}}& local_${{dm.ident}})
 
                 code("$const${{dm.real_c_type}} m_${{dm.ident}}$init;")
 
+        if self.isMessage:
+            code("/** Recycles the memory of messages of this type */")
+            code("static PoolAllocator pool;")
+
         # Prototypes for methods defined for the Type
         for item in self.methods:
             proto = self.methods[item].prototype
@@ -487,6 +503,15 @@ out << "${{dm.ident}} = " << printAddress(m_${{dm.ident}}) << " ";"""
 }"""
         )
 
+        if self.isMessage:
+            pool_name = self.c_ident[0].lower() + self.c_ident[1:]
+            code(
+                """
+
+PoolAllocator ${{self.c_ident}}::pool("$pool_name",
+    sizeof(${{self.c_ident}}));"""
+            )
+
         # print the code for the methods in the type
         for item in self.methods:
             code(self.methods[item].generateCode())
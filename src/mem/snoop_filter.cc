@@ -42,6 +42,7 @@
 
 #include "mem/snoop_filter.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
@@ -52,17 +53,60 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p) :
+    SimObject(p),
+    table(p.max_capacity / p.system->cacheLineSize(), p.assoc,
+          p.sharer_group_size, p.system->cacheLineSize()),
+    linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
+    maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+    stats(this)
+{
+    fatal_if(p.sharer_group_size == 0, "%s: The sharer group size must be "
+             "at least 1.\n", name());
+    if (table.bounded()) {
+        const uint64_t num_sets = maxEntryCount / p.assoc;
+        fatal_if(num_sets == 0 || !isPowerOf2(num_sets) ||
+                 num_sets * p.assoc != maxEntryCount,
+                 "%s: The number of sets (%d lines in %d ways) must be a "
+                 "power of 2.\n", name(), maxEntryCount, p.assoc);
+    }
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(Entry *entry)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+    if (table.eraseIfNull(entry)) {
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
 }
 
+SnoopFilter::Entry *
+SnoopFilter::allocateEntry(Addr line_addr)
+{
+    Entry victim;
+    Entry *entry = table.allocate(line_addr, victim);
+    panic_if(!entry, "%s: all ways tracking lines with outstanding "
+             "requests, increase the snoop filter associativity\n",
+             name());
+
+    if (victim.valid()) {
+        const Addr victim_addr = victim.tag & ~Addr(LineSecure);
+        const bool victim_secure = victim.tag & LineSecure;
+        DPRINTF(SnoopFilter, "%s: evicting %#x SF value %x.%x\n",
+                __func__, victim_addr, victim.item.requested,
+                victim.item.holder);
+        stats.evictions++;
+
+        panic_if(!backInvalidate, "%s: no way to back-invalidate an "
+                 "evicted line\n", name());
+        backInvalidate(victim_addr, victim_secure,
+                       maskToPortList(victim.item.holder));
+    }
+
+    return entry;
+}
+
 std::pair<SnoopFilter::SnoopList, Cycles>
 SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
                            cpu_side_port)
@@ -78,21 +122,23 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    reqLookupResult.entry = table.find(line_addr);
+    bool is_hit = (reqLookupResult.entry != nullptr);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
-    // portlist.
-    if (!is_hit && !allocate)
+    // portlist. With a bounded filter, evictions of lines that are no
+    // longer tracked, e.g. as they were back-invalidated while the
+    // eviction was on its way, do not need an entry either.
+    if (!is_hit && (!allocate || (table.bounded() && cpkt->isEviction())))
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.entry = allocateEntry(line_addr);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    table.touch(reqLookupResult.entry);
+    SnoopItem& sf_item = reqLookupResult.entry->item;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -113,18 +159,19 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 
     // If we are not allocating, we are done
     if (!allocate)
-        return snoopSelected(maskToPortList(interested & ~req_port),
+        return snoopSelected(maskToPortList(interested, &cpu_side_port),
                              lookupLatency);
 
     if (cpkt->needsResponse()) {
         if (!cpkt->cacheResponding()) {
             // Max one request per address per port
-            panic_if((sf_item.requested & req_port).any(),
+            panic_if(isPrecise() && (sf_item.requested & req_port).any(),
                      "double request :( SF value %x.%x\n",
                      sf_item.requested, sf_item.holder);
 
             // Mark in-flight requests to distinguish later on
             sf_item.requested |= req_port;
+            sf_item.pending++;
             DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                     __func__,  sf_item.requested, sf_item.holder);
         } else {
@@ -140,29 +187,37 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         }
     } else { // if (!cpkt->needsResponse())
         assert(cpkt->isEviction());
-        // make sure that the sender actually had the line
-        panic_if((sf_item.holder & req_port).none(), "requestor %x is not a " \
-                 "holder :( SF value %x.%x\n", req_port,
-                 sf_item.requested, sf_item.holder);
-        // CleanEvicts and Writebacks -> the sender and all caches above
-        // it may not have the line anymore.
-        if (!cpkt->isBlockCached()) {
+        // make sure that the sender actually had the line, unless it
+        // was back-invalidated and then fetched by someone else while
+        // the eviction was on its way
+        panic_if(!table.bounded() && (sf_item.holder & req_port).none(),
+                 "requestor %x is not a holder :( SF value %x.%x\n",
+                 req_port, sf_item.requested, sf_item.holder);
+        if ((sf_item.holder & req_port).none()) {
+            DPRINTF(SnoopFilter, "%s:   requestor %x is not a holder\n",
+                    __func__, req_port);
+        } else if (!cpkt->isBlockCached() && isPrecise()) {
+            // CleanEvicts and Writebacks -> the sender and all caches
+            // above it may not have the line anymore. With coarse
+            // sharer vectors the other ports in the group may still
+            // hold it.
             sf_item.holder &= ~req_port;
             DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                     __func__,  sf_item.requested, sf_item.holder);
         }
     }
 
-    return snoopSelected(maskToPortList(interested & ~req_port), lookupLatency);
+    return snoopSelected(maskToPortList(interested, &cpu_side_port),
+                         lookupLatency);
 }
 
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.entry) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
+        assert(reqLookupResult.entry->tag == \
                 (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
                  (addr & ~(Addr(linesize - 1)))));
         if (will_retry) {
@@ -170,13 +225,14 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            reqLookupResult.entry->item = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(reqLookupResult.entry);
+        reqLookupResult.entry = nullptr;
     }
 }
 
@@ -191,20 +247,20 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    Entry *entry = table.find(line_addr);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!table.bounded() && !entry &&
+             (table.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
     // If the snoop filter has no entry, simply return a NULL
     // portlist, there is no point creating an entry only to remove it
     // later
-    if (!is_hit)
+    if (!entry)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = entry->item;
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -234,7 +290,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(entry);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -264,7 +320,11 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    // The requestor has a request in flight, so the line is pinned
+    Entry *entry = table.find(line_addr);
+    panic_if(!entry, "%s: no entry for snoop response to %#x\n",
+             __func__, line_addr);
+    SnoopItem& sf_item = entry->item;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -291,7 +351,7 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     assert(!cpkt->isWriteback());
     // @todo Deal with invalidating responses
     sf_item.holder |=  req_mask;
-    sf_item.requested &= ~req_mask;
+    table.clearRequest(sf_item, req_mask);
     assert((sf_item.requested | sf_item.holder).any());
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
@@ -311,18 +371,17 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    Entry *entry = table.find(line_addr);
 
     // Nothing to do if it is not a hit
-    if (!is_hit)
+    if (!entry)
         return;
 
     // If the snoop response has no sharers the line is passed in
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = entry->item;
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -330,7 +389,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(entry);
     }
 }
 
@@ -353,12 +412,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    Entry *entry = table.find(line_addr);
+    if (!entry)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = entry->item;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -368,16 +427,16 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
              "SF value %x.%x missing request bit\n",
              sf_item.requested, sf_item.holder);
 
-    sf_item.requested &= ~response_mask;
+    table.clearRequest(sf_item, response_mask);
     // Update the residency of the cache line.
 
     if (cpkt->req->isCacheMaintenance()) {
         // A cache clean response does not carry any data so it
         // shouldn't change the holders, unless it is invalidating.
-        if (cpkt->isInvalidate()) {
+        if (cpkt->isInvalidate() && isPrecise()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(entry);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -388,6 +447,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
             __func__, sf_item.requested, sf_item.holder);
 }
 
+bool
+SnoopFilter::isCached(const AddrRange &range) const
+{
+    return table.isCached(range);
+}
+
 SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
     : statistics::Group(parent),
       ADD_STAT(totRequests, statistics::units::Count::get(),
@@ -405,7 +470,10 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(evictions, statistics::units::Count::get(),
+               "Number of lines evicted from the snoop filter and "
+               "back-invalidated in the caches above.")
 {}
 
 void
@@ -43,13 +43,14 @@
 #ifndef __MEM_SNOOP_FILTER_HH__
 #define __MEM_SNOOP_FILTER_HH__
 
-#include <bitset>
-#include <unordered_map>
+#include <functional>
 #include <utility>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
+#include "mem/snoop_filter_table.hh"
 #include "params/SnoopFilter.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -69,6 +70,19 @@ namespace gem5
  * allows the snoop filter to model cache-line residency by snooping
  * the messages.
  *
+ * The lines are tracked in an unbounded map by default. Optionally
+ * they are tracked in a bounded, set-associative array instead (see
+ * SnoopFilterTable). When a new line needs an entry in a full set, the
+ * least recently used line without outstanding requests is evicted and
+ * the crossbar is asked to back-invalidate it in the caches above,
+ * using the callback registered with setBackInvalidate().
+ *
+ * The sharer vectors are either a full bitmap with one bit per
+ * snooping port, or optionally coarse vectors where each bit covers a
+ * group of ports. Coarse vectors are imprecise, i.e. a bit stays set
+ * as long as any port in the group may hold the line, and snoops go
+ * to every port in the group.
+ *
  * The tracking happens in two fields to be able to distinguish
  * between in-flight requests (in requested) and already pulled in
  * lines (in holder). This distinction is used for producing tighter
@@ -91,17 +105,19 @@ class SnoopFilter : public SimObject
   public:
 
     // Change for systems with more than 256 ports tracked by this object
-    static const int SNOOP_MASK_SIZE = 256;
+    static const int SNOOP_MASK_SIZE = SnoopFilterTable::SNOOP_MASK_SIZE;
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
-    {
-    }
+    /**
+     * Callback used to remove an evicted line from the caches above.
+     * It gets the line address, whether the line is secure, and the
+     * ports that may hold the line.
+     */
+    typedef std::function<void(Addr addr, bool is_secure,
+                               const SnoopList &ports)> BackInvalidateFunc;
+
+    SnoopFilter(const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -122,11 +138,17 @@ class SnoopFilter : public SimObject
         }
 
         // make sure we can deal with this many ports
-        fatal_if(id > SNOOP_MASK_SIZE,
-                 "Snoop filter only supports %d snooping ports, got %d\n",
-                 SNOOP_MASK_SIZE, id);
+        fatal_if(id > table.maxPorts(),
+                 "Snoop filter only supports %d snooping ports, got %d, "
+                 "consider coarser sharer vectors (sharer_group_size)\n",
+                 table.maxPorts(), id);
     }
 
+    /**
+     * Register the function used to back-invalidate evicted lines.
+     */
+    void setBackInvalidate(BackInvalidateFunc func) { backInvalidate = func; }
+
     /**
      * Lookup a request (from a CPU-side port) in the snoop filter and
      * return a list of other CPU-side ports that need forwarding of the
@@ -200,30 +222,27 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
+    /**
+     * Check if any line in an address range is held by, or has an
+     * outstanding request from, a cache above this snoop filter. The
+     * snoop filter state is not changed.
+     *
+     * @param range Address range to check, secure and non-secure lines
+     *              are both considered.
+     * @return True if any line in the range may be cached upstream.
+     */
+    bool isCached(const AddrRange &range) const;
+
+    /** Can tracked lines be evicted and back-invalidated? */
+    bool isBounded() const { return table.bounded(); }
+
     virtual void regStats();
 
   protected:
 
-    /**
-     * The underlying type for the bitmask we use for tracking. This
-     * limits the number of snooping ports supported per crossbar.
-     */
-    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
-
-    /**
-    * Per cache line item tracking a bitmask of ResponsePorts who have an
-    * outstanding request to this line (requested) or already share a
-    * cache line with this address (holder).
-    */
-    struct SnoopItem
-    {
-        SnoopMask requested;
-        SnoopMask holder;
-    };
-    /**
-     * HashMap of SnoopItems indexed by line address
-     */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
+    typedef SnoopFilterTable::SnoopMask SnoopMask;
+    typedef SnoopFilterTable::SnoopItem SnoopItem;
+    typedef SnoopFilterTable::Entry Entry;
 
     /**
      * Simple factory methods for standard return values.
@@ -252,19 +271,33 @@ class SnoopFilter : public SimObject
     /**
      * Converts a bitmask of ports into the corresponing list of ports
      * @param ports SnoopMask of the requested ports
+     * @param exclude Port to leave out of the list, if any
      * @return SnoopList containing all the requested ResponsePorts
      */
-    SnoopList maskToPortList(SnoopMask ports) const;
+    SnoopList maskToPortList(SnoopMask ports,
+                             const ResponsePort *exclude=nullptr) const;
+
+    /** Does every bit in a sharer vector stand for a single port? */
+    bool isPrecise() const { return table.isPrecise(); }
 
   private:
 
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(Entry *entry);
+
+    /**
+     * Allocate an entry for a line which is not tracked yet, evicting
+     * and back-invalidating a line if the set is full.
+     */
+    Entry *allocateEntry(Addr line_addr);
 
-    /** Simple hash set of cached addresses. */
-    SnoopFilterCache cachedLocations;
+    /** The tracked lines. */
+    SnoopFilterTable table;
+
+    /** Function used to remove evicted lines from the caches above. */
+    BackInvalidateFunc backInvalidate;
 
     /**
      * A request lookup must be followed by a call to finishRequest to inform
@@ -274,27 +307,15 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /** Entry used to store the result from lookupRequest. */
+        Entry *entry = nullptr;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
          * in case finishRequest needs to undo changes made in lookupRequest
          * (because of crossbar retry)
          */
-        SnoopItem retryItem;
-
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
+        SnoopItem retryItem = {0, 0, 0};
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -314,7 +335,7 @@ class SnoopFilter : public SimObject
     enum LineStatus
     {
         /** block holds data from the secure memory space */
-        LineSecure = 0x01,
+        LineSecure = SnoopFilterTable::LineSecure,
     };
 
     /** Statistics */
@@ -329,6 +350,8 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Scalar evictions;
     } stats;
 };
 
@@ -338,15 +361,16 @@ SnoopFilter::portToMask(const ResponsePort& port) const
     assert(port.getId() != InvalidPortID);
     // if this is not a snooping port, return a zero mask
     return !port.isSnooping() ? 0 :
-        ((SnoopMask)1) << localResponsePortIds[port.getId()];
+        table.portMask(localResponsePortIds[port.getId()]);
 }
 
 inline SnoopFilter::SnoopList
-SnoopFilter::maskToPortList(SnoopMask port_mask) const
+SnoopFilter::maskToPortList(SnoopMask port_mask,
+                            const ResponsePort *exclude) const
 {
     SnoopList res;
     for (const auto& p : cpuSidePorts)
-        if ((port_mask & portToMask(*p)).any())
+        if (p != exclude && (port_mask & portToMask(*p)).any())
             res.push_back(p);
     return res;
 }
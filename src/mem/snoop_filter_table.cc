@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Implementation of the line tracking structure of a snoop filter.
+ */
+
+#include "mem/snoop_filter_table.hh"
+
+#include <cassert>
+
+namespace gem5
+{
+
+const int SnoopFilterTable::SNOOP_MASK_SIZE;
+
+SnoopFilterTable::SnoopFilterTable(uint64_t num_lines, unsigned assoc,
+                                   unsigned group_size, Addr line_size) :
+    assoc(assoc), groupSize(group_size), lineSize(line_size),
+    setMask(assoc ? num_lines / assoc - 1 : 0)
+{
+    if (bounded())
+        entries.resize((setMask + 1) * assoc);
+}
+
+SnoopFilterTable::Entry *
+SnoopFilterTable::find(Addr line_addr)
+{
+    if (!bounded()) {
+        auto it = lines.find(line_addr);
+        return it == lines.end() ? nullptr : &it->second;
+    }
+
+    Entry *set = setOf(line_addr);
+    for (unsigned way = 0; way < assoc; way++) {
+        if (set[way].tag == line_addr)
+            return &set[way];
+    }
+    return nullptr;
+}
+
+const SnoopFilterTable::Entry *
+SnoopFilterTable::find(Addr line_addr) const
+{
+    return const_cast<SnoopFilterTable *>(this)->find(line_addr);
+}
+
+SnoopFilterTable::Entry *
+SnoopFilterTable::allocate(Addr line_addr, Entry &victim)
+{
+    assert(!find(line_addr));
+    victim = Entry();
+
+    Entry *entry = nullptr;
+    if (!bounded()) {
+        // references to the elements of an unordered_map stay valid
+        // when it rehashes
+        entry = &lines[line_addr];
+    } else {
+        Entry *set = setOf(line_addr);
+        for (unsigned way = 0; way < assoc; way++) {
+            if (!set[way].valid()) {
+                entry = &set[way];
+                break;
+            }
+            // Lines with requests in flight can't be evicted, the
+            // responses still need to find them
+            if (set[way].item.pending == 0 &&
+                (!entry || set[way].lastUse < entry->lastUse)) {
+                entry = &set[way];
+            }
+        }
+        if (!entry)
+            return nullptr;
+        if (entry->valid()) {
+            victim = *entry;
+            numValid--;
+        }
+    }
+
+    entry->tag = line_addr;
+    entry->item = {0, 0, 0};
+    touch(entry);
+    numValid++;
+    return entry;
+}
+
+bool
+SnoopFilterTable::eraseIfNull(Entry *entry)
+{
+    if ((entry->item.requested | entry->item.holder).any())
+        return false;
+
+    assert(entry->item.pending == 0);
+    numValid--;
+    if (bounded())
+        entry->tag = MaxAddr;
+    else
+        lines.erase(entry->tag);
+    return true;
+}
+
+void
+SnoopFilterTable::clearRequest(SnoopItem &item, SnoopMask port_mask) const
+{
+    assert(item.pending > 0);
+    item.pending--;
+    // With coarse sharer vectors other ports sharing the bit may still
+    // have requests in flight, keep the bit until all are done
+    if (isPrecise())
+        item.requested &= ~port_mask;
+    else if (item.pending == 0)
+        item.requested = 0;
+}
+
+bool
+SnoopFilterTable::isCached(const AddrRange &range) const
+{
+    if (numValid == 0)
+        return false;
+
+    const Addr first = range.start() & ~(lineSize - 1);
+    const Addr num_lines = (range.end() - first + lineSize - 1) / lineSize;
+
+    // Walk whichever is smaller, the lines in the range or the table,
+    // so large ranges stay cheap.
+    auto intersects = [&](const Entry &entry) {
+        return entry.valid() && range.intersects(
+            RangeSize(entry.tag & ~Addr(LineSecure), lineSize));
+    };
+    if (bounded() && num_lines > entries.size()) {
+        for (const auto &entry : entries) {
+            if (intersects(entry))
+                return true;
+        }
+        return false;
+    } else if (!bounded() && num_lines > lines.size()) {
+        for (const auto &line : lines) {
+            if (intersects(line.second))
+                return true;
+        }
+        return false;
+    }
+
+    for (Addr line_addr = first; line_addr < range.end();
+         line_addr += lineSize) {
+        if (find(line_addr) || find(line_addr | LineSecure))
+            return true;
+    }
+    return false;
+}
+
+} // namespace gem5
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definition of the line tracking structure of a snoop filter.
+ */
+
+#ifndef __MEM_SNOOP_FILTER_TABLE_HH__
+#define __MEM_SNOOP_FILTER_TABLE_HH__
+
+#include <bitset>
+#include <unordered_map>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * The lines tracked by a snoop filter, and the sharer vectors of each
+ * line.
+ *
+ * By default the table is an unbounded hash map with one entry per
+ * tracked line. Given an associativity, it is instead a bounded,
+ * set-associative array. Tracking a new line in a full set then
+ * evicts the least recently used line without requests in flight,
+ * which the snoop filter has to back-invalidate in the caches above.
+ *
+ * The sharer vectors have one bit per snooping port, or with coarse
+ * vectors one bit per group of ports. A coarse bit stays set as long
+ * as any port in its group may hold the line.
+ */
+class SnoopFilterTable
+{
+  public:
+
+    // Change for systems with more than 256 ports tracked by this object
+    static const int SNOOP_MASK_SIZE = 256;
+
+    /**
+     * The underlying type for the bitmask we use for tracking. This
+     * limits the number of snooping ports supported per crossbar.
+     */
+    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
+
+    /**
+     * Use the lower bits of the address to keep track of the line status
+     */
+    enum LineStatus
+    {
+        /** block holds data from the secure memory space */
+        LineSecure = 0x01,
+    };
+
+    /**
+    * Per cache line item tracking a bitmask of ResponsePorts who have an
+    * outstanding request to this line (requested) or already share a
+    * cache line with this address (holder).
+    */
+    struct SnoopItem
+    {
+        SnoopMask requested;
+        SnoopMask holder;
+        /** Number of outstanding requests, an entry with any is pinned */
+        uint32_t pending;
+    };
+
+    /**
+     * A tracked line. Unused entries of a bounded table have an
+     * invalid tag.
+     */
+    struct Entry
+    {
+        /** Line address, including the LineSecure bit */
+        Addr tag = MaxAddr;
+        SnoopItem item = {0, 0, 0};
+        /** Last use of this entry, for LRU replacement */
+        uint64_t lastUse = 0;
+
+        bool valid() const { return tag != MaxAddr; }
+    };
+
+    /**
+     * @param num_lines Number of lines a bounded table can track
+     * @param assoc Associativity, or 0 for an unbounded table
+     * @param group_size Number of ports sharing a sharer vector bit
+     * @param line_size Cache line size in bytes
+     */
+    SnoopFilterTable(uint64_t num_lines, unsigned assoc, unsigned group_size,
+                     Addr line_size);
+
+    /** Is the number of tracked lines limited? */
+    bool bounded() const { return assoc != 0; }
+
+    /** Does every bit in a sharer vector stand for a single port? */
+    bool isPrecise() const { return groupSize == 1; }
+
+    /** Number of snooping ports the sharer vectors can track. */
+    unsigned maxPorts() const { return SNOOP_MASK_SIZE * groupSize; }
+
+    /** Number of tracked lines. */
+    size_t size() const { return numValid; }
+
+    /**
+     * Sharer vector bit of a port.
+     *
+     * @param local_id Index of the port among the snooping ports.
+     */
+    SnoopMask
+    portMask(unsigned local_id) const
+    {
+        return SnoopMask(1) << (local_id / groupSize);
+    }
+
+    /**
+     * Find the entry tracking a line.
+     *
+     * @param line_addr Line address, including the LineSecure bit.
+     * @return The entry, or nullptr if the line is not tracked.
+     */
+    Entry *find(Addr line_addr);
+    const Entry *find(Addr line_addr) const;
+
+    /**
+     * Start tracking a line which is not tracked yet. If the line's
+     * set is full, a line is evicted to make room for it.
+     *
+     * @param line_addr Line address, including the LineSecure bit.
+     * @param victim Set to the evicted line, invalid if there was none.
+     * @return The new, empty, entry, or nullptr if every line in the
+     *         set has requests in flight.
+     */
+    Entry *allocate(Addr line_addr, Entry &victim);
+
+    /** Mark an entry as the most recently used one. */
+    void touch(Entry *entry) { entry->lastUse = ++useCounter; }
+
+    /**
+     * Stop tracking a line if it has no requestors and no holders.
+     *
+     * @return True if the line was removed.
+     */
+    bool eraseIfNull(Entry *entry);
+
+    /**
+     * A request or snoop response for a line is done, update the
+     * requested bits accordingly.
+     */
+    void clearRequest(SnoopItem &item, SnoopMask port_mask) const;
+
+    /**
+     * Check if any line in an address range is tracked, whether it is
+     * secure or not.
+     */
+    bool isCached(const AddrRange &range) const;
+
+  private:
+
+    /** Ways of the set a line maps to in a bounded table. */
+    Entry *
+    setOf(Addr line_addr)
+    {
+        return &entries[((line_addr / lineSize) & setMask) * assoc];
+    }
+
+    /** Associativity, 0 if the table is unbounded. */
+    const unsigned assoc;
+    /** Number of ports represented by each bit in a sharer vector. */
+    const unsigned groupSize;
+    /** Cache line size. */
+    const Addr lineSize;
+    /** Mask to extract the set index from a line number. */
+    const Addr setMask;
+
+    /** All entries of a bounded table, stored set by set. */
+    std::vector<Entry> entries;
+    /** Entries of an unbounded table, indexed by line address. */
+    std::unordered_map<Addr, Entry> lines;
+
+    /** Number of tracked lines. */
+    size_t numValid = 0;
+    /** Time stamp for LRU replacement. */
+    uint64_t useCounter = 0;
+};
+
+} // namespace gem5
+
+#endif // __MEM_SNOOP_FILTER_TABLE_HH__
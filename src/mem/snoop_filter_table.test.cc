@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/snoop_filter_table.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const Addr lineSize = 64;
+
+/** Address of the n-th line mapping to a set of a table. */
+Addr
+lineInSet(unsigned set, unsigned num_sets, unsigned n)
+{
+    return (set + n * num_sets) * lineSize;
+}
+
+} // anonymous namespace
+
+/** An unbounded table tracks any number of lines and never evicts. */
+TEST(SnoopFilterTableTest, UnboundedNeverEvicts)
+{
+    SnoopFilterTable table(4, 0, 1, lineSize);
+    EXPECT_FALSE(table.bounded());
+
+    for (Addr line = 0; line < 100; line++) {
+        SnoopFilterTable::Entry victim;
+        auto *entry = table.allocate(line * lineSize, victim);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_FALSE(victim.valid());
+        entry->item.holder = 1;
+    }
+    EXPECT_EQ(table.size(), 100u);
+
+    for (Addr line = 0; line < 100; line++) {
+        auto *entry = table.find(line * lineSize);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->tag, line * lineSize);
+    }
+
+    // Only lines without holders or requestors are removed
+    auto *entry = table.find(0);
+    EXPECT_FALSE(table.eraseIfNull(entry));
+    entry->item.holder = 0;
+    EXPECT_TRUE(table.eraseIfNull(entry));
+    EXPECT_EQ(table.find(0), nullptr);
+    EXPECT_EQ(table.size(), 99u);
+}
+
+/** Secure and non-secure copies of a line are tracked separately. */
+TEST(SnoopFilterTableTest, SecureLines)
+{
+    SnoopFilterTable table(8, 2, 1, lineSize);
+    SnoopFilterTable::Entry victim;
+    table.allocate(lineSize, victim);
+    EXPECT_NE(table.find(lineSize), nullptr);
+    EXPECT_EQ(table.find(lineSize | SnoopFilterTable::LineSecure), nullptr);
+
+    table.allocate(lineSize | SnoopFilterTable::LineSecure, victim);
+    EXPECT_FALSE(victim.valid());
+    EXPECT_NE(table.find(lineSize | SnoopFilterTable::LineSecure), nullptr);
+    EXPECT_EQ(table.size(), 2u);
+}
+
+/**
+ * Tracking a new line in a full set evicts the least recently used
+ * line, and hands its sharer vectors back so the caller can
+ * back-invalidate it.
+ */
+TEST(SnoopFilterTableTest, EvictLeastRecentlyUsed)
+{
+    const unsigned num_sets = 4;
+    const unsigned assoc = 2;
+    SnoopFilterTable table(num_sets * assoc, assoc, 1, lineSize);
+    EXPECT_TRUE(table.bounded());
+
+    SnoopFilterTable::Entry victim;
+    auto *a = table.allocate(lineInSet(1, num_sets, 0), victim);
+    a->item.holder = table.portMask(3);
+    auto *b = table.allocate(lineInSet(1, num_sets, 1), victim);
+    b->item.holder = table.portMask(5);
+    EXPECT_FALSE(victim.valid());
+
+    // Lines in other sets do not compete with the ones in set 1
+    table.allocate(lineInSet(2, num_sets, 0), victim);
+    EXPECT_FALSE(victim.valid());
+
+    // Using a makes b the least recently used line of the set
+    table.touch(a);
+    auto *c = table.allocate(lineInSet(1, num_sets, 2), victim);
+    ASSERT_NE(c, nullptr);
+    ASSERT_TRUE(victim.valid());
+    EXPECT_EQ(victim.tag, lineInSet(1, num_sets, 1));
+    EXPECT_EQ(victim.item.holder, table.portMask(5));
+
+    // The new line starts out with empty sharer vectors
+    EXPECT_EQ(c->tag, lineInSet(1, num_sets, 2));
+    EXPECT_TRUE(c->item.holder.none());
+    EXPECT_TRUE(c->item.requested.none());
+    EXPECT_EQ(table.find(lineInSet(1, num_sets, 1)), nullptr);
+    EXPECT_NE(table.find(lineInSet(1, num_sets, 0)), nullptr);
+    EXPECT_EQ(table.size(), 3u);
+}
+
+/** Lines with requests in flight are never evicted. */
+TEST(SnoopFilterTableTest, PendingLinesArePinned)
+{
+    const unsigned num_sets = 2;
+    const unsigned assoc = 2;
+    SnoopFilterTable table(num_sets * assoc, assoc, 1, lineSize);
+
+    SnoopFilterTable::Entry victim;
+    auto *a = table.allocate(lineInSet(0, num_sets, 0), victim);
+    a->item.requested = table.portMask(0);
+    a->item.pending = 1;
+    auto *b = table.allocate(lineInSet(0, num_sets, 1), victim);
+    b->item.holder = table.portMask(1);
+
+    // a is the least recently used line, but it is pinned
+    table.allocate(lineInSet(0, num_sets, 2), victim);
+    ASSERT_TRUE(victim.valid());
+    EXPECT_EQ(victim.tag, lineInSet(0, num_sets, 1));
+
+    // Once every line of the set is pinned there is nothing to evict
+    auto *c = table.find(lineInSet(0, num_sets, 2));
+    c->item.pending = 1;
+    EXPECT_EQ(table.allocate(lineInSet(0, num_sets, 3), victim), nullptr);
+    EXPECT_FALSE(victim.valid());
+    EXPECT_EQ(table.size(), 2u);
+
+    // Once the request completes the line can go again
+    table.clearRequest(a->item, table.portMask(0));
+    EXPECT_NE(table.allocate(lineInSet(0, num_sets, 3), victim), nullptr);
+    ASSERT_TRUE(victim.valid());
+    EXPECT_EQ(victim.tag, lineInSet(0, num_sets, 0));
+}
+
+/** Precise sharer vectors have one bit per port. */
+TEST(SnoopFilterTableTest, PreciseSharerVectors)
+{
+    SnoopFilterTable table(16, 0, 1, lineSize);
+    EXPECT_TRUE(table.isPrecise());
+    EXPECT_EQ(table.maxPorts(),
+              unsigned(SnoopFilterTable::SNOOP_MASK_SIZE));
+    EXPECT_NE(table.portMask(0), table.portMask(1));
+
+    SnoopFilterTable::SnoopItem item = {0, 0, 0};
+    item.requested = table.portMask(0) | table.portMask(1);
+    item.pending = 2;
+    table.clearRequest(item, table.portMask(0));
+    EXPECT_EQ(item.requested, table.portMask(1));
+    EXPECT_EQ(item.pending, 1u);
+    table.clearRequest(item, table.portMask(1));
+    EXPECT_TRUE(item.requested.none());
+    EXPECT_EQ(item.pending, 0u);
+}
+
+/**
+ * With coarse sharer vectors a bit covers a group of ports, and the
+ * requested bit is only cleared once all requests of the group are done.
+ */
+TEST(SnoopFilterTableTest, CoarseSharerVectors)
+{
+    const unsigned group_size = 4;
+    SnoopFilterTable table(16, 0, group_size, lineSize);
+    EXPECT_FALSE(table.isPrecise());
+    EXPECT_EQ(table.maxPorts(),
+              SnoopFilterTable::SNOOP_MASK_SIZE * group_size);
+
+    EXPECT_EQ(table.portMask(0), table.portMask(3));
+    EXPECT_NE(table.portMask(3), table.portMask(4));
+    EXPECT_EQ(table.portMask(4), table.portMask(7));
+    EXPECT_EQ(table.portMask(SnoopFilterTable::SNOOP_MASK_SIZE *
+                             group_size - 1).count(), 1u);
+
+    // Ports 1 and 2 share a bit and both have a request in flight
+    SnoopFilterTable::SnoopItem item = {0, 0, 0};
+    item.requested = table.portMask(1);
+    item.pending = 2;
+    table.clearRequest(item, table.portMask(1));
+    EXPECT_EQ(item.requested, table.portMask(2));
+    EXPECT_EQ(item.pending, 1u);
+    table.clearRequest(item, table.portMask(2));
+    EXPECT_TRUE(item.requested.none());
+}
+
+/** Ranges are checked against lines, secure or not, in either table. */
+TEST(SnoopFilterTableTest, IsCached)
+{
+    for (unsigned assoc : {0u, 2u}) {
+        SnoopFilterTable table(8, assoc, 1, lineSize);
+        EXPECT_FALSE(table.isCached(RangeSize(0, 1 << 20)));
+
+        SnoopFilterTable::Entry victim;
+        table.allocate((10 * lineSize) | SnoopFilterTable::LineSecure,
+                       victim);
+
+        // Short ranges look up each line
+        EXPECT_TRUE(table.isCached(RangeSize(10 * lineSize + 8, 4)));
+        EXPECT_TRUE(table.isCached(RangeSize(9 * lineSize, 2 * lineSize)));
+        EXPECT_FALSE(table.isCached(RangeSize(11 * lineSize, lineSize)));
+
+        // Long ranges walk the table
+        EXPECT_TRUE(table.isCached(RangeSize(0, 1 << 20)));
+        EXPECT_FALSE(table.isCached(RangeSize(11 * lineSize, 1 << 20)));
+    }
+}
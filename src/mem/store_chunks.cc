@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/store_chunks.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "base/intmath.hh"
+#include "mem/store_image.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+void
+parallelFor(size_t count, const std::function<void(size_t)> &func)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++)
+            func(i);
+    };
+
+    size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < std::min(num_threads, count); t++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads)
+        thread.join();
+}
+
+bool
+compressChunk(const uint8_t *data, uint64_t size, uint64_t page_size,
+              std::vector<uint8_t> &out)
+{
+    const uint64_t num_pages = divCeil(size, page_size);
+    std::vector<uint8_t> raw(divCeil(num_pages, 8));
+    for (uint64_t page = 0; page < num_pages; page++) {
+        const uint64_t offset = page * page_size;
+        const uint64_t len = std::min(page_size, size - offset);
+        if (isZero(data + offset, len))
+            continue;
+        raw[page / 8] |= 1 << (page % 8);
+        raw.insert(raw.end(), data + offset, data + offset + len);
+    }
+
+    out.clear();
+    if (raw.size() == divCeil(num_pages, 8))
+        return true;
+
+    z_stream strm = {};
+    // a window size of 15 + 16 produces a gzip rather than a zlib stream
+    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    out.resize(deflateBound(&strm, raw.size()));
+    strm.next_in = raw.data();
+    strm.avail_in = raw.size();
+    strm.next_out = out.data();
+    strm.avail_out = out.size();
+    const int ret = deflate(&strm, Z_FINISH);
+    out.resize(strm.total_out);
+    deflateEnd(&strm);
+    return ret == Z_STREAM_END;
+}
+
+bool
+decompressChunk(const std::vector<uint8_t> &in, uint8_t *data,
+                uint64_t size, uint64_t page_size)
+{
+    const uint64_t num_pages = divCeil(size, page_size);
+    const uint64_t bitmap_size = divCeil(num_pages, 8);
+    std::vector<uint8_t> raw(bitmap_size + size);
+
+    z_stream strm = {};
+    if (inflateInit2(&strm, 15 + 16) != Z_OK)
+        return false;
+    strm.next_in = const_cast<uint8_t *>(in.data());
+    strm.avail_in = in.size();
+    strm.next_out = raw.data();
+    strm.avail_out = raw.size();
+    const int ret = inflate(&strm, Z_FINISH);
+    const uint64_t raw_size = strm.total_out;
+    inflateEnd(&strm);
+    if (ret != Z_STREAM_END || raw_size < bitmap_size)
+        return false;
+
+    uint64_t pos = bitmap_size;
+    for (uint64_t page = 0; page < num_pages; page++) {
+        if (!(raw[page / 8] & (1 << (page % 8))))
+            continue;
+        const uint64_t offset = page * page_size;
+        const uint64_t len = std::min(page_size, size - offset);
+        if (pos + len > raw_size)
+            return false;
+        memcpy(data + offset, raw.data() + pos, len);
+        pos += len;
+    }
+    return pos == raw_size;
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_STORE_CHUNKS_HH__
+#define __MEM_STORE_CHUNKS_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * @file
+ * Chunks of compressed images of the backing stores in a checkpoint.
+ *
+ * Compressed stores are split into chunks that are compressed and
+ * decompressed independently, and in parallel. Within a chunk, pages
+ * that are all zero are left out. Every chunk is stored as a gzip
+ * member holding a bitmap of the pages that are present followed by
+ * those pages, and chunks without any such pages aren't stored at all.
+ */
+
+/** Call func for every index below count using all the host cores. */
+void parallelFor(size_t count, const std::function<void(size_t)> &func);
+
+/**
+ * Compress a chunk of a store. The output is empty if all the pages in
+ * the chunk are zero.
+ *
+ * @param data The start of the chunk
+ * @param size The size of the chunk, the last page may be partial
+ * @param page_size The granularity at which zero pages are left out
+ * @param out The compressed chunk
+ * @return False if zlib failed to compress the chunk.
+ */
+bool compressChunk(const uint8_t *data, uint64_t size, uint64_t page_size,
+                   std::vector<uint8_t> &out);
+
+/**
+ * Decompress a chunk of a store into memory. The pages that aren't in
+ * the chunk aren't touched.
+ *
+ * @param in The compressed chunk, which must not be empty
+ * @param data The start of the chunk in memory
+ * @param size The size of the chunk
+ * @param page_size The page size the chunk was compressed with
+ * @return False if the chunk is corrupt.
+ */
+bool decompressChunk(const std::vector<uint8_t> &in, uint8_t *data,
+                     uint64_t size, uint64_t page_size);
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_STORE_CHUNKS_HH__
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "mem/store_chunks.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+const uint64_t pageSize = 4096;
+
+/** A chunk with a pattern in the pages selected by a mask. */
+std::vector<uint8_t>
+makeChunk(uint64_t size, uint64_t page_mask)
+{
+    std::vector<uint8_t> chunk(size);
+    for (uint64_t offset = 0; offset < size; offset++) {
+        if (page_mask & (1ULL << (offset / pageSize)))
+            chunk[offset] = offset * 7 + 1;
+    }
+    return chunk;
+}
+
+/** Compress a chunk and check that it decompresses into zero memory. */
+void
+roundTrip(const std::vector<uint8_t> &chunk)
+{
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(compressChunk(chunk.data(), chunk.size(), pageSize,
+                              compressed));
+    ASSERT_FALSE(compressed.empty());
+
+    std::vector<uint8_t> restored(chunk.size());
+    ASSERT_TRUE(decompressChunk(compressed, restored.data(),
+                                restored.size(), pageSize));
+    EXPECT_EQ(restored, chunk);
+}
+
+} // anonymous namespace
+
+/** Chunks of zero pages aren't stored at all. */
+TEST(StoreChunksTest, ZeroChunk)
+{
+    std::vector<uint8_t> compressed(10, 1);
+    const std::vector<uint8_t> chunk(16 * pageSize);
+    ASSERT_TRUE(compressChunk(chunk.data(), chunk.size(), pageSize,
+                              compressed));
+    EXPECT_TRUE(compressed.empty());
+}
+
+/** Pages with data round trip, whichever of them are zero. */
+TEST(StoreChunksTest, RoundTrip)
+{
+    roundTrip(makeChunk(16 * pageSize, 0xffff));
+    roundTrip(makeChunk(16 * pageSize, 0x0001));
+    roundTrip(makeChunk(16 * pageSize, 0x8000));
+    roundTrip(makeChunk(16 * pageSize, 0x5a5a));
+    // more pages than a byte of the bitmap holds
+    roundTrip(makeChunk(9 * pageSize, 0x100));
+}
+
+/** Zero pages are left out, so they don't overwrite memory. */
+TEST(StoreChunksTest, ZeroPagesUntouched)
+{
+    const auto chunk = makeChunk(8 * pageSize, 0x0f);
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(compressChunk(chunk.data(), chunk.size(), pageSize,
+                              compressed));
+
+    std::vector<uint8_t> restored(chunk.size(), 0xee);
+    ASSERT_TRUE(decompressChunk(compressed, restored.data(),
+                                restored.size(), pageSize));
+    for (uint64_t offset = 0; offset < chunk.size(); offset++) {
+        const uint8_t expected = offset < 4 * pageSize ? chunk[offset] : 0xee;
+        ASSERT_EQ(restored[offset], expected) << offset;
+    }
+}
+
+/** The last page of the last chunk of a store may be partial. */
+TEST(StoreChunksTest, PartialLastPage)
+{
+    roundTrip(makeChunk(3 * pageSize + 100, 0xf));
+    roundTrip(makeChunk(3 * pageSize + 100, 0x8));
+    roundTrip(makeChunk(100, 0x1));
+
+    // the partial page is left out if it's zero
+    std::vector<uint8_t> compressed;
+    const auto chunk = makeChunk(2 * pageSize + 100, 0x1);
+    ASSERT_TRUE(compressChunk(chunk.data(), chunk.size(), pageSize,
+                              compressed));
+    std::vector<uint8_t> restored(chunk.size(), 0xee);
+    ASSERT_TRUE(decompressChunk(compressed, restored.data(),
+                                restored.size(), pageSize));
+    EXPECT_EQ(restored[2 * pageSize + 99], 0xee);
+}
+
+/** Chunks that are damaged or don't fit the memory are rejected. */
+TEST(StoreChunksTest, Corrupt)
+{
+    const auto chunk = makeChunk(8 * pageSize, 0x35);
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(compressChunk(chunk.data(), chunk.size(), pageSize,
+                              compressed));
+    std::vector<uint8_t> restored(chunk.size());
+
+    // not gzip at all
+    std::vector<uint8_t> garbage(compressed.size(), 0x42);
+    EXPECT_FALSE(decompressChunk(garbage, restored.data(), restored.size(),
+                                 pageSize));
+
+    // truncated
+    std::vector<uint8_t> truncated(compressed.begin(),
+                                   compressed.end() - 10);
+    EXPECT_FALSE(decompressChunk(truncated, restored.data(),
+                                 restored.size(), pageSize));
+
+    // a flipped bit in the compressed data fails the CRC
+    std::vector<uint8_t> flipped = compressed;
+    flipped[flipped.size() / 2] ^= 0x10;
+    EXPECT_FALSE(decompressChunk(flipped, restored.data(), restored.size(),
+                                 pageSize));
+
+    // the bitmap names fewer pages than are stored
+    EXPECT_FALSE(decompressChunk(compressed, restored.data(),
+                                 4 * pageSize, pageSize));
+
+    // the bitmap names more data than is stored
+    const auto half = makeChunk(8 * pageSize, 0x0f);
+    std::vector<uint8_t> half_compressed;
+    ASSERT_TRUE(compressChunk(half.data(), half.size(), pageSize,
+                              half_compressed));
+    std::vector<uint8_t> larger(16 * pageSize);
+    EXPECT_FALSE(decompressChunk(half_compressed, larger.data(),
+                                 larger.size(), 2 * pageSize));
+
+    // the intact chunk still works
+    std::fill(restored.begin(), restored.end(), 0);
+    EXPECT_TRUE(decompressChunk(compressed, restored.data(),
+                                restored.size(), pageSize));
+    EXPECT_EQ(restored, chunk);
+}
+
+/** Every index is visited exactly once, whatever the count. */
+TEST(StoreChunksTest, ParallelFor)
+{
+    for (size_t count : {0, 1, 2, 3, 100, 1000}) {
+        std::vector<std::atomic<int>> visits(count);
+        parallelFor(count, [&](size_t i) { visits[i]++; });
+        for (size_t i = 0; i < count; i++)
+            EXPECT_EQ(visits[i], 1) << count << " " << i;
+    }
+}
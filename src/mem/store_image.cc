@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/store_image.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "base/logging.hh"
+
+/**
+ * On Linux, MAP_NORESERVE allow us to simulate a very large memory
+ * without committing to actually providing the swap space on the
+ * host. On FreeBSD or OSX the MAP_NORESERVE flag does not exist,
+ * so simply make it 0.
+ */
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+#endif
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+std::string
+tempPath(const std::string &path)
+{
+    return path + ".tmp";
+}
+
+} // anonymous namespace
+
+bool
+isZero(const uint8_t *data, uint64_t size)
+{
+    const uint64_t *words = (const uint64_t *)data;
+    for (uint64_t i = 0; i < size / sizeof(uint64_t); i++) {
+        if (words[i])
+            return false;
+    }
+    for (uint64_t i = size & ~(sizeof(uint64_t) - 1); i < size; i++) {
+        if (data[i])
+            return false;
+    }
+    return true;
+}
+
+int
+createImage(const std::string &path)
+{
+    int fd = open(tempPath(path).c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                  0664);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n", path);
+    return fd;
+}
+
+void
+replaceImage(int fd, const std::string &path)
+{
+    if (close(fd))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              path);
+    if (rename(tempPath(path).c_str(), path.c_str()))
+        fatal("Can't replace physical memory checkpoint file '%s'\n", path);
+}
+
+void
+writeRawImage(const std::string &path, const uint8_t *data, uint64_t size,
+              uint64_t page_size)
+{
+    int fd = createImage(path);
+
+    // size the file up front so that pages that are all zero end up
+    // as holes rather than taking up space on disk
+    if (ftruncate(fd, size) == -1)
+        fatal("Can't size physical memory checkpoint file '%s'\n", path);
+
+    // write runs of non-zero pages with as few calls as possible
+    uint64_t run_start = 0;
+    uint64_t run_end = 0;
+    auto flush = [&]() {
+        while (run_start < run_end) {
+            ssize_t ret = pwrite(fd, data + run_start, run_end - run_start,
+                                 run_start);
+            if (ret == -1 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", path);
+            run_start += ret;
+        }
+    };
+
+    for (uint64_t offset = 0; offset < size; offset += page_size) {
+        const uint64_t len = std::min(page_size, size - offset);
+        if (isZero(data + offset, len)) {
+            flush();
+        } else {
+            if (run_end != offset)
+                run_start = offset;
+            run_end = offset + len;
+        }
+    }
+    flush();
+
+    replaceImage(fd, path);
+}
+
+bool
+mapRawImage(const std::string &path, uint8_t *data, uint64_t size,
+            bool no_reserve)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n", path);
+
+    int map_flags = MAP_PRIVATE | MAP_FIXED;
+    if (no_reserve)
+        map_flags |= MAP_NORESERVE;
+    void *mapped = mmap(data, size, PROT_READ | PROT_WRITE, map_flags, fd, 0);
+    close(fd);
+
+    if (mapped == MAP_FAILED)
+        return false;
+    assert(mapped == data);
+    return true;
+}
+
+void
+readRawImage(const std::string &path, uint8_t *data, uint64_t size,
+             uint64_t page_size)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n", path);
+
+    // only copy pages that are non-zero, so we don't give the VM
+    // system hell
+    const uint64_t chunk_size = 1 << 20;
+    std::vector<uint8_t> chunk(chunk_size);
+    for (uint64_t offset = 0; offset < size; ) {
+        ssize_t bytes_read = pread(fd, chunk.data(),
+            std::min(chunk_size, size - offset), offset);
+        if (bytes_read == -1 && errno == EINTR)
+            continue;
+        if (bytes_read <= 0)
+            fatal("Read failed on physical memory checkpoint file '%s'\n",
+                  path);
+
+        for (ssize_t x = 0; x < bytes_read; x += page_size) {
+            const uint64_t len = std::min<uint64_t>(page_size,
+                                                    bytes_read - x);
+            if (!isZero(chunk.data() + x, len))
+                memcpy(data + offset + x, chunk.data() + x, len);
+        }
+        offset += bytes_read;
+    }
+
+    close(fd);
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_STORE_IMAGE_HH__
+#define __MEM_STORE_IMAGE_HH__
+
+#include <cstdint>
+#include <string>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * @file
+ * Files holding images of the backing stores in a checkpoint.
+ *
+ * A restored backing store may still be mapped from the image it was
+ * restored from (see mapRawImage()), and checkpoints can be taken into
+ * the directory they were restored from. Images are therefore never
+ * overwritten in place: truncating a file that is mapped would take the
+ * pages that haven't been touched yet out from under the simulation.
+ * Instead, a new image is written to a temporary file which is then
+ * renamed over the old one, which stays around for as long as it is
+ * mapped.
+ */
+
+/** Are all size bytes at data zero? */
+bool isZero(const uint8_t *data, uint64_t size);
+
+/**
+ * Create a temporary file to write a new image to.
+ *
+ * @param path The file the image replaces once it is complete
+ * @return The file descriptor of the temporary file
+ */
+int createImage(const std::string &path);
+
+/**
+ * Close a file created by createImage() and move it to its path,
+ * replacing the previous image.
+ */
+void replaceImage(int fd, const std::string &path);
+
+/**
+ * Write an uncompressed image with the same layout as the memory it
+ * holds. Pages that are all zero are left as holes in the file.
+ */
+void writeRawImage(const std::string &path, const uint8_t *data,
+                   uint64_t size, uint64_t page_size);
+
+/**
+ * Map an uncompressed image copy-on-write over memory, so that pages
+ * are only read from the file once they are touched and writes never
+ * reach the file.
+ *
+ * @return False if the image can't be mapped
+ */
+bool mapRawImage(const std::string &path, uint8_t *data, uint64_t size,
+                 bool no_reserve);
+
+/**
+ * Read an uncompressed image into memory. Pages that are all zero in
+ * the image aren't written to the memory.
+ */
+void readRawImage(const std::string &path, uint8_t *data, uint64_t size,
+                  uint64_t page_size);
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_STORE_IMAGE_HH__
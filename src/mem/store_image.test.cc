@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mem/store_image.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+const uint64_t pageSize = 4096;
+const uint64_t numPages = 64;
+const uint64_t storeSize = numPages * pageSize;
+
+/** A store standing in for a backing store, which images map over. */
+class Store
+{
+  public:
+    uint8_t *data;
+
+    Store()
+    {
+        void *p = mmap(nullptr, storeSize, PROT_READ | PROT_WRITE,
+                       MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        EXPECT_NE(p, MAP_FAILED);
+        data = static_cast<uint8_t *>(p);
+    }
+
+    ~Store() { munmap(data, storeSize); }
+
+    /** Fill every third page with a pattern, leave the others zero. */
+    void
+    fill(uint8_t seed)
+    {
+        for (uint64_t page = 0; page < numPages; page += 3)
+            memset(data + page * pageSize, seed + page, pageSize);
+    }
+};
+
+/** Create a file name for an image in a temporary directory. */
+std::string
+imagePath(std::string &dir)
+{
+    char name[] = "store_image-XXXXXX";
+    EXPECT_NE(mkdtemp(name), nullptr);
+    dir = name;
+    return dir + "/store.pmem";
+}
+
+} // anonymous namespace
+
+/** A raw image reads back as the memory it was written from. */
+TEST(StoreImageTest, RawRoundTrip)
+{
+    std::string dir;
+    const std::string path = imagePath(dir);
+    Store original, restored;
+    original.fill(1);
+
+    writeRawImage(path, original.data, storeSize, pageSize);
+    struct stat st;
+    ASSERT_EQ(stat(path.c_str(), &st), 0);
+    EXPECT_EQ(st.st_size, storeSize);
+
+    readRawImage(path, restored.data, storeSize, pageSize);
+    EXPECT_EQ(memcmp(original.data, restored.data, storeSize), 0);
+
+    Store mapped;
+    ASSERT_TRUE(mapRawImage(path, mapped.data, storeSize, false));
+    EXPECT_EQ(memcmp(original.data, mapped.data, storeSize), 0);
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * Checkpointing into the directory a store was restored from replaces
+ * the image the store is mapped from. The pages that haven't been
+ * touched since the restore must still read as they were.
+ */
+TEST(StoreImageTest, RewriteMappedImage)
+{
+    std::string dir;
+    const std::string path = imagePath(dir);
+    Store original, mapped, restored;
+    original.fill(1);
+
+    writeRawImage(path, original.data, storeSize, pageSize);
+    ASSERT_TRUE(mapRawImage(path, mapped.data, storeSize, false));
+
+    // The guest changes a page, and a new checkpoint is written from
+    // the mapping to the same file
+    memset(mapped.data + 6 * pageSize, 0xff, pageSize);
+    memset(original.data + 6 * pageSize, 0xff, pageSize);
+    writeRawImage(path, mapped.data, storeSize, pageSize);
+
+    EXPECT_EQ(memcmp(original.data, mapped.data, storeSize), 0);
+
+    readRawImage(path, restored.data, storeSize, pageSize);
+    EXPECT_EQ(memcmp(original.data, restored.data, storeSize), 0);
+
+    // Only the image is left in the directory
+    EXPECT_NE(access((path + ".tmp").c_str(), F_OK), 0);
+    unlink(path.c_str());
+    EXPECT_EQ(rmdir(dir.c_str()), 0);
+}
+
+/** Images written with createImage() only appear once complete. */
+TEST(StoreImageTest, ReplaceImage)
+{
+    std::string dir;
+    const std::string path = imagePath(dir);
+    Store original, restored;
+    original.fill(1);
+    writeRawImage(path, original.data, storeSize, pageSize);
+
+    int fd = createImage(path);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(write(fd, "new", 3), 3);
+
+    readRawImage(path, restored.data, storeSize, pageSize);
+    EXPECT_EQ(memcmp(original.data, restored.data, storeSize), 0);
+
+    replaceImage(fd, path);
+    struct stat st;
+    ASSERT_EQ(stat(path.c_str(), &st), 0);
+    EXPECT_EQ(st.st_size, 3);
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
@@ -100,10 +100,13 @@ ProtoOutputStream::write(const Message& msg)
     msg.SerializeWithCachedSizes(&codedStream);
 }
 
-ProtoInputStream::ProtoInputStream(const std::string& filename) :
+ProtoInputStream::ProtoInputStream(const std::string& filename,
+                                   bool prefetch) :
     fileStream(filename.c_str(), std::ios::in | std::ios::binary),
     fileName(filename), useGzip(false),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    messagesRead(0), prefetch(prefetch), prefetchDone(false),
+    prefetchStop(false), currentPos(0)
 {
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
@@ -118,6 +121,7 @@ ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream.seekg(0, std::ifstream::beg);
 
     createStreams();
+    startPrefetch();
 }
 
 void
@@ -144,6 +148,7 @@ ProtoInputStream::createStreams()
         magic_check != magicNumber)
         panic("Input file %s is not a valid gem5 proto format.\n",
               fileName);
+    messagesRead = 0;
 }
 
 void
@@ -163,6 +168,7 @@ ProtoInputStream::destroyStreams()
 
 ProtoInputStream::~ProtoInputStream()
 {
+    stopPrefetch();
     destroyStreams();
     fileStream.close();
 }
@@ -171,16 +177,194 @@ ProtoInputStream::~ProtoInputStream()
 void
 ProtoInputStream::reset()
 {
+    stopPrefetch();
     destroyStreams();
     // seek to the start of the input file and clear any flags
     fileStream.clear();
     fileStream.seekg(0, std::ifstream::beg);
     createStreams();
+    startPrefetch();
+}
+
+gem5::DrainState
+ProtoInputStream::drain()
+{
+    // The thread must not be running when the simulator forks, the
+    // child would neither have it nor be able to take its lock
+    pausePrefetch();
+    return gem5::DrainState::Drained;
+}
+
+void
+ProtoInputStream::drainResume()
+{
+    startPrefetch();
+}
+
+void
+ProtoInputStream::notifyFork()
+{
+    // The system is drained, so the prefetching thread isn't running
+    assert(!prefetchThread.joinable());
+
+    const uint64_t num_msgs = messagesRead;
+    destroyStreams();
+    fileStream.close();
+    fileStream.clear();
+    fileStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!fileStream.good())
+        panic("Could not reopen %s for reading\n", fileName);
+    createStreams();
+
+    std::string data;
+    for (uint64_t i = 0; i < num_msgs; ++i) {
+        if (!readRaw(data))
+            panic("Could not skip to message %d of %s\n", num_msgs, fileName);
+    }
+}
+
+void
+ProtoInputStream::startPrefetch()
+{
+    if (!prefetch || prefetchDone ||
+        drainState() == gem5::DrainState::Drained) {
+        return;
+    }
+
+    assert(!prefetchThread.joinable());
+    prefetchThread = std::thread([this]() { prefetchMain(); });
+}
+
+void
+ProtoInputStream::pausePrefetch()
+{
+    if (!prefetchThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        prefetchStop = true;
+    }
+    batchTaken.notify_all();
+    prefetchThread.join();
+    prefetchStop = false;
+}
+
+void
+ProtoInputStream::stopPrefetch()
+{
+    pausePrefetch();
+
+    readyBatches.clear();
+    currentBatch.clear();
+    currentPos = 0;
+    prefetchDone = false;
+}
+
+void
+ProtoInputStream::prefetchMain()
+{
+    while (true) {
+        Batch batch;
+        {
+            std::unique_lock<std::mutex> lock(prefetchMutex);
+            batchTaken.wait(lock, [this]() {
+                return prefetchStop || readyBatches.size() < prefetchBatches;
+            });
+            if (prefetchStop)
+                return;
+
+            // Reuse the buffers of a consumed batch if there is one
+            if (!freeBatches.empty()) {
+                batch = std::move(freeBatches.back());
+                freeBatches.pop_back();
+            }
+        }
+
+        // The stream is only ever touched by this thread while it
+        // is running, so the reading itself is done without the lock
+        batch.resize(prefetchBatchSize);
+        size_t num_msgs = 0;
+        while (num_msgs < prefetchBatchSize && readRaw(batch[num_msgs]))
+            ++num_msgs;
+        batch.resize(num_msgs);
+        const bool done = num_msgs < prefetchBatchSize;
+
+        {
+            std::lock_guard<std::mutex> lock(prefetchMutex);
+            if (num_msgs)
+                readyBatches.push_back(std::move(batch));
+            prefetchDone = done;
+        }
+        batchReady.notify_one();
+
+        if (done)
+            return;
+    }
+}
+
+bool
+ProtoInputStream::readRaw(std::string& data)
+{
+    uint32_t size;
+
+    // See read() for why the coded stream is created per message
+    io::CodedInputStream codedStream(zeroCopyStream);
+    if (!codedStream.ReadVarint32(&size))
+        return false;
+
+    if (!codedStream.ReadString(&data, size))
+        panic("Unable to read message from coded stream %s\n", fileName);
+
+    ++messagesRead;
+    return true;
+}
+
+bool
+ProtoInputStream::nextBatch()
+{
+    std::unique_lock<std::mutex> lock(prefetchMutex);
+    if (readyBatches.empty() && !prefetchDone &&
+        !prefetchThread.joinable()) {
+        // The thread is stopped while the simulator is drained, so read
+        // the next message directly
+        lock.unlock();
+        currentBatch.resize(1);
+        currentPos = 0;
+        if (readRaw(currentBatch[0]))
+            return true;
+        currentBatch.clear();
+        prefetchDone = true;
+        return false;
+    }
+
+    batchReady.wait(lock, [this]() {
+        return !readyBatches.empty() || prefetchDone;
+    });
+    if (readyBatches.empty())
+        return false;
+
+    freeBatches.push_back(std::move(currentBatch));
+    currentBatch = std::move(readyBatches.front());
+    readyBatches.pop_front();
+    currentPos = 0;
+    batchTaken.notify_one();
+    return true;
 }
 
 bool
 ProtoInputStream::read(Message& msg)
 {
+    if (prefetch) {
+        if (currentPos == currentBatch.size() && !nextBatch())
+            return false;
+
+        if (!msg.ParseFromString(currentBatch[currentPos++]))
+            panic("Unable to read message from coded stream %s\n",
+                  fileName);
+        return true;
+    }
+
     // Read a message from the stream by getting the size, using it as
     // a limit when parsing the message, then popping the limit again
     uint32_t size;
@@ -193,6 +377,7 @@ ProtoInputStream::read(Message& msg)
         io::CodedInputStream::Limit limit = codedStream.PushLimit(size);
         if (msg.ParseFromCodedStream(&codedStream)) {
             codedStream.PopLimit(limit);
+            ++messagesRead;
             // All went well, the message is parsed and the limit is
             // popped again
             return true;
@@ -49,7 +49,15 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sim/drain.hh"
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -136,8 +144,15 @@ class ProtoOutputStream : public ProtoStream
  * stream is done on a per-message basis to avoid having to deal with
  * huge data structures. The latter assumes the length of each message
  * is encoded in the stream when it is written.
+ *
+ * The stream is drainable so that the prefetching thread is stopped
+ * whenever the simulator is drained, e.g., before forking or taking a
+ * checkpoint, and started again when the simulator resumes. Messages
+ * that were already prefetched are kept, and read() falls back to
+ * reading the file itself while the thread is stopped. In the child of
+ * a fork the file is reopened to get a private file offset.
  */
-class ProtoInputStream : public ProtoStream
+class ProtoInputStream : public ProtoStream, public gem5::Drainable
 {
 
   public:
@@ -146,9 +161,16 @@ class ProtoInputStream : public ProtoStream
      * Create an input stream for a given file name. If the filename
      * ends with .gz then the file will be decompressed accordingly.
      *
+     * When prefetching, a helper thread reads and decompresses the
+     * messages ahead of the consumer, and keeps them in a bounded
+     * buffer. Only the parsing of the messages is left to read(),
+     * which makes replaying large compressed traces much cheaper for
+     * the simulation thread.
+     *
      * @param filename Path to the file to read from
+     * @param prefetch Read the messages in a helper thread
      */
-    ProtoInputStream(const std::string& filename);
+    ProtoInputStream(const std::string& filename, bool prefetch=false);
 
     /**
      * Destruct the input stream, and also close the underlying file
@@ -169,6 +191,16 @@ class ProtoInputStream : public ProtoStream
      */
     void reset();
 
+    gem5::DrainState drain() override;
+    void drainResume() override;
+
+    /**
+     * Reopen the file in the child of a fork, which would otherwise
+     * share the file offset with the parent, and skip the messages
+     * that have already been read.
+     */
+    void notifyFork() override;
+
   private:
 
     /**
@@ -181,6 +213,38 @@ class ProtoInputStream : public ProtoStream
      */
     void destroyStreams();
 
+    /**
+     * Read the serialized form of the next message from the file.
+     *
+     * @param data Buffer to store the message in
+     * @return True if a message was read, false at the end of the file
+     */
+    bool readRaw(std::string& data);
+
+    /** Main loop of the prefetching thread. */
+    void prefetchMain();
+
+    /**
+     * Start the prefetching thread at the current file position, unless
+     * prefetching is disabled, the simulator is drained or the end of
+     * the file has already been reached.
+     */
+    void startPrefetch();
+
+    /** Stop the prefetching thread, keeping the prefetched messages. */
+    void pausePrefetch();
+
+    /** Stop the prefetching thread and drop all prefetched messages. */
+    void stopPrefetch();
+
+    /**
+     * Make the next batch of messages the current one, waiting for the
+     * prefetching thread if needed.
+     *
+     * @return True if there was another batch, false at the end of file
+     */
+    bool nextBatch();
+
     /// Underlying file input stream
     std::ifstream fileStream;
 
@@ -199,6 +263,48 @@ class ProtoInputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
 
+    /// Number of messages read from the file since it was opened
+    uint64_t messagesRead;
+
+    /// Number of messages handed over to the consumer at a time
+    static const size_t prefetchBatchSize = 1024;
+
+    /// Maximum number of batches buffered ahead of the consumer
+    static const size_t prefetchBatches = 8;
+
+    /// A batch of serialized messages
+    typedef std::vector<std::string> Batch;
+
+    /// Whether messages are read by a helper thread
+    const bool prefetch;
+
+    /// Thread reading ahead in the file
+    std::thread prefetchThread;
+
+    /// Protects all prefetching state shared with the helper thread
+    std::mutex prefetchMutex;
+
+    /// Signalled when a batch is ready or the end of file is reached
+    std::condition_variable batchReady;
+
+    /// Signalled when the consumer has taken a batch
+    std::condition_variable batchTaken;
+
+    /// Batches ready to be consumed
+    std::deque<Batch> readyBatches;
+
+    /// Consumed batches kept to recycle their buffers
+    std::vector<Batch> freeBatches;
+
+    /// Set when the helper thread has reached the end of the file
+    bool prefetchDone;
+
+    /// Set to ask the helper thread to exit
+    bool prefetchStop;
+
+    /// Batch currently being consumed and the position within it
+    Batch currentBatch;
+    size_t currentPos;
 };
 
 #endif //__PROTO_PROTOIO_HH
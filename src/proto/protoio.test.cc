@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "proto/protoio.hh"
+#include "sim/drain.hh"
+
+using namespace gem5;
+
+using google::protobuf::UInt64Value;
+
+namespace
+{
+
+/** More messages than the prefetching thread buffers ahead. */
+const uint64_t numMessages = 20000;
+
+class ProtoIOTest : public testing::TestWithParam<bool>
+{
+  protected:
+    void
+    SetUp() override
+    {
+        fileName = testing::TempDir() + "protoio_test" +
+            (gzip() ? ".gz" : ".bin");
+        ProtoOutputStream out(fileName);
+        UInt64Value msg;
+        for (uint64_t i = 0; i < numMessages; i++) {
+            msg.set_value(i);
+            out.write(msg);
+        }
+    }
+
+    void
+    TearDown() override
+    {
+        std::remove(fileName.c_str());
+        if (DrainManager::instance().isDrained())
+            DrainManager::instance().resume();
+    }
+
+    bool gzip() const { return GetParam(); }
+
+    /** Read a number of messages and check that they are in order. */
+    void
+    expectMessages(ProtoInputStream &in, uint64_t first, uint64_t count)
+    {
+        UInt64Value msg;
+        for (uint64_t i = first; i < first + count; i++) {
+            ASSERT_TRUE(in.read(msg));
+            ASSERT_EQ(msg.value(), i);
+        }
+    }
+
+    std::string fileName;
+};
+
+} // anonymous namespace
+
+TEST_P(ProtoIOTest, Read)
+{
+    for (bool prefetch : { false, true }) {
+        ProtoInputStream in(fileName, prefetch);
+        expectMessages(in, 0, numMessages);
+        UInt64Value msg;
+        EXPECT_FALSE(in.read(msg));
+        EXPECT_FALSE(in.read(msg));
+    }
+}
+
+TEST_P(ProtoIOTest, Reset)
+{
+    for (bool prefetch : { false, true }) {
+        ProtoInputStream in(fileName, prefetch);
+        expectMessages(in, 0, 5000);
+        in.reset();
+        expectMessages(in, 0, numMessages);
+        UInt64Value msg;
+        EXPECT_FALSE(in.read(msg));
+        in.reset();
+        expectMessages(in, 0, 10);
+    }
+}
+
+/**
+ * Draining stops the prefetching thread, as needed before a fork. The
+ * stream keeps the messages that were already prefetched and reads the
+ * file itself until the simulator resumes.
+ */
+TEST_P(ProtoIOTest, DrainResume)
+{
+    ProtoInputStream in(fileName, true);
+    expectMessages(in, 0, 1500);
+
+    ASSERT_TRUE(DrainManager::instance().tryDrain());
+    EXPECT_EQ(in.drainState(), DrainState::Drained);
+    expectMessages(in, 1500, 10000);
+
+    DrainManager::instance().resume();
+    EXPECT_EQ(in.drainState(), DrainState::Running);
+    expectMessages(in, 11500, 1000);
+
+    ASSERT_TRUE(DrainManager::instance().tryDrain());
+    DrainManager::instance().resume();
+    expectMessages(in, 12500, numMessages - 12500);
+    UInt64Value msg;
+    EXPECT_FALSE(in.read(msg));
+
+    // Nothing is left to prefetch, so resuming doesn't start a thread
+    ASSERT_TRUE(DrainManager::instance().tryDrain());
+    DrainManager::instance().resume();
+    EXPECT_FALSE(in.read(msg));
+    in.reset();
+    expectMessages(in, 0, numMessages);
+}
+
+/**
+ * Forking a drained simulator leaves the child without the prefetching
+ * thread, which the stream starts again when the child resumes. The
+ * child reopens the file, so the parent's and the child's reads don't
+ * interfere with each other.
+ */
+TEST_P(ProtoIOTest, Fork)
+{
+    ProtoInputStream in(fileName, true);
+    expectMessages(in, 0, 1500);
+    ASSERT_TRUE(DrainManager::instance().tryDrain());
+
+    const pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        DrainManager::instance().notifyFork();
+        DrainManager::instance().resume();
+        UInt64Value msg;
+        for (uint64_t i = 1500; i < numMessages; i++) {
+            if (!in.read(msg) || msg.value() != i)
+                _exit(1);
+        }
+        _exit(in.read(msg) ? 1 : 0);
+    }
+
+    int status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    DrainManager::instance().resume();
+    expectMessages(in, 1500, numMessages - 1500);
+}
+
+/**
+ * A stream opened while the simulator is drained starts prefetching
+ * when it resumes.
+ */
+TEST_P(ProtoIOTest, OpenWhileDrained)
+{
+    ASSERT_TRUE(DrainManager::instance().tryDrain());
+    ProtoInputStream in(fileName, true);
+    expectMessages(in, 0, 100);
+    DrainManager::instance().resume();
+    expectMessages(in, 100, numMessages - 100);
+    UInt64Value msg;
+    EXPECT_FALSE(in.read(msg));
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, ProtoIOTest, testing::Bool(),
+    [](const testing::TestParamInfo<bool> &info) {
+        return info.param ? "Gzip" : "Plain";
+    });
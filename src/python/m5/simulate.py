@@ -321,7 +321,14 @@ def memInvalidate(root):
         obj.memInvalidate()
 
 
-def checkpoint(dir):
+def checkpoint(dir, binary=False):
+    """Write a checkpoint of the simulated system to dir.
+
+    Binary checkpoints store memory as raw images that are mapped in
+    lazily when restoring, which makes restoring large systems much
+    faster. They can be converted to and from the text format using
+    util/cpt_convert.py.
+    """
     root = objects.Root.getInstance()
     if not isinstance(root, objects.Root):
         raise TypeError("Checkpoint must be called on a root object.")
@@ -333,7 +340,7 @@ def checkpoint(dir):
     os.makedirs(dir, exist_ok=True)
 
     print("Writing checkpoint")
-    _m5.core.serializeAll(dir)
+    _m5.core.serializeAll(dir, binary)
 
 
 def _changeMemoryMode(system, mode):
@@ -419,19 +426,31 @@ def switchCpus(system, cpuList, verbose=True):
         # Flush the memory system if we are switching to a memory mode
         # that disables caches. This typically happens when switching to a
         # hardware virtualized CPU.
-        if memory_mode == MemoryMode("atomic_noncaching").getValue():
+        noncaching = MemoryMode("atomic_noncaching").getValue()
+        if memory_mode == noncaching:
             memWriteback(system)
             memInvalidate(system)
 
+        was_noncaching = system.getMemoryMode() == noncaching
         _changeMemoryMode(system, memory_mode)
 
+        # Caches with a warmer only have their tags updated while they
+        # are bypassed, and get their data once they are back in use.
+        for obj in system.descendants():
+            if isinstance(obj, objects.CacheWarmer):
+                if memory_mode == noncaching:
+                    obj.startWarming()
+                elif was_noncaching:
+                    obj.stopWarming()
+
     for old_cpu, new_cpu in cpuList:
         new_cpu.takeOverFrom(old_cpu)
 
 
 def notifyFork(root):
-    for obj in root.descendants():
-        obj.notifyFork()
+    # Notify all drainable objects rather than just the SimObjects under
+    # root, objects like trace streams need to reopen their files too
+    _drain_manager.notifyFork()
 
 
 fork_count = 0
@@ -190,6 +190,29 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["columnar"])
+def _columnarFactory(fn, desc=True):
+    """Output stats in a columnar binary format.
+
+    Columnar stat files store the names of the stats once, followed by
+    a row of raw values per stat dump. This makes frequent stat dumps
+    much cheaper than with the text format, which formats every value
+    on every dump. The files can be read using m5.stats.columnar.
+
+    Known limitations:
+      * Sparse histograms are unsupported.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+
+    Example:
+      columnar://stats.bin?desc=False
+
+    """
+
+    return _m5.stats.initColumnar(fn, desc)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
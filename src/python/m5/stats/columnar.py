@@ -0,0 +1,156 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Reader for stat files written by the columnar stat output.
+
+A columnar stat file holds a row of values for every stat dump. The
+names of the columns are stored in schema records, and a new schema is
+only stored when the set of stats that are dumped changes. Example::
+
+    from m5.stats.columnar import ColumnarStats
+
+    stats = ColumnarStats("m5out/stats.bin")
+    for tick, ipc in stats.column("system.cpu.ipc"):
+        print(tick, ipc)
+
+This module doesn't depend on the rest of gem5 and can be used outside
+of the simulator.
+"""
+
+import struct
+from array import array
+from typing import (
+    Dict,
+    Iterator,
+    List,
+    NamedTuple,
+    Tuple,
+)
+
+MAGIC = b"gem5stat"
+VERSION = 1
+
+
+class Stat(NamedTuple):
+    """A stat and the names of its columns."""
+
+    name: str
+    unit: str
+    desc: str
+    columns: Tuple[str, ...]
+
+
+class Dump(NamedTuple):
+    """The values of all the columns of a stat dump."""
+
+    tick: int
+    columns: Tuple[str, ...]
+    values: array
+
+    def as_dict(self) -> Dict[str, float]:
+        return dict(zip(self.columns, self.values))
+
+
+class ColumnarStats:
+    """The contents of a columnar stat file."""
+
+    def __init__(self, path: str):
+        with open(path, "rb") as f:
+            self._data = f.read()
+        self._pos = 0
+
+        if self._read(len(MAGIC)) != MAGIC:
+            raise ValueError(f"{path} is not a columnar stat file")
+        (version,) = self._unpack("=I")
+        if version != VERSION:
+            raise ValueError(f"Unsupported stat file version {version}")
+
+        self.stats: List[Stat] = []
+        self.dumps: List[Dump] = []
+        columns: Tuple[str, ...] = ()
+        while self._pos < len(self._data):
+            (record,) = self._unpack("=B")
+            if record == ord("S"):
+                self.stats = self._read_schema()
+                columns = tuple(c for stat in self.stats for c in stat.columns)
+            elif record == ord("R"):
+                tick, count = self._unpack("=QI")
+                if count != len(columns):
+                    raise ValueError("Row doesn't match the schema")
+                values = array("d")
+                values.frombytes(self._read(count * values.itemsize))
+                self.dumps.append(Dump(tick, columns, values))
+            else:
+                raise ValueError(f"Unknown record type {record}")
+        del self._data
+
+    def _read(self, size: int) -> bytes:
+        if self._pos + size > len(self._data):
+            raise ValueError("Truncated columnar stat file")
+        data = self._data[self._pos : self._pos + size]
+        self._pos += size
+        return data
+
+    def _unpack(self, fmt: str) -> tuple:
+        return struct.unpack(fmt, self._read(struct.calcsize(fmt)))
+
+    def _read_string(self) -> str:
+        (size,) = self._unpack("=I")
+        return self._read(size).decode()
+
+    def _read_schema(self) -> List[Stat]:
+        (num_stats,) = self._unpack("=I")
+        stats = []
+        for _ in range(num_stats):
+            name = self._read_string()
+            unit = self._read_string()
+            desc = self._read_string()
+            (num_columns,) = self._unpack("=I")
+            columns = tuple(self._read_string() for _ in range(num_columns))
+            stats.append(Stat(name, unit, desc, columns))
+        return stats
+
+    def __len__(self) -> int:
+        return len(self.dumps)
+
+    def __iter__(self) -> Iterator[Dump]:
+        return iter(self.dumps)
+
+    def column(self, name: str) -> List[Tuple[int, float]]:
+        """Get the value of a column in all the dumps that include it,
+        together with the tick of the dump."""
+
+        result = []
+        index = None
+        columns = None
+        for dump in self.dumps:
+            if dump.columns is not columns:
+                columns = dump.columns
+                index = columns.index(name) if name in columns else None
+            if index is not None:
+                result.append((dump.tick, dump.values[index]))
+        return result
@@ -110,6 +110,7 @@ init_drain(py::module_ &m_native)
         .def("tryDrain", &DrainManager::tryDrain)
         .def("resume", &DrainManager::resume)
         .def("preCheckpointRestore", &DrainManager::preCheckpointRestore)
+        .def("notifyFork", &DrainManager::notifyFork)
         .def("isDrained", &DrainManager::isDrained)
         .def("state", &DrainManager::state)
         .def("signalDrainDone", &DrainManager::signalDrainDone)
@@ -333,7 +334,8 @@ pybind_init_core(py::module_ &m_native)
      * Serialization helpers
      */
     m_core
-        .def("serializeAll", &SimObject::serializeAll)
+        .def("serializeAll", &SimObject::serializeAll,
+             py::arg("cpt_dir"), py::arg("binary") = false)
         .def("getCheckpoint", [](const std::string &cpt_dir) {
             SimObject::setSimObjectResolver(&pybindSimObjectResolver);
             return new CheckpointIn(cpt_dir);
@@ -42,6 +42,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -116,6 +117,7 @@ pybind_init_stats(py::module_ &m_native)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
+        .def("initColumnar", &statistics::initColumnar)
         .def("registerPythonStatsHandlers",
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
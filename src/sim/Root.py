@@ -31,6 +31,11 @@ from m5.SimObject import SimObject
 from m5.util import fatal
 
 
+class EventQueueBackend(ScopedEnum):
+    "Data structure used to keep scheduled events in order."
+    vals = ["List", "Calendar"]
+
+
 class Root(SimObject):
     _the_instance = None
 
@@ -67,6 +72,26 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # The quantum can be widened up to sim_quantum_max while the event
+    # queues rarely schedule events on each other. This is faster, but
+    # events that arrive at a queue after their time are serviced late.
+    sim_quantum_max = Param.Tick(
+        0, "maximum adaptive simulation quantum, 0 for a fixed quantum"
+    )
+    sim_quantum_threshold = Param.Unsigned(
+        0,
+        "number of events scheduled across event queues in a quantum "
+        "above which an adaptive quantum is halved; the quantum is "
+        "doubled when there are at most half as many",
+    )
+
+    # Both backends service events in exactly the same order. The
+    # calendar queue has O(1) amortized insertion, which pays off when
+    # there are many pending events at distinct times.
+    event_queue_backend = Param.EventQueueBackend(
+        "List", "data structure used by the main event queues"
+    )
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
@@ -145,6 +145,17 @@ DrainManager::preCheckpointRestore()
         obj->_drainState = DrainState::Drained;
 }
 
+void
+DrainManager::notifyFork()
+{
+    panic_if(_state != DrainState::Drained,
+             "notifyFork() called on a system that isn't drained.\n");
+
+    DPRINTF(Drain, "Notifying %u objects of a fork.\n", drainableCount());
+    for (auto *obj : _allDrainable)
+        obj->notifyFork();
+}
+
 void
 DrainManager::signalDrainDone()
 {
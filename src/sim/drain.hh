@@ -137,6 +137,17 @@ class DrainManager
      */
     void preCheckpointRestore();
 
+    /**
+     * Notify all Drainable objects in the child of a fork.
+     *
+     * This reaches drainable objects that aren't SimObjects, e.g.,
+     * input streams that need to reopen their files, as well as all
+     * SimObjects. It must be called in a drained system.
+     *
+     * @ingroup api_drain
+     */
+    void notifyFork();
+
     /**
      * Check if the system is drained
      *
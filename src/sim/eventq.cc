@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -37,6 +38,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
@@ -46,6 +48,8 @@ namespace gem5
 {
 
 Tick simQuantum = 0;
+Tick simQuantumMax = 0;
+uint64_t simQuantumThreshold = 0;
 
 //
 // Main Event Queues
@@ -58,13 +62,16 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+static EventQueue::Backend mainEventQueueBackend = EventQueue::Backend::List;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
         numMainEventQueues++;
         mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+            new EventQueue(csprintf("MainEventQueue-%d", index),
+                           mainEventQueueBackend));
     }
 
     return mainEventQueue[index];
@@ -137,6 +144,11 @@ Event::releaseImpl()
 void
 EventQueue::insert(Event *event)
 {
+    if (_backend == Backend::Calendar) {
+        calInsert(event);
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -196,6 +208,11 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (_backend == Backend::Calendar) {
+        calRemove(event);
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -228,7 +245,11 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (_backend == Backend::Calendar) {
+        // the head is always the first bin of its bucket, so this
+        // doesn't need to search
+        calRemove(event);
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -244,6 +265,7 @@ EventQueue::serviceOne()
     if (!event->squashed()) {
         // forward current cycle to the time when this event occurs.
         setCurTick(event->when());
+        _curPriority = event->priority();
         if (debug::Event)
             event->trace("executed");
         event->process();
@@ -321,15 +343,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : sortedBins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -342,10 +361,38 @@ EventQueue::debugVerify() const
     std::unordered_map<long, bool> map;
 
     Tick time = 0;
-    short priority = 0;
+    short priority = Event::Minimum_Pri;
+
+    if (_backend == Backend::Calendar) {
+        size_t num_bins = 0;
+        for (size_t i = 0; i < calBuckets.size(); ++i) {
+            for (Event *bin = calBuckets[i]; bin; bin = bin->nextBin) {
+                if (calBucket(bin->when()) != i) {
+                    cprintf("bin in the wrong bucket!");
+                    bin->dump();
+                    return false;
+                }
+                if (bin->nextBin && *bin->nextBin <= *bin) {
+                    cprintf("bucket out of order!");
+                    bin->dump();
+                    return false;
+                }
+                if (*bin < *head) {
+                    cprintf("bin before head!");
+                    bin->dump();
+                    return false;
+                }
+                num_bins++;
+            }
+        }
+        if (num_bins != calNumBins) {
+            cprintf("calendar has %d bins, expected %d", num_bins,
+                    calNumBins);
+            return false;
+        }
+    }
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (Event *nextBin : sortedBins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -371,8 +418,6 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
@@ -381,11 +426,241 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
-    Event* t = head;
-    head = s;
+    if (_backend == Backend::List) {
+        Event* t = head;
+        head = s;
+        return t;
+    }
+
+    // Hand out (and take back) the events as a plain list of bins so
+    // that the caller doesn't need to know about the backend.
+    Event *t = calDetach();
+    while (s) {
+        Event *next = s->nextBin;
+        calLink(s);
+        calNumBins++;
+        if (!head || *s < *head)
+            head = s;
+        s = next;
+    }
+    size_t num_buckets = calBuckets.size();
+    while (calNumBins > 2 * num_buckets)
+        num_buckets *= 2;
+    if (num_buckets != calBuckets.size())
+        calResize(num_buckets);
     return t;
 }
 
+void
+EventQueue::setBackend(Backend backend)
+{
+    if (backend == _backend)
+        return;
+
+    assert(!inParallelMode);
+
+    Event *bins = replaceHead(nullptr);
+    _backend = backend;
+    if (_backend == Backend::Calendar) {
+        calBuckets.assign(calMinBuckets, nullptr);
+        calWidthShift = calInitWidthShift;
+        calNumBins = 0;
+    } else {
+        std::vector<Event *>().swap(calBuckets);
+    }
+    replaceHead(bins);
+}
+
+std::vector<Event *>
+EventQueue::sortedBins() const
+{
+    std::vector<Event *> bins;
+    if (_backend == Backend::Calendar) {
+        bins.reserve(calNumBins);
+        for (Event *bucket : calBuckets) {
+            for (Event *bin = bucket; bin; bin = bin->nextBin)
+                bins.push_back(bin);
+        }
+        std::sort(bins.begin(), bins.end(),
+                  [](const Event *l, const Event *r) { return *l < *r; });
+    } else {
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+    return bins;
+}
+
+void
+EventQueue::calInsert(Event *event)
+{
+    Event *&bucket = calBuckets[calBucket(event->when())];
+
+    // This is the same as the list insertion, but within a (hopefully
+    // short) bucket rather than the whole queue.
+    if (!bucket || *event <= *bucket) {
+        bucket = Event::insertBefore(event, bucket);
+    } else {
+        Event *prev = bucket;
+        Event *curr = bucket->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        prev->nextBin = Event::insertBefore(event, curr);
+    }
+
+    // An event that joins an existing bin becomes the top of its stack
+    if (!event->nextInBin)
+        calNumBins++;
+
+    if (!head || *event <= *head)
+        head = event;
+
+    if (calNumBins > 2 * calBuckets.size())
+        calResize(2 * calBuckets.size());
+}
+
+void
+EventQueue::calRemove(Event *event)
+{
+    Event *&bucket = calBuckets[calBucket(event->when())];
+    if (!bucket)
+        panic("event not found!");
+
+    Event *top;
+    if (*bucket == *event) {
+        top = bucket;
+        bucket = Event::removeItem(event, top);
+    } else {
+        Event *prev = bucket;
+        Event *curr = bucket->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+
+        if (!curr || *curr != *event)
+            panic("event not found!");
+
+        top = curr;
+        prev->nextBin = Event::removeItem(event, top);
+    }
+
+    // removeItem() leaves the pointers of the removed event alone
+    const bool bin_removed = event == top && !event->nextInBin;
+    if (bin_removed)
+        calNumBins--;
+
+    if (event == head) {
+        // Nothing can be scheduled before the event we just removed
+        head = bin_removed ? calFindMin(event->when()) : event->nextInBin;
+    }
+
+    if (calNumBins < calBuckets.size() / 2 &&
+        calBuckets.size() > calMinBuckets) {
+        calResize(calBuckets.size() / 2);
+    }
+}
+
+void
+EventQueue::calLink(Event *top)
+{
+    Event *&bucket = calBuckets[calBucket(top->when())];
+    if (!bucket || *top < *bucket) {
+        top->nextBin = bucket;
+        bucket = top;
+        return;
+    }
+
+    Event *prev = bucket;
+    while (prev->nextBin && *prev->nextBin < *top)
+        prev = prev->nextBin;
+    top->nextBin = prev->nextBin;
+    prev->nextBin = top;
+}
+
+Event *
+EventQueue::calFindMin(Tick when) const
+{
+    if (calNumBins == 0)
+        return nullptr;
+
+    // Walk one "year" of buckets starting at the bucket of the given
+    // time. The first bin of a bucket that falls within the current
+    // bucket-sized window is the earliest bin in the queue.
+    const size_t mask = calBuckets.size() - 1;
+    Tick window = when >> calWidthShift;
+    for (size_t i = 0; i < calBuckets.size(); ++i) {
+        const Event *bin = calBuckets[window & mask];
+        if (bin && (bin->when() >> calWidthShift) == window)
+            return const_cast<Event *>(bin);
+        window++;
+    }
+
+    // Every bin is more than a year away, fall back to a direct
+    // search of the bucket heads.
+    Event *min = nullptr;
+    for (Event *bin : calBuckets) {
+        if (bin && (!min || *bin < *min))
+            min = bin;
+    }
+    return min;
+}
+
+void
+EventQueue::calResize(size_t num_buckets)
+{
+    assert(isPowerOf2(num_buckets));
+
+    std::vector<Event *> bins;
+    bins.reserve(calNumBins);
+    for (Event *bucket : calBuckets) {
+        for (Event *bin = bucket; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+    assert(bins.size() == calNumBins);
+
+    // Estimate the bucket width from the average separation of the
+    // bins at the front of the queue, ignoring outliers, as suggested
+    // by Brown.
+    const size_t samples = std::min<size_t>(bins.size(), 25);
+    if (samples > 1) {
+        auto less = [](const Event *l, const Event *r) { return *l < *r; };
+        std::partial_sort(bins.begin(), bins.begin() + samples, bins.end(),
+                          less);
+        const Tick avg = (bins[samples - 1]->when() - bins[0]->when()) /
+            (samples - 1);
+        Tick total = 0;
+        Tick count = 0;
+        for (size_t i = 1; i < samples; ++i) {
+            const Tick sep = bins[i]->when() - bins[i - 1]->when();
+            if (sep <= 2 * avg) {
+                total += sep;
+                count++;
+            }
+        }
+        const Tick width = count ? 3 * total / count : 3 * avg;
+        calWidthShift = std::min(width > 1 ? ceilLog2(width) : 0, 48);
+    }
+
+    calBuckets.assign(num_buckets, nullptr);
+    for (Event *bin : bins)
+        calLink(bin);
+}
+
+Event *
+EventQueue::calDetach()
+{
+    std::vector<Event *> bins = sortedBins();
+    for (size_t i = 0; i < bins.size(); ++i)
+        bins[i]->nextBin = i + 1 < bins.size() ? bins[i + 1] : nullptr;
+
+    std::fill(calBuckets.begin(), calBuckets.end(), nullptr);
+    calNumBins = 0;
+    head = nullptr;
+    return bins.empty() ? nullptr : bins.front();
+}
+
 void
 dumpMainQueue()
 {
@@ -394,6 +669,15 @@ dumpMainQueue()
     }
 }
 
+void
+setMainEventQueueBackend(EventQueue::Backend backend)
+{
+    mainEventQueueBackend = backend;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        mainEventQueue[i]->setBackend(backend);
+    }
+}
+
 
 const char *
 Event::description() const
@@ -441,31 +725,46 @@ Event::dump() const
     }
 }
 
-EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
-{
-}
-
-void
-EventQueue::asyncInsert(Event *event)
+EventQueue::EventQueue(const std::string &n, Backend backend)
+    : objName(n), head(NULL), _curTick(0), _backend(Backend::List),
+      calWidthShift(calInitWidthShift), calNumBins(0), asyncHead(nullptr),
+      _numRemoteSchedules(0), _numLateInsertions(0)
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    setBackend(backend);
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    Event *events = asyncHead.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack holds the most recent event first, reverse it so that
+    // events are inserted in the order they were posted.
+    Event *pending = nullptr;
+    while (events) {
+        Event *next = events->nextBin;
+        events->nextBin = pending;
+        pending = events;
+        events = next;
     }
 
-    async_queue_mutex.unlock();
+    while (pending) {
+        Event *next = pending->nextBin;
+        if (pending->when() < getCurTick()) {
+            // Only an adaptive quantum lets the queues drift further
+            // apart than the scheduling distance between them.
+            panic_if(simQuantumMax <= simQuantum,
+                     "%s: %s posted for tick %d, but the queue is already "
+                     "at tick %d.\n", name(), pending->description(),
+                     pending->when(), getCurTick());
+            pending->setWhen(getCurTick(), this);
+            _numLateInsertions++;
+        }
+        insert(pending);
+        pending = next;
+    }
 }
 
 } // namespace gem5
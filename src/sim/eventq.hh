@@ -36,6 +36,7 @@
 #define __SIM_EVENTQ_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <functional>
@@ -43,6 +44,8 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -68,6 +71,20 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Upper bound of the quantum when it is adapted to the amount of
+//! communication between the queues, or 0 to always use simQuantum.
+//! The quantum is widened while few events are scheduled across
+//! queues and narrowed back towards simQuantum when their number
+//! grows. A quantum wider than simQuantum trades accuracy for speed:
+//! events that arrive at a queue that has already moved past their
+//! time are serviced at the queue's current tick instead. With a fixed
+//! quantum such a late event is an error.
+extern Tick simQuantumMax;
+
+//! Number of events scheduled across queues in a quantum above which
+//! an adaptive quantum is narrowed.
+extern uint64_t simQuantumThreshold;
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -265,6 +282,10 @@ class Event : public EventBase, public Serializable
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
     // over the current fully linear insertion.
+    //
+    // With the calendar queue backend (see EventQueue::Backend), the
+    // 'nextBin' list is local to a calendar bucket rather than
+    // spanning the whole queue, but the 'in bin' stacks are unchanged.
     Event *nextBin;
     Event *nextInBin;
 
@@ -605,15 +626,34 @@ operator!=(const Event &l, const Event &r)
  * schedule() method with the 'global' parameter set to true. Unlike
  * the previous queue migration strategy, this strategy is fully
  * deterministic. This causes the event to be inserted in a separate
- * queue of asynchronous events (async_queue), which is merged main
- * event queue at the end of each simulation quantum (by calling the
- * handleAsyncInsertions() method). Note that this implies that such
- * events must happen at least one simulation quantum into the future,
- * otherwise they risk being scheduled in the past by
- * handleAsyncInsertions().
+ * stack of asynchronous events (asyncHead), which is merged into the
+ * main event queue at the end of each simulation quantum (by calling
+ * the handleAsyncInsertions() method). Note that this implies that
+ * such events must happen at least one simulation quantum into the
+ * future, otherwise they are late and handleAsyncInsertions()
+ * services them at the current tick of the queue.
  */
 class EventQueue
 {
+  public:
+    /**
+     * Data structure used to keep the bins of the queue (the stacks
+     * of events sharing the same when() and priority()) in order. The
+     * choice of backend does not affect the order in which events are
+     * serviced.
+     *
+     * @ingroup api_eventq
+     */
+    enum class Backend
+    {
+        /** A single sorted list of bins. Insertion is linear in the
+         * number of bins ahead of the new event. */
+        List,
+        /** A calendar queue (R. Brown, CACM 31(10), 1988) of bins,
+         * giving O(1) amortized insertion and removal. */
+        Calendar,
+    };
+
   private:
     friend void curEventQueue(EventQueue *);
 
@@ -621,11 +661,68 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    UncontendedMutex async_queue_mutex;
+    /** Priority of the event being serviced, or of the last one. */
+    Event::Priority _curPriority = Event::Minimum_Pri;
+
+    Backend _backend;
+
+    /**
+     * @{
+     * Calendar queue state, only used by the Calendar backend.
+     *
+     * Bin b lives in bucket (b.when() >> calWidthShift) modulo the
+     * number of buckets. Each bucket is a sorted list of bins chained
+     * through Event::nextBin. The head pointer always refers to the
+     * top of the earliest bin, which is also the first bin of its
+     * bucket. The number of buckets is a power of two and is doubled
+     * or halved as the number of bins grows or shrinks, at which
+     * point the bucket width is re-estimated from the bins at the
+     * front of the queue.
+     */
+    std::vector<Event *> calBuckets;
+    unsigned calWidthShift;
+    size_t calNumBins;
+
+    static const size_t calMinBuckets = 16;
+    static const unsigned calInitWidthShift = 10;
+
+    size_t
+    calBucket(Tick when) const
+    {
+        return (when >> calWidthShift) & (calBuckets.size() - 1);
+    }
+
+    void calInsert(Event *event);
+    void calRemove(Event *event);
+    /** Link the bin whose top is the given event into its bucket. */
+    void calLink(Event *top);
+    /** Find the earliest bin, knowing that no bin is before when. */
+    Event *calFindMin(Tick when) const;
+    void calResize(size_t num_buckets);
+    /** Remove all bins and return them as a sorted list of bins. */
+    Event *calDetach();
+    /** @} */
+
+    //! Return the tops of all bins in the order they will be serviced.
+    std::vector<Event *> sortedBins() const;
+
+    /**
+     * Events added by other threads to this event queue, most recent
+     * first. This is a lock-free (Treiber) stack linked through
+     * Event::nextBin, which is unused until the events are inserted in
+     * the queue proper. Posting an event therefore needs neither a
+     * lock nor an allocation.
+     */
+    std::atomic<Event *> asyncHead;
+
+    //! Number of events scheduled on other queues by this queue's
+    //! thread in parallel mode.
+    uint64_t _numRemoteSchedules;
+    //! Number of asynchronous events that arrived after their time.
+    uint64_t _numLateInsertions;
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    //! Functions called by this queue's thread at global barriers.
+    std::vector<std::function<void()>> barrierCallbacks;
 
     /**
      * Lock protecting event handling.
@@ -657,7 +754,16 @@ class EventQueue
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
-    void asyncInsert(Event *event);
+    void
+    asyncInsert(Event *event)
+    {
+        Event *next = asyncHead.load(std::memory_order_relaxed);
+        do {
+            event->nextBin = next;
+        } while (!asyncHead.compare_exchange_weak(next, event,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+    }
 
     EventQueue(const EventQueue &);
 
@@ -738,7 +844,7 @@ class EventQueue
     /**
      * @ingroup api_eventq
      */
-    EventQueue(const std::string &n);
+    EventQueue(const std::string &n, Backend backend=Backend::List);
 
     /**
      * @ingroup api_eventq
@@ -748,6 +854,17 @@ class EventQueue
     void name(const std::string &st) { objName = st; }
     /** @}*/ //end of api_eventq group
 
+    /**
+     * Switch to a different backend, migrating any scheduled
+     * events. Should only be called when not in parallel mode.
+     *
+     * @ingroup api_eventq
+     * @{
+     */
+    Backend backend() const { return _backend; }
+    void setBackend(Backend backend);
+    /** @}*/ //end of api_eventq group
+
     /**
      * Schedule the given event on this queue. Safe to call from any thread.
      *
@@ -756,7 +873,10 @@ class EventQueue
     void
     schedule(Event *event, Tick when, bool global=false)
     {
-        assert(when >= getCurTick());
+        // Another queue may already be past the time of the event,
+        // handleAsyncInsertions() takes care of that.
+        assert(when >= getCurTick() ||
+               (inParallelMode && this != curEventQueue()));
         assert(!event->scheduled());
         assert(event->initialized());
 
@@ -770,6 +890,8 @@ class EventQueue
         //    a total order amongst the global events. See global_event.{cc,hh}
         //    for more explanation.
         if (inParallelMode && (this != curEventQueue() || global)) {
+            if (!global && curEventQueue())
+                curEventQueue()->_numRemoteSchedules++;
             asyncInsert(event);
         } else {
             insert(event);
@@ -848,6 +970,15 @@ class EventQueue
      * @ingroup api_eventq
      */
     Tick getCurTick() const { return _curTick; }
+
+    /**
+     * Priority of the event that is being serviced, or of the last
+     * event that was serviced if called in between events. Along with
+     * the current tick, this tells if an event with a given priority
+     * would still be serviced in the current tick or has already been.
+     */
+    Event::Priority getCurPriority() const { return _curPriority; }
+
     Event *getHead() const { return head; }
 
     Event *serviceOne();
@@ -905,6 +1036,33 @@ class EventQueue
      */
     void handleAsyncInsertions();
 
+    /** Number of events this queue's thread scheduled on other queues. */
+    uint64_t numRemoteSchedules() const { return _numRemoteSchedules; }
+    /** Number of asynchronous events serviced later than scheduled. */
+    uint64_t numLateInsertions() const { return _numLateInsertions; }
+
+    /**
+     * Register a function for the thread of this queue to call at
+     * every global barrier, while the other queues are stopped. This
+     * lets objects on different queues hand over data
+     * deterministically, e.g., messages posted to this queue's objects
+     * during the last quantum. Callbacks must be registered before the
+     * simulation runs in parallel.
+     */
+    void
+    addBarrierCallback(std::function<void()> callback)
+    {
+        barrierCallbacks.push_back(std::move(callback));
+    }
+
+    /** Call the barrier callbacks in the order they were registered. */
+    void
+    processBarrierCallbacks()
+    {
+        for (auto &callback : barrierCallbacks)
+            callback();
+    }
+
     /**
      *  Function to signal that the event loop should be woken up because
      *  an event has been scheduled by an agent outside the gem5 event
@@ -977,6 +1135,9 @@ curEventQueue(EventQueue *q)
 
 void dumpMainQueue();
 
+//! Select the backend used by all current and future main event queues.
+void setMainEventQueueBackend(EventQueue::Backend backend);
+
 class EventManager
 {
   protected:
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class TestEvent : public Event
+{
+  public:
+    TestEvent(int _id, std::vector<int> &_log, Priority p)
+        : Event(p), id(_id), log(_log)
+    {}
+
+    void process() override { log.push_back(id); }
+
+    const int id;
+
+  private:
+    std::vector<int> &log;
+};
+
+const Event::Priority priorities[] = {
+    Event::Default_Pri, Event::CPU_Tick_Pri, Event::Delayed_Writeback_Pri,
+    Event::Sim_Exit_Pri,
+};
+
+/**
+ * Schedule a set of events at random times, deschedule and reschedule
+ * some of them, and keep scheduling new events while servicing the
+ * queue. Return the order in which the events were processed.
+ */
+std::vector<int>
+randomRun(EventQueue::Backend backend, unsigned seed, int num_events,
+          Tick spread, int switch_after=-1)
+{
+    std::vector<int> log;
+    std::vector<std::unique_ptr<TestEvent>> events;
+    EventQueue eq("test", backend);
+    std::mt19937 rng(seed);
+
+    for (int i = 0; i < num_events; i++) {
+        events.emplace_back(new TestEvent(i, log, priorities[rng() % 4]));
+        eq.schedule(events.back().get(), rng() % spread);
+    }
+    EXPECT_TRUE(eq.debugVerify());
+
+    for (int i = 0; i < num_events / 4; i++) {
+        TestEvent *event = events[rng() % num_events].get();
+        if (event->scheduled() && rng() % 2)
+            eq.deschedule(event);
+        else
+            eq.reschedule(event, rng() % spread, true);
+    }
+    EXPECT_TRUE(eq.debugVerify());
+
+    int serviced = 0;
+    while (!eq.empty()) {
+        eq.serviceOne();
+        if (++serviced == switch_after) {
+            eq.setBackend(backend == EventQueue::Backend::List ?
+                    EventQueue::Backend::Calendar : EventQueue::Backend::List);
+            EXPECT_TRUE(eq.debugVerify());
+        }
+
+        if (serviced < 4 * num_events) {
+            TestEvent *event = events[rng() % num_events].get();
+            if (!event->scheduled())
+                eq.schedule(event, eq.getCurTick() + rng() % spread);
+        }
+    }
+    EXPECT_TRUE(eq.debugVerify());
+
+    return log;
+}
+
+} // anonymous namespace
+
+/** The calendar queue services events in the same order as the list. */
+TEST(EventQueueTest, CalendarMatchesList)
+{
+    for (unsigned seed = 0; seed < 8; seed++) {
+        for (Tick spread : { 10, 1000, 1000000 }) {
+            const auto list = randomRun(EventQueue::Backend::List, seed,
+                                        1000, spread);
+            const auto cal = randomRun(EventQueue::Backend::Calendar, seed,
+                                       1000, spread);
+            ASSERT_EQ(list, cal) << "seed " << seed << " spread " << spread;
+        }
+    }
+}
+
+/** Switching backends with events pending doesn't change their order. */
+TEST(EventQueueTest, SetBackend)
+{
+    const auto list = randomRun(EventQueue::Backend::List, 1, 500, 5000);
+    EXPECT_EQ(list,
+              randomRun(EventQueue::Backend::List, 1, 500, 5000, 100));
+    EXPECT_EQ(list,
+              randomRun(EventQueue::Backend::Calendar, 1, 500, 5000, 100));
+}
+
+/** Events in the same bin are serviced in LIFO order by both backends. */
+TEST(EventQueueTest, SameBinOrder)
+{
+    for (auto backend : { EventQueue::Backend::List,
+                          EventQueue::Backend::Calendar }) {
+        std::vector<int> log;
+        TestEvent a(0, log, Event::Default_Pri);
+        TestEvent b(1, log, Event::Default_Pri);
+        TestEvent c(2, log, Event::CPU_Tick_Pri);
+        TestEvent d(3, log, Event::Default_Pri);
+        EventQueue eq("test", backend);
+
+        eq.schedule(&c, 100);
+        eq.schedule(&a, 100);
+        eq.schedule(&b, 100);
+        eq.schedule(&d, 50);
+        while (!eq.empty())
+            eq.serviceOne();
+
+        EXPECT_EQ(log, std::vector<int>({3, 1, 0, 2}));
+    }
+}
+
+/** Events far apart don't confuse the calendar queue. */
+TEST(EventQueueTest, SparseEvents)
+{
+    std::vector<int> log;
+    TestEvent a(0, log, Event::Default_Pri);
+    TestEvent b(1, log, Event::Default_Pri);
+    TestEvent c(2, log, Event::Sim_Exit_Pri);
+    EventQueue eq("test", EventQueue::Backend::Calendar);
+
+    eq.schedule(&c, MaxTick);
+    eq.schedule(&b, 1000000000000ULL);
+    eq.schedule(&a, 1);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    EXPECT_EQ(log, std::vector<int>({0, 1, 2}));
+    EXPECT_EQ(eq.getCurTick(), MaxTick);
+}
+
+/** Taking the events off the queue and putting them back. */
+TEST(EventQueueTest, ReplaceHead)
+{
+    std::vector<int> log;
+    std::vector<std::unique_ptr<TestEvent>> events;
+    EventQueue eq("test", EventQueue::Backend::Calendar);
+
+    for (int i = 0; i < 100; i++) {
+        events.emplace_back(new TestEvent(i, log, Event::Default_Pri));
+        eq.schedule(events.back().get(), (100 - i) * 1000);
+    }
+
+    Event *saved = eq.replaceHead(nullptr);
+    EXPECT_TRUE(eq.empty());
+    TestEvent other(100, log, Event::Default_Pri);
+    eq.schedule(&other, 0);
+    eq.serviceOne();
+    EXPECT_TRUE(eq.empty());
+
+    eq.replaceHead(saved);
+    EXPECT_TRUE(eq.debugVerify());
+    while (!eq.empty())
+        eq.serviceOne();
+
+    ASSERT_EQ(log.size(), 101);
+    EXPECT_EQ(log.front(), 100);
+    for (int i = 1; i < 101; i++)
+        EXPECT_EQ(log[i], 100 - i);
+}
+
+/** Dumping the queue lists every event, in service order. */
+TEST(EventQueueTest, Dump)
+{
+    for (auto backend : { EventQueue::Backend::List,
+                          EventQueue::Backend::Calendar }) {
+        std::vector<int> log;
+        std::vector<std::unique_ptr<TestEvent>> events;
+        EventQueue eq("test", backend);
+
+        for (int i = 0; i < 100; i++) {
+            events.emplace_back(new TestEvent(i, log, Event::Default_Pri));
+            eq.schedule(events.back().get(), (100 - i) * 1000);
+        }
+
+        curEventQueue(&eq);
+        testing::internal::CaptureStdout();
+        eq.dump();
+        const std::string out = testing::internal::GetCapturedStdout();
+        curEventQueue(nullptr);
+
+        size_t count = 0;
+        Tick last = 0;
+        for (size_t pos = out.find("Scheduled for ");
+             pos != std::string::npos;
+             pos = out.find("Scheduled for ", pos + 1)) {
+            Tick when = std::stoull(out.substr(pos + 14));
+            EXPECT_GT(when, last);
+            last = when;
+            count++;
+        }
+        EXPECT_EQ(count, events.size());
+
+        while (!eq.empty())
+            eq.serviceOne();
+    }
+}
+
+/** Events posted from other threads all make it into the queue. */
+TEST(EventQueueTest, AsyncInsert)
+{
+    const int num_threads = 8;
+    const int num_events = 1000;
+
+    std::vector<int> log;
+    std::vector<std::unique_ptr<TestEvent>> events;
+    for (int i = 0; i < num_threads * num_events; i++)
+        events.emplace_back(new TestEvent(i, log, Event::Default_Pri));
+
+    EventQueue eq("test");
+    inParallelMode = true;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            EventQueue local("local");
+            curEventQueue(&local);
+            for (int i = 0; i < num_events; i++) {
+                const int id = t * num_events + i;
+                eq.schedule(events[id].get(), 1 + i);
+            }
+            curEventQueue(nullptr);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    // Nothing is inserted until the owning thread asks for it
+    EXPECT_TRUE(eq.empty());
+
+    curEventQueue(&eq);
+    eq.handleAsyncInsertions();
+    inParallelMode = false;
+    EXPECT_TRUE(eq.debugVerify());
+
+    while (!eq.empty())
+        eq.serviceOne();
+    curEventQueue(nullptr);
+
+    ASSERT_EQ(log.size(), num_threads * num_events);
+    std::vector<bool> seen(log.size(), false);
+    for (size_t i = 0; i < log.size(); i++) {
+        // Every thread scheduled one event per tick
+        EXPECT_EQ(log[i] % num_events, i / num_threads);
+        EXPECT_FALSE(seen[log[i]]);
+        seen[log[i]] = true;
+    }
+}
+
+/**
+ * With an adaptive quantum, events posted for a time the queue has
+ * already passed are serviced late.
+ */
+TEST(EventQueueTest, LateAsyncInsert)
+{
+    std::vector<int> log;
+    TestEvent early(0, log, Event::Default_Pri);
+    TestEvent late(1, log, Event::Default_Pri);
+    TestEvent now(2, log, Event::Default_Pri);
+
+    EventQueue eq("test");
+    EventQueue other("other");
+    eq.setCurTick(1000);
+    simQuantum = 500;
+    simQuantumMax = 2000;
+    inParallelMode = true;
+
+    curEventQueue(&other);
+    eq.schedule(&late, 500);
+    eq.schedule(&early, 2000);
+    curEventQueue(&eq);
+    eq.schedule(&now, 1000);
+    EXPECT_EQ(other.numRemoteSchedules(), 2);
+    EXPECT_EQ(eq.numRemoteSchedules(), 0);
+
+    eq.handleAsyncInsertions();
+    inParallelMode = false;
+    simQuantum = 0;
+    simQuantumMax = 0;
+    EXPECT_EQ(eq.numLateInsertions(), 1);
+    EXPECT_EQ(late.when(), 1000);
+
+    while (!eq.empty())
+        eq.serviceOne();
+    curEventQueue(nullptr);
+
+    // The late event joins the bin of the current tick last
+    EXPECT_EQ(log, std::vector<int>({1, 2, 0}));
+}
+
+/** With a fixed quantum, a late event is a bug in the simulated system. */
+TEST(EventQueueTest, LateAsyncInsertFixedQuantum)
+{
+    std::vector<int> log;
+    // Never serviced after the panic, so it can't be safely destroyed
+    TestEvent *late = new TestEvent(0, log, Event::Default_Pri);
+
+    EventQueue eq("test");
+    EventQueue other("other");
+    eq.setCurTick(1000);
+    simQuantum = 500;
+    inParallelMode = true;
+
+    curEventQueue(&other);
+    eq.schedule(late, 500);
+    curEventQueue(&eq);
+    EXPECT_ANY_THROW(eq.handleAsyncInsertions());
+
+    inParallelMode = false;
+    simQuantum = 0;
+    curEventQueue(nullptr);
+}
+
+/** Barrier callbacks run in the order they were registered. */
+TEST(EventQueueTest, BarrierCallbacks)
+{
+    std::vector<int> log;
+    EventQueue eq("test");
+
+    eq.processBarrierCallbacks();
+    eq.addBarrierCallback([&]() { log.push_back(0); });
+    eq.addBarrierCallback([&]() { log.push_back(1); });
+    eq.processBarrierCallbacks();
+    eq.processBarrierCallbacks();
+
+    EXPECT_EQ(log, std::vector<int>({0, 1, 0, 1}));
+}
+
+/** The queue tells which priority it is servicing events of. */
+TEST(EventQueueTest, CurPriority)
+{
+    EventQueue eq("test");
+    std::vector<Event::Priority> seen;
+
+    EventFunctionWrapper low([&]() { seen.push_back(eq.getCurPriority()); },
+                             "low", false, Event::Stat_Event_Pri);
+    EventFunctionWrapper high([&]() { seen.push_back(eq.getCurPriority()); },
+                              "high", false, Event::CPU_Tick_Pri);
+    eq.schedule(&low, 10);
+    eq.schedule(&high, 10);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    EXPECT_EQ(seen, std::vector<Event::Priority>(
+                  { Event::CPU_Tick_Pri, Event::Stat_Event_Pri }));
+    EXPECT_EQ(eq.getCurPriority(), Event::Priority(Event::Stat_Event_Pri));
+}
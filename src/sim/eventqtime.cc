@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark comparing the event queue backends.
+ *
+ * The workload mimics a large Ruby system: a number of clocked
+ * objects (controllers, routers, sequencers) tick periodically on a
+ * few clock domains, and each tick sends off a "message" that is
+ * delivered after a random latency, as would a memory response or a
+ * network hop. The number of pending events therefore grows with the
+ * number of objects.
+ */
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+std::mt19937 rng;
+
+class MessageEvent : public Event
+{
+  public:
+    MessageEvent() : Event(Default_Pri, AutoDelete) {}
+    void process() override {}
+};
+
+class TickEvent : public Event
+{
+  private:
+    EventQueue &eq;
+    const Tick period;
+    const unsigned sendProb;
+
+  public:
+    TickEvent(EventQueue &_eq, Tick _period, unsigned send_prob)
+        : Event(CPU_Tick_Pri), eq(_eq), period(_period),
+          sendProb(send_prob)
+    {}
+
+    void
+    process() override
+    {
+        if (rng() % 100 < sendProb) {
+            // Mostly short (cache/network) latencies with a tail of
+            // long (DRAM) ones.
+            Tick latency = rng() % 8 == 0 ?
+                50000 + rng() % 50000 : period * (1 + rng() % 20);
+            eq.schedule(new MessageEvent(), eq.getCurTick() + latency);
+        }
+        eq.schedule(this, eq.getCurTick() + period);
+    }
+};
+
+double
+run(EventQueue::Backend backend, int num_objects, uint64_t num_events)
+{
+    const Tick periods[] = { 250, 333, 500, 1000 };
+
+    rng.seed(num_objects);
+    EventQueue eq("bench", backend);
+    curEventQueue(&eq);
+
+    std::vector<std::unique_ptr<TickEvent>> objects;
+    for (int i = 0; i < num_objects; i++) {
+        objects.emplace_back(new TickEvent(eq, periods[i % 4], 50));
+        eq.schedule(objects.back().get(), periods[i % 4]);
+    }
+
+    // Let the queue reach a steady state before timing it
+    for (uint64_t i = 0; i < num_events / 10; i++)
+        eq.serviceOne();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < num_events; i++)
+        eq.serviceOne();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    while (!eq.empty())
+        eq.deschedule(eq.getHead());
+    curEventQueue(nullptr);
+
+    return num_events / elapsed.count();
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+    const uint64_t num_events = 500000;
+
+    cprintf("%10s %16s %16s %8s\n", "objects", "list (ev/s)",
+            "calendar (ev/s)", "speedup");
+    for (int num_objects : { 16, 64, 256, 1024, 4096 }) {
+        double list = run(EventQueue::Backend::List, num_objects,
+                          num_events);
+        double calendar = run(EventQueue::Backend::Calendar, num_objects,
+                              num_events);
+        cprintf("%10d %16d %16d %8.2f\n", num_objects, (uint64_t)list,
+                (uint64_t)calendar, calendar / list);
+    }
+
+    return 0;
+}
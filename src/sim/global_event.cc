@@ -29,6 +29,8 @@
 
 #include "sim/global_event.hh"
 
+#include <chrono>
+
 #include "sim/cur_tick.hh"
 
 namespace gem5
@@ -130,7 +132,11 @@ void
 GlobalEvent::BarrierEvent::process()
 {
     // wait for all queues to arrive at barrier, then process event
-    if (globalBarrier()) {
+    const bool last = globalBarrier();
+
+    curEventQueue()->processBarrierCallbacks();
+
+    if (last) {
         _globalEvent->process();
     }
 
@@ -143,8 +149,19 @@ GlobalEvent::BarrierEvent::process()
 void
 GlobalSyncEvent::BarrierEvent::process()
 {
+    auto start = std::chrono::steady_clock::now();
+
     // wait for all queues to arrive at barrier, then process event
-    if (globalBarrier()) {
+    const bool last = globalBarrier();
+
+    std::chrono::duration<double> waited =
+        std::chrono::steady_clock::now() - start;
+    static_cast<GlobalSyncEvent *>(_globalEvent)->waited(
+        curEventQueue(), waited.count());
+
+    curEventQueue()->processBarrierCallbacks();
+
+    if (last) {
         _globalEvent->process();
     }
 
@@ -235,6 +235,14 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
 
     void process();
 
+    /**
+     * Called by every thread once all threads have reached the event.
+     *
+     * @param eq Event queue of the calling thread.
+     * @param seconds Host time the thread spent waiting for the others.
+     */
+    virtual void waited(EventQueue *eq, double seconds) {}
+
     const char *description() const;
 
     Tick repeat;
@@ -39,6 +39,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+
 #include "base/hostinfo.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -187,12 +189,88 @@ Root::Root(const RootParams &p, int)
     lastTime.setTimer();
 
     simQuantum = p.sim_quantum;
+    simQuantumMax = p.sim_quantum_max;
+    simQuantumThreshold = p.sim_quantum_threshold;
+
+    switch (p.event_queue_backend) {
+      case EventQueueBackend::List:
+        setMainEventQueueBackend(EventQueue::Backend::List);
+        break;
+      case EventQueueBackend::Calendar:
+        setMainEventQueueBackend(EventQueue::Backend::Calendar);
+        break;
+      default:
+        panic("Invalid event queue backend\n");
+    }
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
     // having a single global stat group for global stats. Merge that
     // group into the root object here.
     mergeStatGroup(&Root::RootStats::instance);
+
+    for (const PoolAllocator *pool : PoolAllocator::pools())
+        poolStats.emplace_back(new PoolStats(this, *pool));
+}
+
+Root::PoolStats::PoolStats(statistics::Group *parent,
+                           const PoolAllocator &_pool)
+    : statistics::Group(parent, (_pool.name() + "Pool").c_str()),
+      pool(_pool),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of allocations served from a free list"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of allocations that went to the system allocator"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of allocations served from a free list",
+               hits / (hits + misses)),
+      hitsAtReset(0), missesAtReset(0)
+{
+    hits.functor([this]() { return pool.hits() - hitsAtReset; });
+    misses.functor([this]() { return pool.misses() - missesAtReset; });
+}
+
+void
+Root::PoolStats::resetStats()
+{
+    statistics::Group::resetStats();
+    hitsAtReset = pool.hits();
+    missesAtReset = pool.misses();
+}
+
+Root::QuantumStats::QuantumStats(statistics::Group *parent,
+                                 uint32_t num_queues)
+    : statistics::Group(parent, "quantum"),
+      ADD_STAT(quanta, statistics::units::Count::get(),
+               "Number of quanta simulated"),
+      ADD_STAT(size, statistics::units::Tick::get(),
+               "Length of the quanta"),
+      ADD_STAT(remoteEvents, statistics::units::Count::get(),
+               "Number of events scheduled on other event queues"),
+      ADD_STAT(lateEvents, statistics::units::Count::get(),
+               "Number of events from other event queues that arrived "
+               "after their time"),
+      ADD_STAT(barrierWait, statistics::units::Second::get(),
+               "Host time spent waiting for the other event queues at "
+               "the end of a quantum"),
+      ADD_STAT(barrierWaitTotal, statistics::units::Second::get(),
+               "Total host time spent waiting for the other event "
+               "queues")
+{
+    const Tick max_size = std::max(simQuantum, simQuantumMax);
+    size.init(simQuantum, max_size, std::max<Tick>(1, max_size / 16));
+    remoteEvents.init(num_queues);
+    lateEvents.init(num_queues);
+    barrierWait.init(num_queues, 0, 0.01, 0.0005);
+    barrierWaitTotal.init(num_queues);
+}
+
+void
+Root::init()
+{
+    // All event queues have been created by now.
+    if (numMainEventQueues > 1)
+        _quantumStats.reset(new QuantumStats(this, numMainEventQueues));
 }
 
 void
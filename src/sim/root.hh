@@ -51,6 +51,10 @@
 #ifndef __SIM_ROOT_HH__
 #define __SIM_ROOT_HH__
 
+#include <memory>
+#include <vector>
+
+#include "base/pool_alloc.hh"
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "base/types.hh"
@@ -122,6 +126,45 @@ class Root : public SimObject
         Tick startTick;
     };
 
+    /** Effectiveness of a recycling allocation pool. */
+    struct PoolStats : public statistics::Group
+    {
+        PoolStats(statistics::Group *parent, const PoolAllocator &pool);
+
+        void resetStats() override;
+
+        const PoolAllocator &pool;
+
+        statistics::Value hits;
+        statistics::Value misses;
+        statistics::Formula hitRate;
+
+      private:
+        uint64_t hitsAtReset;
+        uint64_t missesAtReset;
+    };
+
+    /** Synchronization of the main event queues in parallel mode. */
+    struct QuantumStats : public statistics::Group
+    {
+        QuantumStats(statistics::Group *parent, uint32_t num_queues);
+
+        statistics::Scalar quanta;
+        statistics::Distribution size;
+        statistics::Vector remoteEvents;
+        statistics::Vector lateEvents;
+        statistics::VectorDistribution barrierWait;
+        statistics::Vector barrierWaitTotal;
+    };
+
+  protected:
+    std::vector<std::unique_ptr<PoolStats>> poolStats;
+    std::unique_ptr<QuantumStats> _quantumStats;
+
+  public:
+    /** Quantum stats, or nullptr if there is a single event queue. */
+    QuantumStats *quantumStats() const { return _quantumStats.get(); }
+
   public:
 
     /// Check whether time syncing is enabled.
@@ -144,6 +187,8 @@ class Root : public SimObject
     // create() method.
     Root(const Params &p, int);
 
+    void init() override;
+
     /** Schedule the timesync event at startup().
      */
     void startup() override;
@@ -86,18 +86,20 @@ Serializable::unserializeSection(CheckpointIn &cp, const char *name)
 
 void
 Serializable::generateCheckpointOut(const std::string &cpt_dir,
-        std::ofstream &outstream)
+        std::ofstream &outstream, bool binary)
 {
     std::string dir = CheckpointIn::setDir(cpt_dir);
     if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
             fatal("couldn't mkdir %s\n", dir);
 
     std::string cpt_file = dir + CheckpointIn::baseFilename;
-    outstream = std::ofstream(cpt_file.c_str());
+    outstream = std::ofstream(cpt_file.c_str(),
+        binary ? std::ios::out | std::ios::binary : std::ios::out);
     time_t t = time(NULL);
     if (!outstream)
         fatal("Unable to open file %s for writing\n", cpt_file.c_str());
-    outstream << "## checkpoint generated: " << ctime(&t);
+    if (!binary)
+        outstream << "## checkpoint generated: " << ctime(&t);
 }
 
 Serializable::ScopedCheckpointSection::~ScopedCheckpointSection()
@@ -138,6 +140,8 @@ const char *CheckpointIn::baseFilename = "m5.cpt";
 
 std::string CheckpointIn::currentDirectory;
 
+bool CheckpointIn::binaryFormat = false;
+
 std::string
 CheckpointIn::setDir(const std::string &name)
 {
@@ -104,6 +104,9 @@ class CheckpointIn
     // current directory we're serializing into.
     static std::string currentDirectory;
 
+    // whether the checkpoint being created uses the binary format.
+    static bool binaryFormat;
+
 
   public:
     /**
@@ -128,6 +131,22 @@ class CheckpointIn
      */
     static std::string dir();
 
+    /**
+     * Select the format of the checkpoint being created.
+     *
+     * Binary checkpoints store the object state as an indexed binary
+     * file (@see IniFile::saveBinary()) and let objects write raw
+     * images of large state, such as memory, that can be mapped
+     * directly when restoring. Like dir(), this is only meaningful
+     * while a checkpoint is being created.
+     *
+     * @ingroup api_serialize
+     * @{
+     */
+    static void setBinary(bool binary) { binaryFormat = binary; }
+    static bool binary() { return binaryFormat; }
+    /** @} */
+
     // Filename for base checkpoint file within directory.
     static const char *baseFilename;
 };
@@ -306,10 +325,12 @@ class Serializable
      *
      * @param cpt_dir The dir at which the cpt file will be created.
      * @param outstream The cpt file.
+     * @param binary Open the file for a binary checkpoint, which doesn't
+     * get a text header.
      * @ingroup api_serialize
      */
     static void generateCheckpointOut(const std::string &cpt_dir,
-        std::ofstream &outstream);
+        std::ofstream &outstream, bool binary=false);
 
   private:
     static std::stack<std::string> path;
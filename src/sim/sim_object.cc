@@ -30,6 +30,8 @@
 #include "sim/sim_object.hh"
 
 #include <cassert>
+#include <fstream>
+#include <sstream>
 
 #include "base/logging.hh"
 #include "base/match.hh"
@@ -129,10 +131,17 @@ SimObject::getPort(const std::string &if_name, PortID idx)
 // static function: serialize all SimObjects.
 //
 void
-SimObject::serializeAll(const std::string &cpt_dir)
+SimObject::serializeAll(const std::string &cpt_dir, bool binary)
 {
-    std::ofstream cp;
-    Serializable::generateCheckpointOut(cpt_dir, cp);
+    std::ofstream cpt_file;
+    Serializable::generateCheckpointOut(cpt_dir, cpt_file, binary);
+    CheckpointIn::setBinary(binary);
+
+    // Binary checkpoints are serialized as text first and converted
+    // once all the objects are done.
+    std::stringstream text;
+    CheckpointOut &cp = binary ? static_cast<CheckpointOut &>(text) :
+        cpt_file;
 
     SimObjectList::reverse_iterator ri = simObjectList.rbegin();
     SimObjectList::reverse_iterator rend = simObjectList.rend();
@@ -143,6 +152,15 @@ SimObject::serializeAll(const std::string &cpt_dir)
         // since we are at the top level.
         obj->serializeSection(cp, obj->name());
    }
+
+    if (binary) {
+        IniFile db;
+        db.load(text);
+        db.saveBinary(cpt_file);
+        if (!cpt_file)
+            fatal("Failed to write binary checkpoint to %s\n", cpt_dir);
+    }
+    CheckpointIn::setBinary(false);
 }
 
 SimObject *
@@ -42,6 +42,7 @@
 
 #include "sim/simulate.hh"
 
+#include <algorithm>
 #include <atomic>
 #include <thread>
 
@@ -51,6 +52,7 @@
 #include "sim/async.hh"
 #include "sim/eventq.hh"
 #include "sim/init_signals.hh"
+#include "sim/root.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
 #include "sim/stat_control.hh"
@@ -167,6 +169,87 @@ class SimulatorThreads
 
 static std::unique_ptr<SimulatorThreads> simulatorThreads;
 
+/**
+ * Synchronizes the main event queues at the end of every quantum.
+ *
+ * If simQuantumMax is larger than simQuantum, the length of the next
+ * quantum is adapted to the number of events the queues scheduled on
+ * each other during the quantum that just ended. The quantum is halved
+ * (but not below simQuantum) if that number exceeds
+ * simQuantumThreshold, and doubled (but not above simQuantumMax) if it
+ * is at most half of that. Since wider quanta naturally see more
+ * events, the quantum settles where the threshold is reached.
+ */
+class QuantumEvent : public GlobalSyncEvent
+{
+  private:
+    /** Counters of the queues at the end of the previous quantum. */
+    std::vector<uint64_t> lastRemote;
+    std::vector<uint64_t> lastLate;
+
+    Root::QuantumStats *stats;
+
+  public:
+    QuantumEvent(Tick when, Tick quantum)
+        : GlobalSyncEvent(when, quantum, EventBase::Progress_Event_Pri, 0),
+          lastRemote(numMainEventQueues), lastLate(numMainEventQueues),
+          stats(Root::root()->quantumStats())
+    {
+        for (uint32_t i = 0; i < numMainEventQueues; i++) {
+            lastRemote[i] = mainEventQueue[i]->numRemoteSchedules();
+            lastLate[i] = mainEventQueue[i]->numLateInsertions();
+        }
+    }
+
+    void
+    process() override
+    {
+        // All other threads are waiting on the barrier, so the
+        // counters of their queues can be read safely.
+        uint64_t remote = 0;
+        for (uint32_t i = 0; i < numMainEventQueues; i++) {
+            const EventQueue *eq = mainEventQueue[i];
+            const uint64_t num_remote = eq->numRemoteSchedules();
+            const uint64_t num_late = eq->numLateInsertions();
+            remote += num_remote - lastRemote[i];
+            if (stats) {
+                stats->remoteEvents[i] += num_remote - lastRemote[i];
+                stats->lateEvents[i] += num_late - lastLate[i];
+            }
+            lastRemote[i] = num_remote;
+            lastLate[i] = num_late;
+        }
+
+        if (stats) {
+            stats->quanta++;
+            stats->size.sample(repeat);
+        }
+
+        if (simQuantumMax > simQuantum) {
+            if (remote > simQuantumThreshold)
+                repeat = std::max(repeat / 2, simQuantum);
+            else if (remote * 2 <= simQuantumThreshold)
+                repeat = std::min(repeat * 2, simQuantumMax);
+        }
+
+        GlobalSyncEvent::process();
+    }
+
+    void
+    waited(EventQueue *eq, double seconds) override
+    {
+        if (!stats)
+            return;
+
+        // Every thread only updates the stats of its own queue.
+        auto it = std::find(mainEventQueue.begin(), mainEventQueue.end(), eq);
+        assert(it != mainEventQueue.end());
+        const int i = it - mainEventQueue.begin();
+        stats->barrierWait[i].sample(seconds);
+        stats->barrierWaitTotal[i] += seconds;
+    }
+};
+
 struct DescheduleDeleter
 {
     void operator()(BaseGlobalEvent *event)
@@ -224,8 +307,7 @@ simulate(Tick num_cycles)
                  "Quantum for multi-eventq simulation not specified");
 
         quantum_event.reset(
-            new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
-                                EventBase::Progress_Event_Pri, 0));
+            new QuantumEvent(curTick() + simQuantum, simQuantum));
 
         inParallelMode = true;
     }
@@ -25,10 +25,13 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 import argparse
+import math
 import os
+import re
 
 import m5
 from m5.objects import *
+from m5.stats.gem5stats import get_simstat
 
 
 class L1Cache(Cache):
@@ -116,69 +119,262 @@ parser = argparse.ArgumentParser()
 parser.add_argument("binary", type=str)
 parser.add_argument("--cpu")
 parser.add_argument("--mem", choices=valid_mem.keys(), default="SimpleMemory")
+parser.add_argument(
+    "--compare-skip-stalled-cycles",
+    action="store_true",
+    help="Check that an O3 CPU skipping its stalled cycles produces the "
+    "same timing as one ticking through them",
+)
+parser.add_argument(
+    "--compare-cache-warming",
+    action="store_true",
+    help="Check that warming the caches while a non-caching CPU bypasses "
+    "them raises the hit rate of the CPU switched in after it",
+)
+parser.add_argument(
+    "--cache-basic-blocks",
+    action="store_true",
+    help="Let an atomic CPU execute cached basic blocks",
+)
 
 args = parser.parse_args()
 
-system = System()
 
-system.workload = SEWorkload.init_compatible(args.binary)
-
-system.clk_domain = SrcClockDomain()
-system.clk_domain.clock = "1GHz"
-system.clk_domain.voltage_domain = VoltageDomain()
-
-if args.cpu not in (
-    "X86AtomicSimpleCPU",
-    "ArmAtomicSimpleCPU",
-    "RiscvAtomicSimpleCPU",
-):
-    system.mem_mode = "timing"
-
-system.mem_ranges = [AddrRange("512MB")]
+non_caching_cpu = {
+    "X86": X86NonCachingSimpleCPU,
+    "Arm": ArmNonCachingSimpleCPU,
+    "Riscv": RiscvNonCachingSimpleCPU,
+}
 
-system.cpu = valid_cpu[args.cpu]()
 
-if args.cpu in (
-    "X86AtomicSimpleCPU",
-    "ArmAtomicSimpleCPU",
-    "RiscvAtomicSimpleCPU",
-):
-    system.membus = SystemXBar()
-    system.cpu.icache_port = system.membus.cpu_side_ports
-    system.cpu.dcache_port = system.membus.cpu_side_ports
+def create_system(skip_stalled_cycles=None, warm_caches=None):
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = "1GHz"
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    if args.cpu not in (
+        "X86AtomicSimpleCPU",
+        "ArmAtomicSimpleCPU",
+        "RiscvAtomicSimpleCPU",
+    ):
+        system.mem_mode = "timing"
+
+    system.mem_ranges = [AddrRange("512MB")]
+
+    if warm_caches is not None:
+        # Start out bypassing the caches, and switch to the CPU under test
+        # later on
+        system.mem_mode = "atomic_noncaching"
+        isa = next(isa for isa in non_caching_cpu if args.cpu.startswith(isa))
+        system.cpu = non_caching_cpu[isa]()
+        system.switch_cpu = valid_cpu[args.cpu](switched_out=True)
+    else:
+        system.cpu = valid_cpu[args.cpu]()
+    if skip_stalled_cycles is not None:
+        system.cpu.skipStalledCycles = skip_stalled_cycles
+    if args.cache_basic_blocks:
+        system.cpu.cache_basic_blocks = True
+
+    if args.cpu in (
+        "X86AtomicSimpleCPU",
+        "ArmAtomicSimpleCPU",
+        "RiscvAtomicSimpleCPU",
+    ):
+        system.membus = SystemXBar()
+        system.cpu.icache_port = system.membus.cpu_side_ports
+        system.cpu.dcache_port = system.membus.cpu_side_ports
+    elif warm_caches is not None:
+        # The caches outlive the CPUs, and a monitor between each CPU port
+        # and its L1 feeds the requests of the non-caching CPU to a warmer
+        system.l1d = L1DCache()
+        system.l1i = L1ICache()
+        system.l1_to_l2 = L2XBar()
+        system.l2cache = L2Cache()
+        system.membus = SystemXBar()
+        system.dmonitor = CommMonitor()
+        system.imonitor = CommMonitor()
+        system.cpu.dcache_port = system.dmonitor.cpu_side_port
+        system.cpu.icache_port = system.imonitor.cpu_side_port
+        system.l1d.cpu_side = system.dmonitor.mem_side_port
+        system.l1i.cpu_side = system.imonitor.mem_side_port
+        system.l1d.connectBus(system.l1_to_l2)
+        system.l1i.connectBus(system.l1_to_l2)
+        system.l2cache.connectCPUSideBus(system.l1_to_l2)
+        system.l2cache.connectMemSideBus(system.membus)
+        if warm_caches:
+            system.dmonitor.warmer = CacheWarmer(
+                caches=[system.l1d, system.l2cache]
+            )
+            system.imonitor.warmer = CacheWarmer(
+                caches=[system.l1i, system.l2cache]
+            )
+    else:
+        system.cpu.l1d = L1DCache()
+        system.cpu.l1i = L1ICache()
+        system.l1_to_l2 = L2XBar()
+        system.l2cache = L2Cache()
+        system.membus = SystemXBar()
+        system.cpu.l1d.connectCPU(system.cpu)
+        system.cpu.l1d.connectBus(system.l1_to_l2)
+        system.cpu.l1i.connectCPU(system.cpu)
+        system.cpu.l1i.connectBus(system.l1_to_l2)
+        system.l2cache.connectCPUSideBus(system.l1_to_l2)
+        system.l2cache.connectMemSideBus(system.membus)
+
+    system.cpu.createInterruptController()
+    if args.cpu in (
+        "X86AtomicSimpleCPU",
+        "X86TimingSimpleCPU",
+        "X86DerivO3CPU",
+    ):
+        system.cpu.interrupts[0].pio = system.membus.mem_side_ports
+        system.cpu.interrupts[0].int_master = system.membus.cpu_side_ports
+        system.cpu.interrupts[0].int_slave = system.membus.mem_side_ports
+
+    system.mem_ctrl = valid_mem[args.mem]()
+    system.mem_ctrl.range = system.mem_ranges[0]
+    system.mem_ctrl.port = system.membus.mem_side_ports
+    system.system_port = system.membus.cpu_side_ports
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+    if warm_caches is not None:
+        system.switch_cpu.workload = process
+        system.switch_cpu.createThreads()
+
+    return system
+
+
+if args.compare_skip_stalled_cycles:
+    # Run the workload twice side by side, once ticking through the
+    # stalled cycles and once skipping them. The simulation only exits
+    # once both copies have finished.
+    system = create_system(skip_stalled_cycles=False)
+    skipping_system = create_system(skip_stalled_cycles=True)
+    root = Root(
+        full_system=False, system=system, skipping_system=skipping_system
+    )
+elif args.compare_cache_warming:
+    # Run the workload twice side by side, bypassing the caches at first
+    # in both copies, but only warming them in one
+    system = create_system(warm_caches=False)
+    warmed_system = create_system(warm_caches=True)
+    root = Root(full_system=False, system=system, warmed_system=warmed_system)
 else:
-    system.cpu.l1d = L1DCache()
-    system.cpu.l1i = L1ICache()
-    system.l1_to_l2 = L2XBar()
-    system.l2cache = L2Cache()
-    system.membus = SystemXBar()
-    system.cpu.l1d.connectCPU(system.cpu)
-    system.cpu.l1d.connectBus(system.l1_to_l2)
-    system.cpu.l1i.connectCPU(system.cpu)
-    system.cpu.l1i.connectBus(system.l1_to_l2)
-    system.l2cache.connectCPUSideBus(system.l1_to_l2)
-    system.l2cache.connectMemSideBus(system.membus)
-
-system.cpu.createInterruptController()
-if args.cpu in ("X86AtomicSimpleCPU", "X86TimingSimpleCPU", "X86DerivO3CPU"):
-    system.cpu.interrupts[0].pio = system.membus.mem_side_ports
-    system.cpu.interrupts[0].int_master = system.membus.cpu_side_ports
-    system.cpu.interrupts[0].int_slave = system.membus.mem_side_ports
-
-system.mem_ctrl = valid_mem[args.mem]()
-system.mem_ctrl.range = system.mem_ranges[0]
-system.mem_ctrl.port = system.membus.mem_side_ports
-system.system_port = system.membus.cpu_side_ports
-
-process = Process()
-process.cmd = [args.binary]
-system.cpu.workload = process
-system.cpu.createThreads()
-
-root = Root(full_system=False, system=system)
+    root = Root(full_system=False, system=create_system())
+
 m5.instantiate()
 
+if args.compare_cache_warming:
+    # Both copies execute the same instructions while bypassing the
+    # caches, then switch to the CPU under test. Only the first accesses
+    # after the switch are measured, as the caches of both copies end up
+    # equally warm in the long run.
+    exit_event = m5.simulate(m5.ticks.fromSeconds(0.0002))
+    if exit_event.getCause() != "simulate() limit reached":
+        print("The workload finished before switching CPUs")
+        exit(1)
+    for s in (system, warmed_system):
+        m5.switchCpus(s, [(s.cpu, s.switch_cpu)])
+    m5.stats.reset()
+    exit_event = m5.simulate(m5.ticks.fromSeconds(0.00002))
+    if exit_event.getCause() != "simulate() limit reached":
+        print("The workload finished while measuring the hit rate")
+        exit(1)
+
+    def hit_rate(system):
+        caches = (system.l1d, system.l1i, system.l2cache)
+        hits = sum(c.resolveStat("demandHits").total for c in caches)
+        accesses = sum(c.resolveStat("demandAccesses").total for c in caches)
+        return hits / accesses if accesses else 0
+
+    cold, warm = hit_rate(system), hit_rate(warmed_system)
+    if warm <= cold:
+        print(f"Cache warming didn't raise the hit rate ({cold} vs {warm})")
+        exit(1)
+
+    print(f"Cache warming raised the hit rate from {cold:.3f} to {warm:.3f}")
+    exit(0)
+
 exit_event = m5.simulate()
 
 if exit_event.getCause() != "exiting with last active thread context":
     exit(1)
+
+if args.compare_skip_stalled_cycles:
+    # The stages of the skipping CPU only count the cycles they ticked in,
+    # so each of their per-cycle counters (and distribution buckets) may
+    # fall behind by up to the number of skipped cycles. Every other stat
+    # of the two systems, e.g., of the caches and the memory, has to match
+    # exactly. Host and simulation rate stats belong to the root and
+    # aren't compared.
+    per_cycle_stats = re.compile(
+        r"cpu\.((fetch|decode|rename|iew|commit|fetchStats\d+)\.(\w+\.)*"
+        r"\w*(Cycles|Events|Dist|idleRate)|numIssuedDist|intInstQueueReads)\."
+    )
+    skipping_stats = ("cpu.stalledCycles.", "cpu.timesStalled.")
+
+    def flatten(stats, prefix=""):
+        if isinstance(stats, dict):
+            items = stats.items()
+        elif isinstance(stats, list):
+            items = enumerate(stats)
+        else:
+            return {prefix: stats}
+        flat = {}
+        for key, value in items:
+            flat.update(flatten(value, f"{prefix}{key}."))
+        return flat
+
+    def system_stats(system):
+        stats = get_simstat(system).to_json()
+        for field in (
+            "name",
+            "creation_time",
+            "simulated_begin_time",
+            "simulated_end_time",
+        ):
+            stats.pop(field, None)
+        return flatten(stats)
+
+    ticked = system_stats(system)
+    skipped = system_stats(skipping_system)
+    stalled = skipping_system.cpu.resolveStat("stalledCycles").value
+    cycles = skipping_system.cpu.resolveStat("numCycles").value
+
+    mismatches = []
+    for stat in sorted(ticked.keys() | skipped.keys()):
+        if stat.startswith(skipping_stats):
+            continue
+        if stat not in ticked or stat not in skipped:
+            mismatches.append(f"{stat} only in one system")
+            continue
+        a, b = ticked[stat], skipped[stat]
+        if a == b:
+            continue
+        if isinstance(a, float) and isinstance(b, float):
+            if math.isnan(a) and math.isnan(b):
+                continue
+        numbers = all(isinstance(v, (int, float)) for v in (a, b))
+        if numbers and per_cycle_stats.match(stat):
+            limit = stalled / cycles if "idleRate" in stat else stalled
+            if 0 <= a - b <= limit:
+                continue
+        mismatches.append(f"{stat}: {a} != {b}")
+
+    if mismatches:
+        print("Skipping stalled cycles changed the stats:")
+        for mismatch in mismatches:
+            print(f"  {mismatch}")
+        exit(1)
+
+    print(
+        f"Skipping stalled cycles matches ({int(stalled)} cycles skipped, "
+        f"{len(ticked)} stats compared)"
+    )
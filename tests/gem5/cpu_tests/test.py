@@ -95,3 +95,78 @@ for isa in valid_isas:
                 valid_isas=(constants.all_compiled_tag,),
                 fixtures=[workload_binary],
             )
+
+            # Executing cached basic blocks must not change what the
+            # program does
+            if "Atomic" in cpu:
+                gem5_verify_config(
+                    name=f"cpu_test_{cpu}_{workload}_cache_basic_blocks",
+                    verifiers=verifiers,
+                    config=joinpath(getcwd(), "run.py"),
+                    config_args=[
+                        f"--cpu={cpu}",
+                        "--cache-basic-blocks",
+                        binary,
+                    ],
+                    valid_isas=(constants.all_compiled_tag,),
+                    fixtures=[workload_binary],
+                )
+
+            # Skipping the stalled cycles of the O3 CPU must not change
+            # the simulated timing, or any stats but the stages' counts of
+            # the cycles they ticked in
+            if "O3" in cpu:
+                gem5_verify_config(
+                    name=f"cpu_test_{cpu}_{workload}_skip_stalled_cycles",
+                    verifiers=(
+                        verifier.MatchRegex("Skipping stalled cycles matches"),
+                    ),
+                    config=joinpath(getcwd(), "run.py"),
+                    config_args=[
+                        f"--cpu={cpu}",
+                        "--compare-skip-stalled-cycles",
+                        binary,
+                    ],
+                    valid_isas=(constants.all_compiled_tag,),
+                    fixtures=[workload_binary],
+                )
+
+            # Warming the caches while a non-caching CPU bypasses them
+            # must leave them warmer for the CPU switched in after it
+            if "Timing" in cpu:
+                gem5_verify_config(
+                    name=f"cpu_test_{cpu}_{workload}_cache_warming",
+                    verifiers=(
+                        verifier.MatchRegex(
+                            "Cache warming raised the hit rate"
+                        ),
+                    ),
+                    config=joinpath(getcwd(), "run.py"),
+                    config_args=[
+                        f"--cpu={cpu}",
+                        "--compare-cache-warming",
+                        binary,
+                    ],
+                    valid_isas=(constants.all_compiled_tag,),
+                    fixtures=[workload_binary],
+                )
+
+        # The sampled CPI estimate, checked against a run of the whole
+        # workload on the O3 CPU
+        if isa == constants.vega_x86_tag:
+            gem5_verify_config(
+                name=f"cpu_test_sampling_{workload}",
+                verifiers=(verifier.MatchRegex("Full detailed run: CPI"),),
+                config=joinpath(
+                    config.base_dir, "configs", "example", "sampling.py"
+                ),
+                config_args=[
+                    "--period=20000",
+                    "--warmup=2000",
+                    "--measure=1000",
+                    "--validate",
+                    binary,
+                ],
+                valid_isas=(constants.all_compiled_tag,),
+                fixtures=[workload_binary],
+            )
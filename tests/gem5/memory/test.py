@@ -72,7 +72,51 @@ gem5_verify_config(
 
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
+    # A large mesh at a low injection rate, where most of the input VCs
+    # of the routers are empty
+    (
+        "garnet_synth_traffic-mesh16x16",
+        "garnet_synth_traffic",
+        [
+            "--network=garnet",
+            "--topology=Mesh_XY",
+            "--mesh-rows=16",
+            "--num-cpus=256",
+            "--num-dirs=256",
+            "--sim-cycles",
+            "100000",
+            "--injectionrate",
+            "0.02",
+        ],
+    ),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
+    # Snoop filters small enough to keep evicting, and back-invalidating,
+    # lines held by the caches
+    (
+        "memtest-bounded-snoop-filter",
+        "memtest",
+        [
+            "--maxloads",
+            "100000",
+            "--snoop-filter-assoc",
+            "4",
+            "--snoop-filter-size",
+            "16kB",
+        ],
+    ),
+    (
+        "memtest-bounded-snoop-filter-atomic",
+        "memtest",
+        [
+            "--atomic",
+            "--maxloads",
+            "100000",
+            "--snoop-filter-assoc",
+            "4",
+            "--snoop-filter-size",
+            "16kB",
+        ],
+    ),
     (
         "ruby_mem_test-garnet",
         "ruby_mem_test",
@@ -119,6 +163,19 @@ null_tests = [
         ],
     ),
     ("ruby_random_test", None, ["--maxloads", "5000"]),
+    (
+        "ruby_random_test-fast-mesh",
+        "ruby_random_test",
+        [
+            "--maxloads",
+            "5000",
+            "--network=fast",
+            "--topology=Mesh_XY",
+            "--mesh-rows=2",
+            "--num-cpus=4",
+            "--num-dirs=4",
+        ],
+    ),
     ("ruby_direct_test", None, ["--requests", "50000"]),
 ]
 
@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Convert gem5 checkpoints between the text and the binary format.
+#
+# Text checkpoints store the object state in an INI file (m5.cpt) and
+# memory as gzipped images. Binary checkpoints store the object state
+# in an indexed binary file and memory as raw, sparse images that gem5
+# maps directly into the simulated memory when restoring. The files of
+# a checkpoint are converted in place.
+#
+# The binary m5.cpt starts with an 8 byte magic and the number of
+# sections, followed by an index with the name, offset and size of
+# every section, and the sections themselves. Each section is the
+# number of entries followed by the key and value of every entry. All
+# integers are little endian, and strings are stored as a 32 bit
+# length followed by the characters.
+
+import configparser
+import gzip
+import io
+import os
+import os.path as osp
+import struct
+import sys
+
+MAGIC = b"gem5ini\x01"
+PAGE_SIZE = 4096
+CHUNK_SIZE = 1 << 20
+
+
+def is_binary(path):
+    """Tell if the checkpoint file at path uses the binary format."""
+    with open(path, "rb") as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+
+def _get_string(data, pos):
+    (size,) = struct.unpack_from("<I", data, pos)
+    pos += 4
+    if pos + size > len(data):
+        raise ValueError("truncated string")
+    return data[pos : pos + size].decode(), pos + size
+
+
+def _put_string(f, string):
+    data = string.encode()
+    f.write(struct.pack("<I", len(data)))
+    f.write(data)
+
+
+def read_binary(f):
+    """Read a binary checkpoint file into a ConfigParser."""
+    data = f.read()
+    if data[: len(MAGIC)] != MAGIC:
+        raise ValueError("not a binary checkpoint file")
+
+    cpt = configparser.ConfigParser(interpolation=None)
+    # gem5 is case sensitive with parameters
+    cpt.optionxform = str
+
+    (num_sections,) = struct.unpack_from("<Q", data, len(MAGIC))
+    pos = len(MAGIC) + 8
+    for _ in range(num_sections):
+        name, pos = _get_string(data, pos)
+        offset, size = struct.unpack_from("<QQ", data, pos)
+        pos += 16
+        if offset + size > len(data):
+            raise ValueError(f"section {name} is truncated")
+
+        cpt.add_section(name)
+        (num_entries,) = struct.unpack_from("<I", data, offset)
+        entry = offset + 4
+        for _ in range(num_entries):
+            key, entry = _get_string(data, entry)
+            value, entry = _get_string(data, entry)
+            cpt.set(name, key, value)
+
+    return cpt
+
+
+def write_binary(cpt, f):
+    """Write a ConfigParser to f in the binary checkpoint format."""
+    names = sorted(cpt.sections())
+    sections = []
+    for name in names:
+        data = io.BytesIO()
+        data.write(struct.pack("<I", len(cpt.items(name, raw=True))))
+        for key, value in cpt.items(name, raw=True):
+            _put_string(data, key)
+            _put_string(data, value)
+        sections.append(data.getvalue())
+
+    offset = len(MAGIC) + 8
+    offset += sum(4 + len(name.encode()) + 16 for name in names)
+
+    f.write(MAGIC)
+    f.write(struct.pack("<Q", len(names)))
+    for name, data in zip(names, sections):
+        _put_string(f, name)
+        f.write(struct.pack("<QQ", offset, len(data)))
+        offset += len(data)
+    for data in sections:
+        f.write(data)
+
+
+def read_text(f):
+    """Read a text checkpoint file into a ConfigParser."""
+    cpt = configparser.ConfigParser(interpolation=None)
+    cpt.optionxform = str
+    cpt.read_file(f)
+    return cpt
+
+
+def write_text(cpt, f):
+    """Write a ConfigParser to f in the text checkpoint format."""
+    for name in cpt.sections():
+        f.write(f"\n[{name}]\n")
+        for key, value in cpt.items(name, raw=True):
+            f.write(f"{key}={value}\n")
+
+
+def _copy_chunks(src, dst, size, sparse):
+    remaining = size
+    while remaining:
+        data = src.read(min(CHUNK_SIZE, remaining))
+        if not data:
+            raise ValueError("memory image is truncated")
+        remaining -= len(data)
+        if not sparse:
+            dst.write(data)
+            continue
+        # Leave pages that are all zero as holes in the file
+        for pos in range(0, len(data), PAGE_SIZE):
+            page = data[pos : pos + PAGE_SIZE]
+            if page.count(0) == len(page):
+                dst.seek(len(page), os.SEEK_CUR)
+            else:
+                dst.write(page)
+    if sparse:
+        dst.truncate(size)
+
+
+def _unpack_chunks(src, dst, size, chunk_size, page_size, compressed_sizes):
+    # Every chunk is a gzip member with a bitmap of the pages that are
+    # not all zero followed by those pages. Chunks that are all zero
+    # are left out.
+    for i, compressed_size in enumerate(compressed_sizes):
+        if not compressed_size:
+            continue
+        offset = i * chunk_size
+        num_pages = -(-min(chunk_size, size - offset) // page_size)
+        raw = gzip.decompress(src.read(compressed_size))
+        pos = -(-num_pages // 8)
+        for page in range(num_pages):
+            if not raw[page // 8] & (1 << (page % 8)):
+                continue
+            length = min(page_size, size - offset - page * page_size)
+            dst.seek(offset + page * page_size)
+            dst.write(raw[pos : pos + length])
+            pos += length
+        if pos != len(raw):
+            raise ValueError("memory image is corrupt")
+    dst.truncate(size)
+
+
+def convert_memory(cpt, cpt_dir, binary):
+    """Convert the memory images referenced by cpt to the raw (binary)
+    or the gzipped (text) format, and update their compressed flag.
+    Images in the text format are written as a single gzip stream,
+    which gem5 reads as well as the chunked images it writes itself."""
+    for name in cpt.sections():
+        if not cpt.has_option(name, "filename") or not cpt.has_option(
+            name, "range_size"
+        ):
+            continue
+        compressed = cpt.get(name, "compressed", fallback="true") == "true"
+        if compressed != binary:
+            continue
+
+        path = osp.join(cpt_dir, cpt.get(name, "filename"))
+        size = int(cpt.get(name, "range_size"))
+        tmp_path = path + ".tmp"
+        if binary and cpt.has_option(name, "chunk_size"):
+            chunk_size = int(cpt.get(name, "chunk_size"))
+            page_size = int(cpt.get(name, "page_size"))
+            sizes = [int(s) for s in cpt.get(name, "compressed_sizes").split()]
+            with open(path, "rb") as src, open(tmp_path, "wb") as dst:
+                _unpack_chunks(src, dst, size, chunk_size, page_size, sizes)
+            for option in ("chunk_size", "page_size", "compressed_sizes"):
+                cpt.remove_option(name, option)
+        elif binary:
+            with gzip.open(path, "rb") as src, open(tmp_path, "wb") as dst:
+                _copy_chunks(src, dst, size, True)
+        else:
+            with open(path, "rb") as src, gzip.open(tmp_path, "wb") as dst:
+                _copy_chunks(src, dst, size, False)
+        os.replace(tmp_path, path)
+
+        cpt.set(name, "compressed", "false" if binary else "true")
+
+
+def convert(cpt_dir, binary):
+    """Convert the checkpoint in cpt_dir to the binary format if binary
+    is set, or to the text format otherwise."""
+    path = osp.join(cpt_dir, "m5.cpt")
+    if is_binary(path):
+        with open(path, "rb") as f:
+            cpt = read_binary(f)
+    else:
+        with open(path) as f:
+            cpt = read_text(f)
+
+    convert_memory(cpt, cpt_dir, binary)
+
+    if binary:
+        with open(path, "wb") as f:
+            write_binary(cpt, f)
+    else:
+        with open(path, "w") as f:
+            write_text(cpt, f)
+
+
+if __name__ == "__main__":
+    from argparse import ArgumentParser
+
+    parser = ArgumentParser(usage="%(prog)s [args] <checkpoint directory>")
+    group = parser.add_mutually_exclusive_group(required=True)
+    group.add_argument(
+        "--to-binary",
+        action="store_true",
+        help="Convert the checkpoint to the binary format",
+    )
+    group.add_argument(
+        "--to-text",
+        action="store_true",
+        help="Convert the checkpoint to the text format",
+    )
+    parser.add_argument("checkpoint", help="Checkpoint directory")
+
+    args = parser.parse_args()
+    if not osp.isfile(osp.join(args.checkpoint, "m5.cpt")):
+        print(f"fatal: no checkpoint in {args.checkpoint}")
+        sys.exit(1)
+
+    convert(args.checkpoint, args.to_binary)
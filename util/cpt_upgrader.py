@@ -71,6 +71,7 @@
 
 import configparser
 import glob
+import io
 import os
 import os.path as osp
 import sys
@@ -210,10 +211,26 @@ def process_file(path, **kwargs):
     # gem5 is case sensitive with paramaters
     cpt.optionxform = str
 
+    # Binary checkpoints are upgraded in their text form. The converter
+    # is only imported when needed to keep this script self-contained
+    # when it is used to generate the list of upgraders.
+    binary = False
+    with open(path, "rb") as cpt_file:
+        if cpt_file.read(8) == b"gem5ini\x01":
+            import cpt_convert
+
+            binary = True
+
     # Read the current data
-    cpt_file = open(path)
-    cpt.read_file(cpt_file)
-    cpt_file.close()
+    if binary:
+        text = io.StringIO()
+        with open(path, "rb") as cpt_file:
+            cpt_convert.write_text(cpt_convert.read_binary(cpt_file), text)
+        cpt.read_string(text.getvalue())
+    else:
+        cpt_file = open(path)
+        cpt.read_file(cpt_file)
+        cpt_file.close()
 
     change = False
 
@@ -276,7 +293,11 @@ def process_file(path, **kwargs):
 
     # Write the old data back
     verboseprint("...completed")
-    cpt.write(open(path, "w"))
+    if binary:
+        with open(path, "wb") as cpt_file:
+            cpt_convert.write_binary(cpt, cpt_file)
+    else:
+        cpt.write(open(path, "w"))
 
 
 if __name__ == "__main__":
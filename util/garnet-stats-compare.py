@@ -0,0 +1,128 @@
+#! /usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+# This script checks that a change to the garnet network model keeps
+# the simulated behaviour identical, and reports how much it changes
+# the simulation speed. It runs the garnet_synth_traffic.py example on
+# a mesh with two gem5 binaries, typically built before and after the
+# change, at a range of injection rates. Every network stat, e.g., of
+# the routers, links and flits, has to match exactly between the two
+# runs. It has to be run from the root of the gem5 tree.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-r", "--mesh-rows", type=int, default=16)
+parser.add_argument("-c", "--sim-cycles", type=int, default=100000)
+parser.add_argument(
+    "-i",
+    "--injection-rates",
+    type=str,
+    default="0.01,0.05,0.1,0.2",
+    help="Comma-separated injection rates to run",
+)
+parser.add_argument("--synthetic", type=str, default="uniform_random")
+parser.add_argument("base_binary", help="gem5 binary without the change")
+parser.add_argument("test_binary", help="gem5 binary with the change")
+
+args = parser.parse_args()
+
+
+def run(binary, outdir, rate):
+    nodes = args.mesh_rows * args.mesh_rows
+    start = time.monotonic()
+    status = subprocess.call(
+        [
+            binary,
+            "-d",
+            outdir,
+            "configs/example/garnet_synth_traffic.py",
+            "--network=garnet",
+            "--topology=Mesh_XY",
+            f"--mesh-rows={args.mesh_rows}",
+            f"--num-cpus={nodes}",
+            f"--num-dirs={nodes}",
+            f"--sim-cycles={args.sim_cycles}",
+            f"--synthetic={args.synthetic}",
+            f"--injectionrate={rate}",
+        ],
+        stdout=subprocess.DEVNULL,
+    )
+    if status != 0:
+        print(f"Error: {binary} failed at injection rate {rate}")
+        sys.exit(1)
+    return time.monotonic() - start
+
+
+def network_stats(outdir):
+    stats = {}
+    with open(os.path.join(outdir, "stats.txt")) as f:
+        for line in f:
+            # the values, without the description
+            fields = line.split("#")[0].split()
+            if len(fields) >= 2 and fields[0].startswith(
+                "system.ruby.network."
+            ):
+                stats[fields[0]] = fields[1:]
+    return stats
+
+
+failed = False
+for rate in args.injection_rates.split(","):
+    with tempfile.TemporaryDirectory() as tmpdir:
+        base_dir = os.path.join(tmpdir, "base")
+        test_dir = os.path.join(tmpdir, "test")
+        base_time = run(args.base_binary, base_dir, rate)
+        test_time = run(args.test_binary, test_dir, rate)
+        base_stats = network_stats(base_dir)
+        test_stats = network_stats(test_dir)
+
+    mismatches = [
+        stat
+        for stat in sorted(base_stats.keys() | test_stats.keys())
+        if base_stats.get(stat) != test_stats.get(stat)
+    ]
+    print(
+        f"Injection rate {rate}: {len(base_stats)} stats, "
+        f"{len(mismatches)} mismatches, {base_time:.1f}s -> "
+        f"{test_time:.1f}s ({base_time / test_time:.2f}x)"
+    )
+    for stat in mismatches:
+        print(f"  {stat}: {base_stats.get(stat)} != {test_stats.get(stat)}")
+    failed = failed or bool(mismatches) or not base_stats
+
+if failed:
+    print("Error: the network stats differ")
+    sys.exit(1)
+
+print("The network stats match")
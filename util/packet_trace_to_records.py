@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Convert a protobuf packet trace to an uncompressed trace of fixed
+# size records, which the TraceGen maps directly into memory rather
+# than decoding it message by message.
+#
+# The file starts with a 32 byte header: the magic "gem5prec", the
+# format version and record size as 32-bit integers, and the tick
+# frequency and number of records as 64-bit integers. It is followed by
+# one 48 byte record per packet with the tick, address, packet id and
+# PC as 64-bit integers, the size as a 32-bit integer, the command and
+# a mask of the optional fields that are set as 16-bit integers, and the
+# flags as a 32-bit integer followed by 4 reserved bytes. Everything is
+# stored in little endian. See src/cpu/testers/traffic_gen/packet_records.hh.
+
+import os
+import struct
+import subprocess
+import sys
+
+import protolib
+
+util_dir = os.path.dirname(os.path.realpath(__file__))
+# Make sure the proto definitions are up to date.
+subprocess.check_call(["make", "--quiet", "-C", util_dir, "packet_pb2.py"])
+import packet_pb2
+
+MAGIC = b"gem5prec"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQQ")
+RECORD = struct.Struct("<QQQQIHHII")
+
+HAS_FLAGS = 0x1
+HAS_PKT_ID = 0x2
+HAS_PC = 0x4
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <protobuf input> <record output>")
+        exit(-1)
+
+    proto_in = protolib.openFileRd(sys.argv[1])
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4).decode()
+    if magic_number != "gem5":
+        print("Unrecognized file", sys.argv[1])
+        exit(-1)
+
+    header = packet_pb2.PacketHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    try:
+        out = open(sys.argv[2], "wb")
+    except OSError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    # The number of records is filled in once all packets are written
+    out.write(HEADER.pack(MAGIC, VERSION, RECORD.size, header.tick_freq, 0))
+
+    num_packets = 0
+    packet = packet_pb2.Packet()
+    while protolib.decodeMessage(proto_in, packet):
+        valid = 0
+        if packet.HasField("flags"):
+            valid |= HAS_FLAGS
+        if packet.HasField("pkt_id"):
+            valid |= HAS_PKT_ID
+        if packet.HasField("pc"):
+            valid |= HAS_PC
+        out.write(
+            RECORD.pack(
+                packet.tick,
+                packet.addr,
+                packet.pkt_id,
+                packet.pc,
+                packet.size,
+                packet.cmd,
+                valid,
+                packet.flags,
+                0,
+            )
+        )
+        num_packets += 1
+
+    out.seek(0)
+    out.write(
+        HEADER.pack(
+            MAGIC, VERSION, RECORD.size, header.tick_freq, num_packets
+        )
+    )
+    out.close()
+    proto_in.close()
+
+    print("Converted packets:", num_packets)
+
+
+if __name__ == "__main__":
+    main()